@@ -7,6 +7,25 @@
  */
 #define CONFIG_BAUD_RATE (PIO_CONFIG_BAUD_RATE)
 
+/**
+ * @brief Most verbose log level compiled in (see `log_ring.h`):
+ * 1 errors, 2 warnings, 3 info, 4 debug. Anything above it is
+ * removed from the build, arguments included
+ *
+ */
+#ifndef CONFIG_LOG_LEVEL
+#define CONFIG_LOG_LEVEL (3)
+#endif
+
+/**
+ * @brief Number of log messages which can wait for the serial port.
+ * Messages logged while it is full are counted and dropped
+ * @note Must be a power of two
+ *
+ */
+#define CONFIG_LOG_RING_SLOTS (64)
+#define CONFIG_LOG_LINE_SZ (120)
+
 /**
  * @brief Maximum allowable framerate for saving video
  * to on device SD card
@@ -14,6 +33,39 @@
  */
 #define CONFIG_CAMERA_FRAME_RATE (6)
 
+/**
+ * @brief Sensor frame size and JPEG quality (0-63, lower is better)
+ * used while nothing is happening
+ * @note Requires `esp_camera.h` where expanded
+ *
+ */
+#define CONFIG_CAMERA_IDLE_FRAMESIZE (FRAMESIZE_QVGA)
+#define CONFIG_CAMERA_IDLE_QUALITY (12)
+
+/**
+ * @brief Sensor frame size and JPEG quality used from the moment an
+ * event arrives until its post-event window closes. Frames saved
+ * before the event keep the idle profile
+ * @note Capped to the frame size the camera driver was started with
+ *
+ */
+#define CONFIG_CAMERA_EVENT_FRAMESIZE (FRAMESIZE_SVGA)
+#define CONFIG_CAMERA_EVENT_QUALITY (10)
+
+/**
+ * @brief Region of the frame which is kept, in percent of the frame,
+ * and where it applies (`JPEG_ROI_STREAM`, `JPEG_ROI_SAVE`, 0 for
+ * nowhere)
+ * @note Frames are cut without being re-encoded, so the region is
+ * widened to whole 16 pixel blocks
+ *
+ */
+#define CONFIG_ROI_LEFT (0)
+#define CONFIG_ROI_TOP (0)
+#define CONFIG_ROI_WIDTH (100)
+#define CONFIG_ROI_HEIGHT (100)
+#define CONFIG_ROI_STAGES (0)
+
 /**
  * @brief Scalar value to transmit framebuffers over HTTP
  * Since sending a frame over HTTP is considerably slower
@@ -25,15 +77,258 @@
  */
 #define CONFIG_CAMERA_STREAM_FRAME_DOWNSCALE (2)
 
+/**
+ * @brief Resolution divider for frames sent over the live stream.
+ * Streamed frames are decoded at 1/N scale and re-encoded before
+ * being sent. Frames saved to the SD card are not affected
+ * @note Valid values are 1 (disabled), 2, 4 and 8
+ *
+ */
+#define CONFIG_CAMERA_STREAM_PREVIEW_SCALE (1)
+
+/**
+ * @brief JPEG quality (0-100) used when re-encoding
+ * live stream preview frames
+ *
+ */
+#define CONFIG_CAMERA_STREAM_PREVIEW_QUALITY (60)
+
+/**
+ * @brief Preview sent to the coordinator as soon as an event fires,
+ * before the event itself: a mosaic of up to
+ * `CONFIG_EVENT_PREVIEW_FRAMES` frames spread over the event second
+ * and the `CONFIG_EVENT_PREVIEW_SECONDS` before it. 0 frames
+ * disables it
+ * @note Frames are scaled down by powers of two to fit a tile
+ * `CONFIG_EVENT_PREVIEW_TILE_WIDTH` pixels wide (4:3)
+ *
+ */
+#define CONFIG_EVENT_PREVIEW_FRAMES (4)
+#define CONFIG_EVENT_PREVIEW_SECONDS (2)
+#define CONFIG_EVENT_PREVIEW_TILE_WIDTH (240)
+#define CONFIG_EVENT_PREVIEW_QUALITY (60)
+
+/**
+ * @brief Time given to the frames of the event second to reach the
+ * SD card before the preview is built
+ *
+ */
+#define CONFIG_EVENT_PREVIEW_DELAY_MS (300)
 
 #define CONFIG_HTTP_UPLOAD_TIMEOUT_MS (500)
 
+/**
+ * @brief Transport used for the live stream: 0 sends each frame
+ * as an HTTP request, 1 splits it into UDP datagrams sent to
+ * `CONFIG_STREAM_UDP_PORT` on the coordinator
+ * @note Frames sent over UDP are not acknowledged, so event
+ * uploads always include them
+ *
+ */
+#define CONFIG_STREAM_TRANSPORT (0)
+#define CONFIG_STREAM_UDP_PORT (5005)
+
+/**
+ * @brief Frame bytes carried by each UDP datagram. Kept under the
+ * Wi-Fi MTU so datagrams are never fragmented by IP
+ *
+ */
+#define CONFIG_STREAM_UDP_PAYLOAD (1400)
+
+/**
+ * @brief Copy every captured frame into a PSRAM buffer pool and
+ * give the driver framebuffer back right away, so that slow SD
+ * or network writes never starve the camera of buffers
+ * @note Set to 0 to hold driver framebuffers until all consumers
+ * are done with them
+ *
+ */
+#define CONFIG_CAMERA_FB_COPY_POOL (1)
+
+/**
+ * @brief Maximum amount of PSRAM the frame copy pool may use.
+ * Frames which do not fit keep their driver framebuffer
+ *
+ */
+#define CONFIG_FRAME_POOL_BUDGET_KB (1536)
+
+/**
+ * @brief Store frames on the SD card without their quantization
+ * and Huffman tables, which are the same for every frame at a given
+ * quality. Each table set is stored once per event instead, and
+ * frames are expanded back to the original JPEG when read
+ *
+ */
+#define CONFIG_JPEG_ABBREVIATED (1)
+
+/**
+ * @brief Mean luma difference (0-255) below which a frame is
+ * considered a repeat of the last stored frame. Repeated frames
+ * are recorded without their image data
+ * @note 0 disables the check
+ *
+ */
+#define CONFIG_STATIC_SCENE_THRESHOLD (2)
+
+/**
+ * @brief JPEG size change (in percent) above which a frame is
+ * always stored, without looking at its content
+ *
+ */
+#define CONFIG_STATIC_SCENE_SIZE_PCT (5)
+
+/**
+ * @brief Number of frames which can wait to be saved to the
+ * SD card before new frames are dropped
+ *
+ */
+#define CONFIG_CAMERA_SAVE_QUEUE_DEPTH (CONFIG_CAMERA_FRAME_RATE * 2)
+
+/**
+ * @brief Initial and maximum delay between attempts to bring up
+ * Wi-Fi, the MQTT connection and coordinator registration.
+ * The delay doubles after every failed attempt
+ *
+ */
+#define CONFIG_NET_BACKOFF_MIN_MS (500)
+#define CONFIG_NET_BACKOFF_MAX_MS (30000)
+
+/**
+ * @brief Time to wait for Wi-Fi to associate before
+ * restarting the connection attempt
+ *
+ */
+#define CONFIG_WIFI_CONNECT_TIMEOUT_MS (10000)
+
+/**
+ * @brief Largest config.json which can be read, and largest
+ * performance profile taken over MQTT (`config/<deviceName>`)
+ *
+ */
+#define CONFIG_JSON_MAX_SIZE (1536)
+
+/**
+ * @brief What happens to the live stream while an event is being
+ * uploaded: 0 shares the link, 1 pauses the stream and 2 thins it
+ * down to `CONFIG_LINK_STREAM_MIN_FPS`
+ * @note Event uploads always get the link first when it is saturated.
+ * Only applies while upload requests are sent, not while the upload
+ * waits for the rest of an event being recorded
+ *
+ */
+#define CONFIG_LINK_STREAM_POLICY (2)
+
+/**
+ * @brief Live stream frame rate which is kept up no matter how busy
+ * the link is, unless the stream is paused. 0 disables the guarantee
+ *
+ */
+#define CONFIG_LINK_STREAM_MIN_FPS (1)
+
+/**
+ * @brief Bandwidth shared by the live stream and event uploads
+ * (KB/s). 0 leaves the link unlimited, the policy still applies
+ *
+ */
+#define CONFIG_LINK_BUDGET_KBPS (0)
+
+/**
+ * @brief Upper bound of the random delay before an event upload
+ * starts, so cameras which fired on the same event do not all
+ * reach the coordinator at once
+ *
+ */
+#define CONFIG_UPLOAD_START_JITTER_MS (3000)
+
+/**
+ * @brief Most coordinators which can be listed under "HTTP"
+ *
+ */
+#define CONFIG_COORDINATOR_MAX (4)
+
+/**
+ * @brief Failed requests in a row after which a coordinator is
+ * considered down, and how long it is left alone. The time doubles
+ * every time it goes down again without having answered
+ *
+ */
+#define CONFIG_COORDINATOR_FAIL_LIMIT (3)
+#define CONFIG_COORDINATOR_DOWN_MIN_MS (5000)
+#define CONFIG_COORDINATOR_DOWN_MAX_MS (120000)
+
+/**
+ * @brief How many times slower than the next one in line the home
+ * coordinator has to answer before uploads go to the next one
+ *
+ */
+#define CONFIG_COORDINATOR_LATENCY_RATIO (2)
+
+/**
+ * @brief Age after which the latency of a coordinator no longer
+ * counts. Uploads then go back home, which measures it again
+ *
+ */
+#define CONFIG_COORDINATOR_LATENCY_MAX_AGE_MS (60000)
+
+/**
+ * @brief Port of the server the coordinator pulls stored footage
+ * from (see `footage_server.h`). 0 disables it
+ *
+ */
+#define CONFIG_FOOTAGE_SERVER_PORT (8080)
+
 /**
  * @brief Root of camera frame buffers
  * 
  */
 #define CAMERA_FB_ROOT "/camera"
 
+/**
+ * @brief Root of events waiting to be uploaded to the coordinator
+ * @note Unlike `CAMERA_FB_ROOT`, this survives a reboot
+ *
+ */
+#define CAMERA_OUTBOX_ROOT "/outbox"
+
+/**
+ * @brief Maximum amount of SD card space used by events
+ * waiting to be uploaded. Oldest events are evicted first
+ *
+ */
+#define CONFIG_OUTBOX_QUOTA_MB (512)
+
+/**
+ * @brief Root of footage kept after it leaves the ring buffer
+ *
+ */
+#define CAMERA_ARCHIVE_ROOT "/archive"
+
+/**
+ * @brief How long archived footage is kept (hours), and the most
+ * SD card space it may use. Oldest footage is dropped first.
+ * A retention of 0 disables the archive
+ *
+ */
+#define CONFIG_ARCHIVE_RETENTION_HOURS (24)
+#define CONFIG_ARCHIVE_QUOTA_MB (4096)
+
+/**
+ * @brief Archived footage is kept at the full frame rate for
+ * `CONFIG_ARCHIVE_FULL_SECONDS`, then thinned to a frame per
+ * second until `CONFIG_ARCHIVE_SPARSE_AFTER_SECONDS`, and to a
+ * frame per `CONFIG_ARCHIVE_SPARSE_INTERVAL` seconds after that
+ *
+ */
+#define CONFIG_ARCHIVE_FULL_SECONDS (300)
+#define CONFIG_ARCHIVE_SPARSE_AFTER_SECONDS (3600)
+#define CONFIG_ARCHIVE_SPARSE_INTERVAL (10)
+
+/**
+ * @brief Longest range of archived footage uploaded per request
+ *
+ */
+#define CONFIG_ARCHIVE_MAX_CLIP_SECONDS (3600)
+
 /**
  * @brief Number of seconds to store *prior*
  * to an event happening
@@ -41,4 +336,12 @@
  */
 #define CAMERA_FB_SECOND_RANGE (30)
 
+/**
+ * @brief Number of seconds uploaded before and after the
+ * timestamp of an event
+ *
+ */
+#define CONFIG_EVENT_PRE_SECONDS (CAMERA_FB_SECOND_RANGE)
+#define CONFIG_EVENT_POST_SECONDS (CAMERA_FB_SECOND_RANGE)
+
 #endif  // __APP_CONFIG_H
\ No newline at end of file
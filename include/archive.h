@@ -0,0 +1,50 @@
+#ifndef __ARCHIVE_H
+#define __ARCHIVE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Maximum number of frames returned for a single second
+ *
+ */
+#define ARCHIVE_MAX_FRAMES_PER_SECOND (32)
+
+/**
+ * @brief A frame kept in the archive
+ * @note Frames are stored back to back in one file per segment
+ * (`CAMERA_ARCHIVE_ROOT/<start>.jpg`), always as complete JPEGs
+ *
+ */
+typedef struct {
+  uint32_t epoch;   // Capture second
+  uint16_t ms;      // Capture time within the second
+  bool repeat;      // Same picture as the previous frame
+  uint32_t offset;  // In the segment file
+  uint32_t size;    // Size of the picture, even for repeats
+} archive_frame_t;
+
+/**
+ * @brief Start the task which copies seconds leaving the ring buffer
+ * into the archive and thins out older footage
+ * @note Does nothing if `CONFIG_ARCHIVE_RETENTION_HOURS` is 0
+ */
+void archive_start();
+
+/**
+ * @brief Look up the archived frames captured during `epoch`
+ * @param path Set to the file holding the frames
+ * @return Number of frames found, at most `max`
+ */
+int archive_find(uint32_t epoch, char *path, size_t len, archive_frame_t *out,
+                 int max);
+
+/**
+ * @brief Ask for the archived footage in [from, to) to be uploaded
+ * to the coordinator, as an event whose timestamp is `from`
+ * @note Safe to call from any task, the copy happens in the
+ * background. Ranges are capped to `CONFIG_ARCHIVE_MAX_CLIP_SECONDS`
+ * @return false if too many requests are already waiting
+ */
+bool archive_request_upload(uint32_t from, uint32_t to);
+
+#endif  // __ARCHIVE_H
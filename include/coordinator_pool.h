@@ -0,0 +1,51 @@
+#ifndef __COORDINATOR_POOL_H
+#define __COORDINATOR_POOL_H
+
+#include <Arduino.h>
+
+/**
+ * Coordinators which can take event uploads, from the "HTTP" list
+ * of the device config.
+ *
+ * Each camera has a home coordinator, chosen by rendezvous hashing
+ * of the device name, so cameras spread over the list and only the
+ * cameras of a removed entry move elsewhere. Coordinators which stop
+ * answering are taken out of the ranking for a while, and the next
+ * one is used when the home coordinator answers much slower. Its
+ * latency expires after `CONFIG_COORDINATOR_LATENCY_MAX_AGE_MS`, then
+ * uploads go back home.
+ */
+
+/**
+ * @brief Add a coordinator to the pool
+ * @return false if the pool is full
+ */
+bool coordinator_pool_add(const IPAddress &ip, uint16_t port);
+
+int coordinator_pool_size();
+
+/**
+ * @brief Coordinator to send the events of `key` to
+ * @param exclude Never picked, -1 for none
+ * @return Index of the coordinator, -1 if there is none up besides
+ * `exclude`. Without `exclude` a coordinator is always returned
+ * when the pool is not empty, the one which comes back first if all
+ * of them are down
+ */
+int coordinator_pick(const String &key, int exclude = -1);
+
+/**
+ * @brief Account for a request made to coordinator `idx`
+ * @param ok false if the coordinator could not be reached or failed
+ * @note Enough failures in a row take it down, for longer each time
+ */
+void coordinator_report(int idx, bool ok, uint32_t elapsed_ms);
+
+bool coordinator_up(int idx);
+
+/**
+ * @brief Write `http://<ip>:<port><path>` of coordinator `idx`
+ */
+void coordinator_url(int idx, const char *path, char *buf, size_t len);
+
+#endif  // __COORDINATOR_POOL_H
@@ -0,0 +1,73 @@
+#ifndef __EVENT_OUTBOX_H
+#define __EVENT_OUTBOX_H
+
+#include <Arduino.h>
+
+#include "frame_index.h"
+
+/**
+ * @brief Start the task which uploads stored events in the
+ * background whenever the coordinator is reachable
+ * @note Events left over from before a reboot are picked up again
+ *
+ */
+void event_outbox_start();
+
+/**
+ * @brief Start storing an event whose seconds are still being
+ * recorded. Its upload starts right away
+ * @param timestamp Timestamp of the event sent by the sensor
+ * @note Only one event can be open at a time. It goes out before
+ * older stored events
+ */
+bool event_outbox_open(uint32_t timestamp);
+
+/**
+ * @brief Move one more second of the open event out of the ring
+ * buffer, and hand it to the upload
+ * @note Must be called from the task which writes to the ring
+ * buffer, once the slot is complete. The directory is renamed, no
+ * frame data is copied. The frame index of the slot is saved
+ * alongside the frames
+ */
+bool event_outbox_append(int slot);
+
+/**
+ * @brief Capture time of the newest second handed to the outbox by
+ * `event_outbox_append`, 0 if none was
+ */
+uint32_t event_outbox_handed_until();
+
+/**
+ * @brief No more seconds will be added to the open event. Its
+ * upload completes once the seconds already added are sent
+ */
+void event_outbox_seal();
+
+/**
+ * @brief Look up the frames of a stored event captured during `epoch`
+ * @param dir Set to the directory holding the frames of that second
+ * @param event_dir Set to the directory of the event, which holds
+ * its JPEG table sets
+ * @note Capture times within a second are not kept for stored
+ * events, `ms` is always 0. Can be called from any task, lookups
+ * from several tasks take turns
+ * @return false if no stored event covers `epoch`
+ */
+bool event_outbox_find(uint32_t epoch, char *dir, char *event_dir, size_t len,
+                       frame_index_slot_t *out);
+
+/**
+ * @brief Store footage which is no longer in the ring buffer (e.g.
+ * from the archive) as an event, one second at a time
+ * @note Only one clip can be built at a time. Frames are copied
+ * from `data`, a NULL `data` repeats the previous frame.
+ * `event_outbox_clip_end` hands the clip to the upload task, or
+ * throws it away if `keep` is false
+ */
+bool event_outbox_clip_begin(uint32_t timestamp);
+bool event_outbox_clip_second(uint32_t epoch);
+bool event_outbox_clip_frame(Stream *data, size_t size);
+bool event_outbox_clip_end(bool keep);
+
+#endif  // __EVENT_OUTBOX_H
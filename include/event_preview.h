@@ -0,0 +1,21 @@
+#ifndef __EVENT_PREVIEW_H
+#define __EVENT_PREVIEW_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Start the task which sends a preview of each event to the
+ * coordinator (`/api/device/preview`) as soon as it fires
+ * @note Does nothing if `CONFIG_EVENT_PREVIEW_FRAMES` is 0
+ *
+ */
+void event_preview_start();
+
+/**
+ * @brief Send a preview of the event at `timestamp`
+ * @note Returns right away. A newer event replaces one whose
+ * preview has not been started yet
+ */
+void event_preview_notify(uint32_t timestamp);
+
+#endif  // __EVENT_PREVIEW_H
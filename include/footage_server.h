@@ -0,0 +1,32 @@
+#ifndef __FOOTAGE_SERVER_H
+#define __FOOTAGE_SERVER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Start the HTTP server which lets the coordinator pull
+ * stored footage at its own pace, on `CONFIG_FOOTAGE_SERVER_PORT`
+ * @note Frames are looked up in the ring buffer first, then in the
+ * events waiting in the outbox, then in the archive. Times are epoch seconds and ranges
+ * are half open:
+ *
+ * `GET /footage/list?from=<t>&to=<t>` lists the frames of a range,
+ * one per line as `<epoch> <frame> <ms> <bytes> <offset>`. A frame
+ * of 0 bytes repeats the previous one. `offset` is where the frame
+ * starts in the matching `/footage/window` response
+ *
+ * `GET /footage/window?from=<t>&to=<t>` returns the frames of a
+ * range back to back
+ *
+ * `GET /footage/frame?t=<t>&n=<frame>` returns a single frame
+ *
+ * Both support single `Range: bytes=` requests, so interrupted
+ * transfers can be resumed. Offsets change as footage moves from the
+ * ring buffer to the outbox and the archive, resumes should send the
+ * `ETag` of the first response (or of the list) as `If-Range`. The
+ * whole response is sent if it no longer matches. A transfer is cut
+ * short if a frame is overwritten while it is being sent
+ */
+void footage_server_start();
+
+#endif  // __FOOTAGE_SERVER_H
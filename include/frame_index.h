@@ -0,0 +1,99 @@
+#ifndef __FRAME_INDEX_H
+#define __FRAME_INDEX_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Maximum number of frames tracked per second
+ * @note Frames beyond this are still saved, but are not
+ * indexed and therefore never uploaded
+ *
+ */
+#define FRAME_INDEX_MAX_FRAMES (32)
+
+/**
+ * @brief A single frame stored on the SD card
+ * (`CAMERA_FB_ROOT/<slot>/<frame>.jpg`)
+ *
+ */
+typedef struct {
+  uint32_t size;  // Bytes on the card
+  uint16_t ms;    // Capture time within the second
+  bool valid;     // Frame was completely written
+  bool repeat;    // Same as the previous frame, nothing on the card
+  bool streamed;  // Coordinator already received it over the live stream
+  uint8_t tables; // JPEG table set stripped from it, 0 if stored in full
+} frame_index_entry_t;
+
+/**
+ * @brief Frames stored in one ring buffer slot (one second)
+ *
+ */
+typedef struct {
+  uint32_t epoch;  // Capture second, 0 when the slot is empty
+  uint32_t bytes;  // Total size of the valid frames
+  uint16_t count;  // Number of entries used in `frames`
+  frame_index_entry_t frames[FRAME_INDEX_MAX_FRAMES];
+} frame_index_slot_t;
+
+/**
+ * @brief Allocate the index for up to `max_slots` ring buffer slots
+ * @note Kept in PSRAM when available
+ */
+bool frame_index_init(int max_slots);
+
+/**
+ * @brief Forget the previous content of `slot` and start
+ * recording frames captured during `epoch` into it
+ * @note Only the task saving frames should modify the index
+ */
+void frame_index_begin_slot(int slot, uint32_t epoch);
+
+/**
+ * @brief Record a frame written to the card
+ * @note Repeated frames are recorded with a size of 0
+ * @param tables Table set stripped from the frame (see `jpeg_tables.h`)
+ */
+void frame_index_add(int slot, int frame_index, uint32_t size, uint16_t ms,
+                     bool valid, bool repeat, uint8_t tables);
+
+/**
+ * @brief Record that the coordinator accepted a frame over the
+ * live stream, so event uploads can refer to it instead of
+ * sending it again
+ * @note Ignored if `slot` no longer holds `epoch`
+ */
+void frame_index_mark_streamed(int slot, uint32_t epoch, int frame_index);
+
+/**
+ * @brief Mark `slot` as empty
+ */
+void frame_index_clear_slot(int slot);
+
+/**
+ * @brief Capture second held by `slot`, 0 if empty
+ */
+uint32_t frame_index_epoch(int slot);
+
+/**
+ * @brief Copy out the index of `slot`
+ * @return false if the slot is empty
+ */
+bool frame_index_get(int slot, frame_index_slot_t *out);
+
+/**
+ * @brief JPEG table sets referred to by the frames in the index, bit
+ * `n` being set `n` (see `jpeg_tables.h`)
+ */
+uint32_t frame_index_tables_used();
+
+/**
+ * @brief Look up the frames captured during `epoch`
+ * @param ring_size Number of slots currently in the ring buffer
+ * @param slot Set to the slot holding the frames (may be NULL)
+ * @return false if that second is not stored
+ */
+bool frame_index_find(uint32_t epoch, int ring_size, frame_index_slot_t *out,
+                      int *slot);
+
+#endif  // __FRAME_INDEX_H
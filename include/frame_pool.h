@@ -0,0 +1,21 @@
+#ifndef __FRAME_POOL_H
+#define __FRAME_POOL_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Copy a frame into a reusable PSRAM buffer
+ * @note Buffers come in power of two size classes and are kept
+ * around once allocated, up to `CONFIG_FRAME_POOL_BUDGET_KB`.
+ * The cost of the copy is accounted for in the pool statistics
+ * @return NULL if no buffer is available
+ */
+uint8_t *frame_pool_copy(const uint8_t *src, size_t len);
+
+/**
+ * @brief Give a buffer from `frame_pool_copy` back to the pool
+ * @note Safe to call from any task
+ */
+void frame_pool_free(uint8_t *buf);
+
+#endif  // __FRAME_POOL_H
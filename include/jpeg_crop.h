@@ -0,0 +1,67 @@
+#ifndef __JPEG_CROP_H
+#define __JPEG_CROP_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Values of the "RoiStages" setting, which can be combined
+ *
+ */
+#define JPEG_ROI_STREAM (1)  // Crop live stream frames
+#define JPEG_ROI_SAVE (2)    // Crop frames stored to the SD card
+
+/**
+ * @brief Frames between two prints of the cost of cropping
+ *
+ */
+#define JPEG_CROP_STATS_INTERVAL (300)
+
+/**
+ * @brief Region of interest, in percent of the frame
+ *
+ */
+typedef struct {
+  uint8_t left;
+  uint8_t top;
+  uint8_t width;
+  uint8_t height;
+} jpeg_roi_t;
+
+/**
+ * @brief A cropped frame, owned by the `jpeg_crop_t` it came from
+ * and valid until its next crop
+ *
+ */
+typedef struct {
+  const uint8_t *buf;
+  size_t len;
+  uint16_t width;
+  uint16_t height;
+} jpeg_crop_out_t;
+
+/**
+ * @brief Huffman tables and output buffer of a crop, one per task
+ *
+ */
+typedef struct jpeg_crop jpeg_crop_t;
+
+jpeg_crop_t *jpeg_crop_new();
+void jpeg_crop_free(jpeg_crop_t *c);
+
+/**
+ * @brief Whether `roi` leaves out any part of the frame
+ */
+bool jpeg_roi_crops(const jpeg_roi_t &roi);
+
+/**
+ * @brief Cut a baseline JPEG down to the MCUs covering `roi`
+ * @note Lossless, the blocks which are kept are not decoded. Only
+ * their entropy coding is walked, to re-code the DC differences
+ * which change at the edges of the region. The region is widened to
+ * whole MCUs (8 or 16 pixels), and restart markers are dropped
+ * @return false if the frame cannot be cropped (e.g. progressive)
+ */
+bool jpeg_crop(jpeg_crop_t *c, const uint8_t *buf, size_t len,
+               const jpeg_roi_t &roi, jpeg_crop_out_t *out);
+
+#endif  // __JPEG_CROP_H
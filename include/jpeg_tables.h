@@ -0,0 +1,159 @@
+#ifndef __JPEG_TABLES_H
+#define __JPEG_TABLES_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+/**
+ * @brief Maximum number of distinct table sets kept at once.
+ * Once they are all taken, a set no frame in the ring buffer refers
+ * to is replaced. Frames whose tables do not fit are stored in full
+ *
+ */
+#define JPEG_TABLES_MAX_SETS (4)
+
+// Limits of a single table set
+#define JPEG_TABLES_MAX_RUNS (4)
+#define JPEG_TABLES_MAX_BYTES (1024)
+
+/**
+ * @brief Quantization (DQT) and Huffman (DHT) segments removed
+ * from a frame, along with where they go back
+ * @note Each run is a group of adjacent table segments. `at` is
+ * the offset in the abbreviated frame the run is inserted at,
+ * which makes re-expansion byte exact
+ *
+ */
+typedef struct {
+  uint8_t run_count;
+  struct {
+    uint32_t at;
+    uint16_t len;
+  } runs[JPEG_TABLES_MAX_RUNS];
+  uint16_t len;  // Total bytes in `data`
+  uint8_t data[JPEG_TABLES_MAX_BYTES];
+} jpeg_tables_t;
+
+/**
+ * @brief Parts of a frame which make up its abbreviated form
+ *
+ */
+typedef struct {
+  uint8_t tables;  // Table set, 0 if the frame is kept in full
+  uint8_t run_count;
+  struct {
+    uint32_t offset;  // In the full frame
+    uint16_t len;
+  } runs[JPEG_TABLES_MAX_RUNS];
+  uint32_t len;  // Size of the abbreviated frame
+} jpeg_strip_t;
+
+/**
+ * @brief Find the table segments of a frame and the table set they
+ * match, registering a new set if needed
+ * @note Only the task saving frames should call this
+ * @return false if the frame has to be stored in full
+ */
+bool jpeg_tables_strip(const uint8_t *buf, size_t len, jpeg_strip_t *strip);
+
+/**
+ * @brief Find the table segments of a frame, without matching or
+ * registering a set
+ * @note Safe from any task. `strip->tables` is left at 0, `tables`
+ * holds what was removed
+ * @return false if the frame has no tables which can be removed
+ */
+bool jpeg_tables_split(const uint8_t *buf, size_t len, jpeg_strip_t *strip,
+                       jpeg_tables_t *tables);
+
+/**
+ * @brief Write the abbreviated form of a frame to `file`
+ * @return Number of bytes written
+ */
+size_t jpeg_tables_write(fs::File &file, const uint8_t *buf,
+                         const jpeg_strip_t *strip);
+
+/**
+ * @brief Table set registered under `id` by `jpeg_tables_strip`
+ * @note Only valid for frames still in the ring buffer, the set may
+ * be replaced after that. Stored events keep their own copy
+ * @return NULL if there is no such set
+ */
+const jpeg_tables_t *jpeg_tables_get(uint8_t id);
+
+/**
+ * @brief Save and load a table set, so that abbreviated frames
+ * can be expanded after the set is gone from memory (e.g. reboot)
+ */
+bool jpeg_tables_save(const jpeg_tables_t *tables, const char *path);
+bool jpeg_tables_load(jpeg_tables_t *tables, const char *path);
+
+/**
+ * @brief Describe where the runs of a set go back, as
+ * `<at>:<len>,...` (the `Table-Runs` header sent to coordinators)
+ * @return Length of the text
+ */
+size_t jpeg_tables_format_runs(const jpeg_tables_t *tables, char *buf,
+                               size_t len);
+
+/**
+ * @brief Reads an abbreviated frame back as the original JPEG
+ * @note Only keeps a few offsets, the frame is never held in memory
+ *
+ */
+class JpegExpandStream : public Stream {
+ public:
+  JpegExpandStream(Stream &src, const jpeg_tables_t &tables);
+
+  /**
+   * @brief Size of the expanded frame
+   */
+  static size_t expanded_len(size_t len, const jpeg_tables_t &tables);
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char *buf, size_t len) override;
+  size_t readBytes(uint8_t *buf, size_t len) override {
+    return readBytes((char *)buf, len);
+  }
+  size_t write(uint8_t) override { return 0; }
+
+ private:
+  Stream &src;
+  const jpeg_tables_t &tables;
+  uint32_t src_pos;   // Bytes consumed from `src`
+  uint8_t run;        // Next run to insert
+  uint16_t run_pos;   // Bytes of `run` already returned
+  uint16_t data_pos;  // Offset of `run` in `tables.data`
+};
+
+/**
+ * @brief Reads a frame held in memory in its abbreviated form
+ * @note The frame is not copied, `buf` and `strip` must outlive it
+ *
+ */
+class JpegStripStream : public Stream {
+ public:
+  JpegStripStream(const uint8_t *buf, const jpeg_strip_t &strip);
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t readBytes(char *buf, size_t len) override;
+  size_t readBytes(uint8_t *buf, size_t len) override {
+    return readBytes((char *)buf, len);
+  }
+  size_t write(uint8_t) override { return 0; }
+
+ private:
+  void skip_runs();
+
+  const uint8_t *buf;
+  const jpeg_strip_t &strip;
+  uint32_t pos;   // In the full frame
+  uint32_t left;  // Bytes of the abbreviated frame still to read
+  uint8_t run;    // Next run to leave out
+};
+
+#endif  // __JPEG_TABLES_H
@@ -0,0 +1,53 @@
+#ifndef __LINK_ARBITER_H
+#define __LINK_ARBITER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Values of the "StreamPolicy" setting
+ *
+ */
+#define LINK_POLICY_SHARE (0)  // Stream and upload share the link
+#define LINK_POLICY_PAUSE (1)  // No live stream while uploading
+#define LINK_POLICY_THIN (2)   // Stream at the minimum rate while uploading
+
+/**
+ * @brief Kinds of traffic going over the Wi-Fi link
+ *
+ */
+enum class LINK_CLASS {
+  STREAM,  // Live stream frames, may be skipped
+  UPLOAD,  // Stored event frames, never skipped
+};
+
+/**
+ * @brief Ask for permission to send `bytes` over the link
+ * @note Uploads block until the token bucket allows them and always
+ * return true. Stream frames never block, they are refused instead
+ * @return false if the frame should not be sent
+ */
+bool link_acquire(LINK_CLASS cls, size_t bytes);
+
+/**
+ * @brief Account for a finished transfer, used to measure the
+ * throughput achieved by each class
+ */
+void link_report(LINK_CLASS cls, size_t bytes, uint32_t elapsed_ms);
+
+/**
+ * @brief Limit uploads to `kbps` KB/s on top of the shared budget,
+ * as asked for by the coordinator. 0 removes the limit
+ * @note Holds for the rest of the event upload it was given in
+ */
+void link_set_upload_rate(uint32_t kbps);
+
+/**
+ * @brief Mark the start and end of a request of an event upload,
+ * which is when the stream policy applies
+ * @note Not while the upload waits, for more seconds of an event
+ * being recorded or for a busy coordinator
+ */
+void link_upload_begin();
+void link_upload_end();
+
+#endif  // __LINK_ARBITER_H
@@ -0,0 +1,46 @@
+#ifndef __LOG_RING_H
+#define __LOG_RING_H
+
+#include <Arduino.h>
+
+#include "app_config.h"
+
+#define LOG_LEVEL_ERROR (1)
+#define LOG_LEVEL_WARN (2)
+#define LOG_LEVEL_INFO (3)
+#define LOG_LEVEL_DEBUG (4)
+
+/**
+ * @brief Log a line without waiting on the serial port
+ * @note The message is formatted into a ring buffer and printed
+ * later by a low priority task, so a slow UART never stalls the
+ * caller. Levels above `CONFIG_LOG_LEVEL` compile to nothing.
+ * Lines should not end with a newline
+ *
+ */
+#define LOG_E(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_W(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_I(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_D(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+#define LOG_AT(level, ...)                                \
+  do {                                                    \
+    if ((level) <= CONFIG_LOG_LEVEL) {                    \
+      log_ring_printf((level), __VA_ARGS__);              \
+    }                                                     \
+  } while (0)
+
+/**
+ * @brief Start the task which prints queued messages
+ * @note Messages logged before this are kept until it starts
+ */
+void log_ring_start();
+
+/**
+ * @brief Queue a message, use the `LOG_*` macros instead
+ * @note Never blocks, safe to call from any task
+ */
+void log_ring_printf(int level, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+#endif  // __LOG_RING_H
@@ -47,7 +47,8 @@ extern IPAddress brokerIP;
 extern uint16_t brokerPort;
 
 /**
- * @brief IP address of the coordinator HTTP endpoint
+ * @brief IP address of the coordinator HTTP endpoint, the first one
+ * when several are listed (see `coordinator_pool.h` for uploads)
  * @note This is typically the same as `brokerIP`
  */
 extern IPAddress coordinatorIP;
@@ -74,6 +75,15 @@ extern PubSubClient mqttClient;
 extern NTPClient timeClient;
 extern HTTPClient http;
 
+/**
+ * @brief Set once Wi-Fi is up and the device has registered
+ * with the coordinator, cleared when Wi-Fi is lost
+ * @note Capture runs regardless. Tasks which talk to the
+ * coordinator should check this first
+ *
+ */
+extern volatile bool networkOnline;
+
 /**
  * @brief Task handle used to notify the camera to begin recording
  * 
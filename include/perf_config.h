@@ -0,0 +1,85 @@
+#ifndef __PERF_CONFIG_H
+#define __PERF_CONFIG_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+#include "app_config.h"
+
+/**
+ * @brief Upper bound for the "PreEventSeconds" and
+ * "PostEventSeconds" settings
+ *
+ */
+#define PERF_MAX_WINDOW_SECONDS (300)
+
+/**
+ * @brief Performance parameters which can be tuned at runtime
+ * @note Defaults come from `app_config.h`. They can be overriden by
+ * the `Performance` section of config.json at boot, and by the
+ * `config/<deviceName>` MQTT topic while running
+ *
+ */
+typedef struct {
+  int frame_rate;            // "FrameRate"
+  int stream_downscale;      // "StreamDownscale"
+  int stream_preview_scale;  // "StreamPreviewScale"
+  int upload_timeout_ms;     // "UploadTimeoutMs"
+  int pre_event_seconds;     // "PreEventSeconds"
+  int post_event_seconds;    // "PostEventSeconds"
+  int save_queue_depth;      // "SaveQueueDepth"
+  int static_threshold;      // "StaticSceneThreshold"
+  int stream_policy;         // "StreamPolicy"
+  int stream_min_fps;        // "StreamMinFps"
+  int link_budget_kbps;      // "LinkBudgetKBps"
+  int stream_transport;      // "StreamTransport"
+  int idle_framesize;        // "IdleFrameSize"
+  int idle_quality;          // "IdleQuality"
+  int event_framesize;       // "EventFrameSize"
+  int event_quality;         // "EventQuality"
+  int roi_left;              // "RoiLeft"
+  int roi_top;               // "RoiTop"
+  int roi_width;             // "RoiWidth"
+  int roi_height;            // "RoiHeight"
+  int roi_stages;            // "RoiStages"
+} perf_config_t;
+
+/**
+ * @brief Currently active performance profile
+ * @note Only the camera service writes to this. Other modules
+ * should request changes through `camera_svc_apply_perf_config()`
+ *
+ */
+extern perf_config_t perfConfig;
+
+/**
+ * @brief Overlay the keys present in `json` on top of `cfg`
+ * @return false if any key is malformed or out of range, in
+ * which case `cfg` is left untouched
+ */
+bool perf_config_from_json(ArduinoJson::JsonVariantConst json,
+                           perf_config_t &cfg);
+
+/**
+ * @brief Request a new performance profile to be applied
+ * @note The profile is applied by the camera tasks at the next
+ * safe point (never in the middle of recording or uploading)
+ */
+void camera_svc_apply_perf_config(const perf_config_t &cfg);
+
+/**
+ * @brief Overlay the keys present in `json` on the profile waiting
+ * to be applied (the active one if none is), and request it
+ * @note Partial updates made before the camera tasks apply the
+ * profile all take effect
+ * @return false if any key is malformed or out of range
+ */
+bool camera_svc_merge_perf_config(ArduinoJson::JsonVariantConst json);
+
+/**
+ * @brief Number of seconds currently kept in the SD card ring buffer,
+ * which follows the event window of the active profile
+ */
+int camera_svc_ring_size();
+
+#endif  // __PERF_CONFIG_H
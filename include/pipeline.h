@@ -0,0 +1,255 @@
+#ifndef __PIPELINE_H
+#define __PIPELINE_H
+
+#include <Arduino.h>
+
+#include "app_config.h"
+#include "esp_camera.h"
+#include "frame_index.h"
+#include "jpeg_crop.h"
+#include "jpeg_tables.h"
+#include "link_arbiter.h"
+#include "log_ring.h"
+#include "perf_config.h"
+#include "static_scene.h"
+
+/**
+ * Capture, crop, save and stream stages of the camera pipeline.
+ *
+ * Each stage is a template over the backends it talks to, which are
+ * plain structs picked at compile time. Nothing is virtual, so the
+ * device build compiles to the same direct calls as before, and a
+ * stage can be built against other backends (see `pipeline_host.h`)
+ * to be run and timed on its own. Device backends are in
+ * `pipeline_device.h`. A backend provides:
+ *
+ * Source:    `camera_fb_t *acquire()`, `void release(camera_fb_t *)`
+ * Clock:     `uint32_t epoch()` (seconds), `int64_t micros()`,
+ *            `uint32_t millis()`
+ * Sink:      `void begin_slot(int slot)`,
+ *            `size_t write(int slot, int frame, const uint8_t *buf,
+ *                          size_t len, const jpeg_strip_t &strip)`
+ * Transport: `bool send(const uint8_t *buf, size_t len, uint32_t epoch,
+ *                       int frame, uint32_t deadline_ms, bool *kept)`,
+ *            `frame` is -1 for previews and `kept` is set when the
+ *            receiver kept a copy event uploads can refer to
+ */
+
+// === Stages ===
+
+/**
+ * @brief Takes frames from `Source` and stamps them with their
+ * capture second and the time within it
+ *
+ */
+template <class Source, class Clock>
+class CaptureStage {
+ public:
+  /**
+   * @brief Follow the clock, call once per capture
+   * @return true when a new second started since the last call
+   */
+  bool tick(int ring_size) {
+    epoch_ = clock_.epoch();
+    int slot = epoch_ % ring_size;
+    if (slot == slot_) return false;
+    slot_ = slot;
+    second_start_us_ = clock_.micros();
+    return true;
+  }
+
+  /**
+   * @brief Forget the current second, after the ring buffer layout
+   * changed
+   */
+  void reset(int ring_size) {
+    epoch_ = clock_.epoch();
+    slot_ = epoch_ % ring_size;
+    second_start_us_ = clock_.micros();
+  }
+
+  /**
+   * @param ms Set to the capture time within the current second
+   * @return NULL if the source has no frame
+   */
+  camera_fb_t *capture(uint16_t *ms) {
+    camera_fb_t *fb = source_.acquire();
+    if (!fb) return NULL;
+    int64_t fb_us =
+        (int64_t)fb->timestamp.tv_sec * 1000000 + fb->timestamp.tv_usec;
+    *ms = constrain((fb_us - second_start_us_) / 1000, 0, 999);
+    return fb;
+  }
+
+  void release(camera_fb_t *fb) { source_.release(fb); }
+
+  uint32_t epoch() const { return epoch_; }
+  int slot() const { return slot_; }
+
+  Source &source() { return source_; }
+  Clock &clock() { return clock_; }
+
+ private:
+  Source source_;
+  Clock clock_;
+  uint32_t epoch_ = 0;
+  int slot_ = -1;
+  int64_t second_start_us_ = 0;
+};
+
+/**
+ * @brief Cuts frames down to the region of interest of the active
+ * profile, without re-encoding them (see `jpeg_crop.h`)
+ * @note Frames which cannot be cropped are passed on as they are.
+ * The cost of each crop is accumulated and periodically printed
+ */
+template <class Clock>
+class CropStage {
+ public:
+  explicit CropStage(const char *name) : name_(name) {}
+
+  /**
+   * @param tmp Filled in with the cropped frame
+   * @return `tmp`, or `fb` if it was not cropped. The cropped data
+   * stays valid until the next call
+   */
+  const camera_fb_t *apply(const camera_fb_t *fb, camera_fb_t *tmp) {
+    const jpeg_roi_t roi = {
+        (uint8_t)perfConfig.roi_left, (uint8_t)perfConfig.roi_top,
+        (uint8_t)perfConfig.roi_width, (uint8_t)perfConfig.roi_height};
+    jpeg_crop_out_t out;
+
+    if (fb->format != PIXFORMAT_JPEG || !jpeg_roi_crops(roi)) return fb;
+    if (!crop_ && !(crop_ = jpeg_crop_new())) return fb;
+
+    int64_t start_us = clock_.micros();
+    bool cropped = jpeg_crop(crop_, fb->buf, fb->len, roi, &out);
+    account(cropped, fb->len, cropped ? out.len : fb->len,
+            clock_.micros() - start_us);
+    if (!cropped) return fb;
+
+    *tmp = *fb;
+    tmp->buf = (uint8_t *)out.buf;
+    tmp->len = out.len;
+    tmp->width = out.width;
+    tmp->height = out.height;
+    return tmp;
+  }
+
+ private:
+  void account(bool cropped, size_t in, size_t out, uint32_t us) {
+    frames_++;
+    if (!cropped) failed_++;
+    us_total_ += us;
+    us_max_ = max(us_max_, us);
+    bytes_in_ += in;
+    bytes_out_ += out;
+    if (frames_ < JPEG_CROP_STATS_INTERVAL) return;
+
+    LOG_I("ROI crop (%s): %lu frames, %lu failed, avg %lu us, max %lu us, "
+          "%u%% of bytes",
+          name_, frames_, failed_, (uint32_t)(us_total_ / frames_), us_max_,
+          (unsigned)(bytes_out_ * 100 / bytes_in_));
+    frames_ = failed_ = us_max_ = 0;
+    us_total_ = bytes_in_ = bytes_out_ = 0;
+  }
+
+  const char *name_;
+  Clock clock_;
+  jpeg_crop_t *crop_ = NULL;
+  uint32_t frames_ = 0;
+  uint32_t failed_ = 0;
+  uint32_t us_max_ = 0;
+  uint64_t us_total_ = 0;
+  uint64_t bytes_in_ = 0;
+  uint64_t bytes_out_ = 0;
+};
+
+/**
+ * @brief Stores frames into ring buffer slots of `Sink` and records
+ * them in the frame index
+ * @note Repeats of a static scene are only indexed, and frames are
+ * stripped of their JPEG tables when enabled
+ */
+template <class Sink>
+class SaveStage {
+ public:
+  void save(int slot, uint32_t epoch, int frame, uint16_t ms,
+            const camera_fb_t *fb) {
+    if (slot != last_slot_) {
+      sink_.begin_slot(slot);
+      last_slot_ = slot;
+      stored_ = false;
+      frame_index_begin_slot(slot, epoch);
+    }
+
+    // The first frame saved into every second is always stored in
+    // full, so a repeat never refers to a frame outside its second.
+    // It is not always frame 0, frames can be dropped before saving
+    if (static_scene_is_repeat(fb, !stored_, perfConfig.static_threshold)) {
+      frame_index_add(slot, frame, 0, ms, true, true, 0);
+      return;
+    }
+
+    // Frames which cannot be abbreviated are stored as they are
+    jpeg_strip_t strip = {0};
+    strip.len = fb->len;
+#if CONFIG_JPEG_ABBREVIATED
+    jpeg_tables_strip(fb->buf, fb->len, &strip);
+#endif
+
+    size_t written = sink_.write(slot, frame, fb->buf, fb->len, strip);
+    frame_index_add(slot, frame, written, ms, written == strip.len, false,
+                    strip.tables);
+    if (written == strip.len) stored_ = true;
+  }
+
+  /**
+   * @brief Start the next frame in a fresh slot, even if it is the
+   * same as the last one (e.g. its directory was moved away)
+   */
+  void reset() { last_slot_ = -1; }
+
+  Sink &sink() { return sink_; }
+
+ private:
+  Sink sink_;
+  int last_slot_ = -1;
+  bool stored_ = false;  // A frame of `last_slot_` was stored in full
+};
+
+/**
+ * @brief Sends frames over `Transport` within the link budget shared
+ * with event uploads
+ *
+ */
+template <class Transport, class Clock>
+class StreamStage {
+ public:
+  /**
+   * @param frame Frame number within `epoch`, -1 for a preview
+   * @param kept Set when the receiver kept a copy of the frame
+   * @return false if the frame was skipped or could not be sent
+   */
+  bool send(const uint8_t *buf, size_t len, uint32_t epoch, int frame,
+            uint32_t deadline_ms, bool *kept) {
+    *kept = false;
+    // Event uploads get the link first
+    if (!link_acquire(LINK_CLASS::STREAM, len)) return false;
+
+    uint32_t start_ms = clock_.millis();
+    bool sent = transport_.send(buf, len, epoch, frame, deadline_ms, kept);
+    if (sent) {
+      link_report(LINK_CLASS::STREAM, len, clock_.millis() - start_ms);
+    }
+    return sent;
+  }
+
+  Transport &transport() { return transport_; }
+
+ private:
+  Transport transport_;
+  Clock clock_;
+};
+
+#endif  // __PIPELINE_H
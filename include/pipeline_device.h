@@ -0,0 +1,80 @@
+#ifndef __PIPELINE_DEVICE_H
+#define __PIPELINE_DEVICE_H
+
+#include <Arduino.h>
+
+#include "esp_camera.h"
+#include "esp_timer.h"
+#include "jpeg_tables.h"
+#include "main.h"
+#include "pipeline.h"
+
+/**
+ * @brief Frames from the camera driver
+ *
+ */
+struct EspCameraSource {
+  camera_fb_t *acquire() { return esp_camera_fb_get(); }
+  void release(camera_fb_t *fb) { esp_camera_fb_return(fb); }
+};
+
+/**
+ * @brief NTP time for capture seconds, the high resolution timer
+ * within them
+ *
+ */
+struct NtpClock {
+  uint32_t epoch() { return timeClient.getEpochTime(); }
+  int64_t micros() { return esp_timer_get_time(); }
+  uint32_t millis() { return ::millis(); }
+};
+
+/**
+ * @brief Ring buffer slots as directories of the SD card
+ * (`CAMERA_FB_ROOT/<slot>/<frame>.jpg`)
+ *
+ */
+struct SdFrameSink {
+  void begin_slot(int slot);
+  size_t write(int slot, int frame, const uint8_t *buf, size_t len,
+               const jpeg_strip_t &strip);
+};
+
+/**
+ * @brief One HTTP PUT per frame to the coordinator stream endpoint
+ * @note `kept` is set when the coordinator answers 204 to a full frame.
+ * Frames go out without their JPEG tables once the coordinator holds
+ * them, the same way as event uploads (`Table-Set`, `Frame-Tables`)
+ */
+class HttpStreamTransport {
+ public:
+  void begin(const String &url) {
+    url_ = url;
+    memset(sent_, 0, sizeof(sent_));
+    refused_ = false;
+  }
+  bool send(const uint8_t *buf, size_t len, uint32_t epoch, int frame,
+            uint32_t deadline_ms, bool *kept);
+
+ private:
+  uint8_t tables_id();
+
+  String url_;
+  jpeg_tables_t tables_;  // Of the frame being sent
+  // Hash of the set the coordinator holds under each id, 0 if none
+  uint32_t sent_[JPEG_TABLES_MAX_SETS + 1] = {};
+  uint8_t last_id_ = 0;
+  bool refused_ = false;  // The coordinator does not take table sets
+};
+
+/**
+ * @brief Fragmented UDP datagrams (see `udp_stream.h`)
+ * @note Frames always go out in full, a lost table set would leave
+ * every frame after it undecodable
+ */
+struct UdpStreamTransport {
+  bool send(const uint8_t *buf, size_t len, uint32_t epoch, int frame,
+            uint32_t deadline_ms, bool *kept);
+};
+
+#endif  // __PIPELINE_DEVICE_H
@@ -0,0 +1,148 @@
+#ifndef __PIPELINE_HOST_H
+#define __PIPELINE_HOST_H
+
+#include <Arduino.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "pipeline.h"
+
+/**
+ * Backends for running pipeline stages off the device, e.g. to time
+ * a stage on its own with repeatable input. They only keep data in
+ * memory and take their time from `ManualClock`, so two runs with
+ * the same input behave the same. The stages still call into the
+ * frame index, static scene, JPEG table and link modules, which are
+ * built from `src/` along with them. See `test/test_pipeline`, run
+ * with `pio test -e native`.
+ */
+
+/**
+ * @brief Time which only moves when told to
+ * @note Shared by every instance, so sources and stages agree on it
+ */
+struct ManualClock {
+  static uint64_t &now_us() {
+    static uint64_t t = 0;
+    return t;
+  }
+  static void advance_ms(uint32_t ms) { now_us() += (uint64_t)ms * 1000; }
+
+  // Starts at an arbitrary, but realistic, epoch
+  uint32_t epoch() { return 1700000000 + now_us() / 1000000; }
+  int64_t micros() { return now_us(); }
+  uint32_t millis() { return now_us() / 1000; }
+};
+
+/**
+ * @brief Frames built from a template JPEG, stamped with `ManualClock`
+ * @note `vary` bytes in the middle of the scan change from frame to
+ * frame, so static scene detection can be exercised either way
+ */
+class SyntheticSource {
+ public:
+  void begin(const uint8_t *jpeg, size_t len, uint16_t width, uint16_t height,
+             size_t vary = 0) {
+    image_.assign(jpeg, jpeg + len);
+    vary_ = vary;
+    fb_.width = width;
+    fb_.height = height;
+    fb_.format = PIXFORMAT_JPEG;
+  }
+
+  camera_fb_t *acquire() {
+    if (image_.empty() || in_use_) return NULL;
+    // Stay clear of the end of image marker
+    size_t mid = image_.size() / 2;
+    for (size_t i = 0; i < vary_ && mid + i + 2 < image_.size(); i++) {
+      image_[mid + i] = (uint8_t)(count_ + i);
+    }
+    fb_.buf = image_.data();
+    fb_.len = image_.size();
+    fb_.timestamp.tv_sec = ManualClock::now_us() / 1000000;
+    fb_.timestamp.tv_usec = ManualClock::now_us() % 1000000;
+    in_use_ = true;
+    count_++;
+    return &fb_;
+  }
+
+  void release(camera_fb_t *fb) { in_use_ = false; }
+
+  uint32_t count() const { return count_; }
+
+ private:
+  std::vector<uint8_t> image_;
+  size_t vary_ = 0;
+  camera_fb_t fb_ = {};
+  bool in_use_ = false;  // Like the driver, one frame at a time
+  uint32_t count_ = 0;
+};
+
+/**
+ * @brief Ring buffer slots kept in memory, in the same abbreviated
+ * form they would have on the card
+ *
+ */
+class MemorySink {
+ public:
+  void begin_slot(int slot) {
+    for (auto it = frames_.begin(); it != frames_.end();) {
+      it = it->first.first == slot ? frames_.erase(it) : std::next(it);
+    }
+  }
+
+  size_t write(int slot, int frame, const uint8_t *buf, size_t len,
+               const jpeg_strip_t &strip) {
+    std::vector<uint8_t> &out = frames_[{slot, frame}];
+    size_t pos = 0;
+
+    out.clear();
+    if (strip.tables) {
+      for (int i = 0; i < strip.run_count; i++) {
+        out.insert(out.end(), buf + pos, buf + strip.runs[i].offset);
+        pos = strip.runs[i].offset + strip.runs[i].len;
+      }
+    }
+    out.insert(out.end(), buf + pos, buf + len);
+    bytes_ += out.size();
+    return out.size();
+  }
+
+  const std::vector<uint8_t> *frame(int slot, int frame) const {
+    auto it = frames_.find({slot, frame});
+    return it == frames_.end() ? NULL : &it->second;
+  }
+
+  uint64_t bytes() const { return bytes_; }
+
+ private:
+  std::map<std::pair<int, int>, std::vector<uint8_t>> frames_;
+  uint64_t bytes_ = 0;
+};
+
+/**
+ * @brief Accepts every frame and counts what went through
+ * @note Full frames are reported as kept, like a coordinator
+ * answering 204
+ */
+class CountingTransport {
+ public:
+  bool send(const uint8_t *buf, size_t len, uint32_t epoch, int frame,
+            uint32_t deadline_ms, bool *kept) {
+    frames_++;
+    bytes_ += len;
+    *kept = frame >= 0;
+    return true;
+  }
+
+  uint32_t frames() const { return frames_; }
+  uint64_t bytes() const { return bytes_; }
+
+ private:
+  uint32_t frames_ = 0;
+  uint64_t bytes_ = 0;
+};
+
+#endif  // __PIPELINE_HOST_H
@@ -0,0 +1,21 @@
+#ifndef __STATIC_SCENE_H
+#define __STATIC_SCENE_H
+
+#include "esp_camera.h"
+
+/**
+ * @brief Check whether a frame is nearly identical to the last
+ * frame which was stored in full
+ * @param fb JPEG frame about to be saved
+ * @param keyframe Force the frame to be stored in full and become
+ * the new reference
+ * @param threshold Mean luma difference (0-255) under which frames
+ * match, 0 disables the check
+ * @note Frames whose size changed by more than
+ * `CONFIG_STATIC_SCENE_SIZE_PCT` are never decoded. Otherwise a
+ * 1/8 scale (DC only) decode is reduced to an 8x8 luma signature
+ */
+bool static_scene_is_repeat(const camera_fb_t *fb, bool keyframe,
+                            int threshold);
+
+#endif  // __STATIC_SCENE_H
@@ -0,0 +1,44 @@
+#ifndef __UDP_STREAM_H
+#define __UDP_STREAM_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Values of the "StreamTransport" setting
+ *
+ */
+#define STREAM_TRANSPORT_HTTP (0)  // One HTTP PUT per frame
+#define STREAM_TRANSPORT_UDP (1)   // Fragmented UDP datagrams
+
+/**
+ * @brief Size of the header at the start of every datagram.
+ * All fields are big endian:
+ *
+ * | Offset | Size | Field                                  |
+ * |--------|------|----------------------------------------|
+ * | 0      | 2    | Magic, "HS"                            |
+ * | 2      | 1    | Version, `UDP_STREAM_VERSION`          |
+ * | 3      | 1    | Flags, reserved                        |
+ * | 4      | 4    | Datagram sequence number               |
+ * | 8      | 4    | Frame ID, incremented for every frame  |
+ * | 12     | 4    | Capture time of the frame (epoch)      |
+ * | 16     | 4    | Total size of the frame                |
+ * | 20     | 2    | Index of this fragment                 |
+ * | 22     | 2    | Number of fragments in the frame       |
+ *
+ * @note `tools/udp_stream_rx.py` is a receiver for testing
+ */
+#define UDP_STREAM_HEADER_SIZE (24)
+#define UDP_STREAM_VERSION (1)
+
+/**
+ * @brief Send a frame to the coordinator as a series of datagrams
+ * @param deadline_ms Time after which the rest of the frame is
+ * abandoned. The receiver drops incomplete frames, so a late frame
+ * never holds up the next one
+ * @return false if the frame was not sent completely
+ */
+bool udp_stream_send(const uint8_t *buf, size_t len, uint32_t epoch,
+                     uint32_t deadline_ms);
+
+#endif  // __UDP_STREAM_H
@@ -0,0 +1,632 @@
+#include "archive.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "app_config.h"
+#include "event_outbox.h"
+#include "frame_index.h"
+#include "jpeg_tables.h"
+#include "log_ring.h"
+#include "main.h"
+#include "perf_config.h"
+
+// === Local Defines ===
+
+// Seconds of footage per segment file
+#define ARCHIVE_SEGMENT_SECONDS (60)
+#define ARCHIVE_MAGIC (0x52414848)  // "HHAR"
+// A second is archived this long before the ring buffer reuses its
+// slot, and never sooner than this after it started
+#define ARCHIVE_LAG_SECONDS (2)
+#define ARCHIVE_POLL_MS (500)
+#define ARCHIVE_MAINTAIN_MS (60 * 1000)
+#define ARCHIVE_QUOTA_BYTES ((uint64_t)CONFIG_ARCHIVE_QUOTA_MB * 1024 * 1024)
+#define ARCHIVE_RETENTION_SECONDS \
+  ((uint32_t)CONFIG_ARCHIVE_RETENTION_HOURS * 3600)
+#define ARCHIVE_REQUEST_DEPTH (4)
+#define ARCHIVE_PATH_SZ (48)
+#define ARCHIVE_CHUNK_SZ (4096)
+
+// How thinly a segment is kept
+#define LEVEL_FULL (0)    // Every frame
+#define LEVEL_SECOND (1)  // First frame of every second
+#define LEVEL_SPARSE (2)  // First frame every `CONFIG_ARCHIVE_SPARSE_INTERVAL`
+
+#define ENTRY_REPEAT (1 << 0)
+
+// === Types ===
+
+// Start of a segment index file (`<start>.idx`)
+typedef struct {
+  uint32_t magic;
+  uint8_t level;
+  uint8_t reserved[3];
+} archive_header_t;
+
+// A frame in a segment index file, in capture order
+typedef struct {
+  uint32_t epoch;
+  uint16_t ms;
+  uint16_t flags;
+  uint32_t offset;  // In the segment data file (`<start>.jpg`)
+  uint32_t size;
+} archive_entry_t;
+
+// A segment in the time index
+typedef struct {
+  uint32_t start;
+  uint32_t bytes;  // Data and index files together
+  uint8_t level;
+} archive_segment_t;
+
+typedef struct {
+  uint32_t from;
+  uint32_t to;
+} archive_request_t;
+
+// === Variables ===
+
+// Time index, oldest first. Also held while segment files are replaced
+static std::vector<archive_segment_t> segments;
+static uint64_t segments_bytes = 0;
+static SemaphoreHandle_t archive_mutex;
+static QueueHandle_t archive_requests;
+
+// Segment being written, only used by the archive task
+static uint32_t seg_start = 0;
+static File seg_data;
+static File seg_index;
+static archive_entry_t seg_last;  // Last frame written
+static uint32_t seg_last_kept;    // Capture second of `seg_last`
+
+static const jpeg_tables_t no_tables = {};
+
+TaskHandle_t ArchiveTask;
+
+// === Local Functions ===
+
+static void archive_task(void *pvParameters);
+static void archive_restore();
+static void archive_second(uint32_t epoch);
+static bool segment_open(uint32_t epoch);
+static void segment_close();
+static void segment_grew(uint32_t start, uint32_t bytes);
+static void decimate(const archive_segment_t &seg, uint8_t level);
+static void enforce_budget(uint32_t now);
+static void export_clip(const archive_request_t &req);
+static bool read_entries(uint32_t start, std::vector<archive_entry_t> &out);
+static bool keep_frame(uint8_t level, uint32_t epoch, uint32_t *last_kept);
+static uint8_t level_for_age(uint32_t age);
+static size_t copy_bytes(Stream &from, File &to, size_t len);
+static void segment_path(char *path, size_t len, uint32_t start,
+                         const char *ext);
+
+void archive_start() {
+#if CONFIG_ARCHIVE_RETENTION_HOURS
+  archive_mutex = xSemaphoreCreateMutex();
+  archive_requests =
+      xQueueCreate(ARCHIVE_REQUEST_DEPTH, sizeof(archive_request_t));
+
+  if (!SD_MMC.exists(CAMERA_ARCHIVE_ROOT)) {
+    SD_MMC.mkdir(CAMERA_ARCHIVE_ROOT);
+  }
+  archive_restore();
+
+  xTaskCreate(archive_task, "ArchiveTask", 8192, NULL, 2, &ArchiveTask);
+#endif
+}
+
+int archive_find(uint32_t epoch, char *path, size_t len, archive_frame_t *out,
+                 int max) {
+  // Entries of the last segment looked up, lookups usually walk
+  // through consecutive seconds
+  static std::vector<archive_entry_t> cached;
+  static uint32_t cached_start = 0;
+  static uint32_t cached_bytes = 0;
+  uint32_t start = epoch - epoch % ARCHIVE_SEGMENT_SECONDS;
+  int count = 0;
+
+  if (!archive_mutex) return 0;
+
+  xSemaphoreTake(archive_mutex, portMAX_DELAY);
+  auto seg = std::find_if(
+      segments.begin(), segments.end(),
+      [=](const archive_segment_t &s) { return s.start == start; });
+  if (seg != segments.end()) {
+    // The segment being written keeps growing
+    if (cached_start != start || cached_bytes != seg->bytes) {
+      cached.clear();
+      cached_start = 0;
+      if (read_entries(start, cached)) {
+        cached_start = start;
+        cached_bytes = seg->bytes;
+      }
+    }
+
+    auto e = std::lower_bound(
+        cached.begin(), cached.end(), epoch,
+        [](const archive_entry_t &a, uint32_t t) { return a.epoch < t; });
+    for (; e != cached.end() && e->epoch == epoch && count < max; ++e) {
+      out[count++] = {e->epoch, e->ms, (e->flags & ENTRY_REPEAT) != 0,
+                      e->offset, e->size};
+    }
+  }
+  xSemaphoreGive(archive_mutex);
+
+  if (count > 0) segment_path(path, len, start, "jpg");
+  return count;
+}
+
+bool archive_request_upload(uint32_t from, uint32_t to) {
+  archive_request_t req = {from, to};
+
+  if (!archive_requests || to <= from) return false;
+  return xQueueSend(archive_requests, &req, 0) == pdTRUE;
+}
+
+static void archive_task(void *pvParameters) {
+  archive_request_t req;
+  uint32_t next_epoch = 0;
+  uint32_t maintain_ms = millis();
+
+  for (;;) {
+    // Times before the first sync cannot be placed
+    if (timeClient.isTimeSet()) {
+      uint32_t now = timeClient.getEpochTime();
+
+      // Seconds which already left the ring buffer are lost
+      const int ring = camera_svc_ring_size();
+      uint32_t oldest = now - ring + 1;
+      if ((int32_t)(next_epoch - oldest) < 0) {
+        next_epoch = oldest;
+      }
+      // Copied just before the ring buffer reuses their slot.
+      // Seconds handed to the outbox are copied as they are handed
+      // over, the event may be uploaded and removed before then
+      uint32_t until =
+          now - max(ring - ARCHIVE_LAG_SECONDS, ARCHIVE_LAG_SECONDS);
+      uint32_t handed = event_outbox_handed_until();
+      if ((int32_t)(handed - until) > 0) until = handed;
+      while ((int32_t)(until - next_epoch) >= 0) {
+        archive_second(next_epoch++);
+      }
+
+      if (xQueueReceive(archive_requests, &req, 0) == pdTRUE) {
+        export_clip(req);
+      }
+
+      if (millis() - maintain_ms >= ARCHIVE_MAINTAIN_MS) {
+        maintain_ms = millis();
+        std::vector<archive_segment_t> snap;
+        uint64_t bytes;
+        xSemaphoreTake(archive_mutex, portMAX_DELAY);
+        snap = segments;
+        bytes = segments_bytes;
+        xSemaphoreGive(archive_mutex);
+
+        for (const archive_segment_t &seg : snap) {
+          if (seg.start == seg_start) continue;
+          uint8_t level =
+              level_for_age(now - (seg.start + ARCHIVE_SEGMENT_SECONDS));
+          if (level > seg.level) decimate(seg, level);
+        }
+        enforce_budget(now);
+
+        LOG_I("Archive: %u segments, %lu KB", (unsigned)snap.size(),
+              (uint32_t)(bytes / 1024));
+      }
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(ARCHIVE_POLL_MS));
+  }
+}
+
+static void archive_restore() {
+  File root = SD_MMC.open(CAMERA_ARCHIVE_ROOT);
+  if (!root || !root.isDirectory()) {
+    return;
+  }
+
+  std::vector<String> leftovers;
+  File entry;
+  while ((entry = root.openNextFile())) {
+    String name = entry.name();
+    size_t size = entry.size();
+    entry.close();
+
+    // Interrupted while being thinned out
+    if (name.endsWith(".tmp")) {
+      leftovers.push_back(name);
+      continue;
+    }
+    if (!name.endsWith(".idx")) continue;
+
+    archive_segment_t seg;
+    archive_header_t header;
+    char path[ARCHIVE_PATH_SZ];
+    seg.start = strtoul(name.c_str(), NULL, 10);
+    segment_path(path, sizeof(path), seg.start, "idx");
+    File index = SD_MMC.open(path, FILE_READ);
+    bool ok = index && index.read((uint8_t *)&header, sizeof(header)) ==
+                           sizeof(header) &&
+              header.magic == ARCHIVE_MAGIC;
+    if (index) index.close();
+
+    segment_path(path, sizeof(path), seg.start, "jpg");
+    File data = SD_MMC.open(path, FILE_READ);
+    if (!ok || !data) {
+      if (data) data.close();
+      leftovers.push_back(name);
+      continue;
+    }
+    seg.level = header.level;
+    seg.bytes = size + data.size();
+    data.close();
+    segments.push_back(seg);
+    segments_bytes += seg.bytes;
+  }
+  root.close();
+
+  for (const String &name : leftovers) {
+    SD_MMC.remove((String(CAMERA_ARCHIVE_ROOT) + "/" + name).c_str());
+  }
+
+  std::sort(segments.begin(), segments.end(),
+            [](const archive_segment_t &a, const archive_segment_t &b) {
+              return a.start < b.start;
+            });
+
+  if (!segments.empty()) {
+    Serial.printf("Restored %u archive segments (%llu bytes)\n",
+                  (unsigned)segments.size(), segments_bytes);
+  }
+}
+
+/**
+ * @brief Copy a second which is about to leave the ring buffer
+ * @note Seconds already handed to the outbox are copied from there,
+ * their slot stays listed until the ring buffer reuses it.
+ * Frames are stored expanded, so the archive does not depend on
+ * table sets which only live in memory
+ */
+static void archive_second(uint32_t epoch) {
+  static frame_index_slot_t info;
+  static jpeg_tables_t event_set;
+  char dir[ARCHIVE_PATH_SZ];
+  char event_dir[ARCHIVE_PATH_SZ];
+  char path[ARCHIVE_PATH_SZ + 16];
+  int slot = -1;
+  int loaded = 0;  // Table set held in `event_set`
+
+  bool from_ring = frame_index_find(epoch, camera_svc_ring_size(), &info,
+                                    &slot);
+  if (from_ring) {
+    snprintf(dir, sizeof(dir), "%s/%d", CAMERA_FB_ROOT, slot);
+    from_ring = SD_MMC.exists(dir);
+  }
+  if (!from_ring) {
+    slot = -1;
+    if (!event_outbox_find(epoch, dir, event_dir, sizeof(dir), &info)) return;
+  }
+  if (!segment_open(epoch)) return;
+
+  uint8_t level = level_for_age(0);
+  for (int n = 0; n < info.count; n++) {
+    const frame_index_entry_t &e = info.frames[n];
+    if (!e.valid || !keep_frame(level, epoch, &seg_last_kept)) continue;
+
+    archive_entry_t entry = {epoch, e.ms, 0, 0, 0};
+    if (e.repeat) {
+      if (seg_last.size == 0) continue;
+      entry.flags = ENTRY_REPEAT;
+      entry.offset = seg_last.offset;
+      entry.size = seg_last.size;
+    } else {
+      // Overwritten by the ring buffer in the meantime
+      if (slot >= 0 && frame_index_epoch(slot) != epoch) break;
+
+      const jpeg_tables_t *tables = &no_tables;
+      if (e.tables && slot >= 0) {
+        tables = jpeg_tables_get(e.tables);
+      } else if (e.tables) {
+        snprintf(path, sizeof(path), "%s/tables%u", event_dir, e.tables);
+        if (loaded == e.tables || jpeg_tables_load(&event_set, path)) {
+          loaded = e.tables;
+          tables = &event_set;
+        } else {
+          tables = NULL;
+        }
+      }
+      if (!tables) continue;
+
+      snprintf(path, sizeof(path), "%s/%d.jpg", dir, n);
+      File file = SD_MMC.open(path, FILE_READ);
+      if (!file) continue;
+      JpegExpandStream src(file, *tables);
+      size_t len = JpegExpandStream::expanded_len(e.size, *tables);
+      entry.offset = seg_data.size();
+      entry.size = copy_bytes(src, seg_data, len);
+      file.close();
+      if (entry.size != len) break;
+    }
+
+    seg_index.write((const uint8_t *)&entry, sizeof(entry));
+    seg_last = entry;
+  }
+
+  // Readers only see what has reached the card
+  seg_data.flush();
+  seg_index.flush();
+  segment_grew(seg_start, seg_data.size() + seg_index.size());
+}
+
+// Make the segment holding `epoch` the one being written
+static bool segment_open(uint32_t epoch) {
+  uint32_t start = epoch - epoch % ARCHIVE_SEGMENT_SECONDS;
+  char path[ARCHIVE_PATH_SZ];
+
+  if (start == seg_start && seg_data && seg_index) return true;
+  segment_close();
+
+  segment_path(path, sizeof(path), start, "idx");
+  bool fresh = !SD_MMC.exists(path);
+  seg_index = SD_MMC.open(path, FILE_APPEND);
+  segment_path(path, sizeof(path), start, "jpg");
+  seg_data = SD_MMC.open(path, FILE_APPEND);
+  if (!seg_index || !seg_data) {
+    LOG_E("Failed to open archive segment %lu", start);
+    segment_close();
+    return false;
+  }
+
+  if (fresh) {
+    archive_header_t header = {ARCHIVE_MAGIC, level_for_age(0), {0}};
+    seg_index.write((const uint8_t *)&header, sizeof(header));
+
+    xSemaphoreTake(archive_mutex, portMAX_DELAY);
+    segments.push_back({start, 0, header.level});
+    xSemaphoreGive(archive_mutex);
+  }
+  seg_start = start;
+  seg_last = {0, 0, 0, 0, 0};
+  seg_last_kept = UINT32_MAX;
+  return true;
+}
+
+static void segment_close() {
+  if (seg_data) seg_data.close();
+  if (seg_index) seg_index.close();
+  seg_start = 0;
+}
+
+static void segment_grew(uint32_t start, uint32_t bytes) {
+  xSemaphoreTake(archive_mutex, portMAX_DELAY);
+  for (archive_segment_t &seg : segments) {
+    if (seg.start != start) continue;
+    segments_bytes += bytes - seg.bytes;
+    seg.bytes = bytes;
+    break;
+  }
+  xSemaphoreGive(archive_mutex);
+}
+
+/**
+ * @brief Rewrite a segment keeping only the frames `level` keeps
+ * @note The new files are written next to the old ones and swapped
+ * in while holding the time index, so lookups never see a mix
+ */
+static void decimate(const archive_segment_t &seg, uint8_t level) {
+  std::vector<archive_entry_t> entries;
+  char path[ARCHIVE_PATH_SZ];
+  char tmp[ARCHIVE_PATH_SZ];
+  uint32_t last_kept = UINT32_MAX;
+  uint32_t old_offset = UINT32_MAX;  // Last frame copied, in the old file
+  uint32_t new_offset = 0;
+
+  if (!read_entries(seg.start, entries)) return;
+
+  segment_path(path, sizeof(path), seg.start, "jpg");
+  File data = SD_MMC.open(path, FILE_READ);
+  segment_path(tmp, sizeof(tmp), seg.start, "jpg.tmp");
+  File out_data = SD_MMC.open(tmp, FILE_WRITE);
+  segment_path(tmp, sizeof(tmp), seg.start, "idx.tmp");
+  File out_index = SD_MMC.open(tmp, FILE_WRITE);
+  bool ok = data && out_data && out_index;
+
+  if (ok) {
+    archive_header_t header = {ARCHIVE_MAGIC, level, {0}};
+    out_index.write((const uint8_t *)&header, sizeof(header));
+  }
+  for (size_t i = 0; ok && i < entries.size(); i++) {
+    archive_entry_t e = entries[i];
+    if (!keep_frame(level, e.epoch, &last_kept)) continue;
+
+    // Repeats stay repeats only if what they repeat was kept
+    if (e.offset == old_offset) {
+      e.offset = new_offset;
+    } else {
+      old_offset = e.offset;
+      new_offset = out_data.size();
+      data.seek(e.offset);
+      ok = copy_bytes(data, out_data, e.size) == e.size;
+      e.flags &= ~ENTRY_REPEAT;
+      e.offset = new_offset;
+    }
+    out_index.write((const uint8_t *)&e, sizeof(e));
+  }
+
+  uint32_t bytes = out_data ? out_data.size() : 0;
+  bytes += out_index ? out_index.size() : 0;
+  if (data) data.close();
+  if (out_data) out_data.close();
+  if (out_index) out_index.close();
+
+  if (!ok) {
+    segment_path(tmp, sizeof(tmp), seg.start, "jpg.tmp");
+    SD_MMC.remove(tmp);
+    segment_path(tmp, sizeof(tmp), seg.start, "idx.tmp");
+    SD_MMC.remove(tmp);
+    LOG_E("Failed to thin out archive segment %lu", seg.start);
+    return;
+  }
+
+  xSemaphoreTake(archive_mutex, portMAX_DELAY);
+  const char *exts[][2] = {{"jpg", "jpg.tmp"}, {"idx", "idx.tmp"}};
+  for (auto &ext : exts) {
+    segment_path(path, sizeof(path), seg.start, ext[0]);
+    segment_path(tmp, sizeof(tmp), seg.start, ext[1]);
+    SD_MMC.remove(path);
+    SD_MMC.rename(tmp, path);
+  }
+  for (archive_segment_t &s : segments) {
+    if (s.start != seg.start) continue;
+    segments_bytes += bytes - s.bytes;
+    s.bytes = bytes;
+    s.level = level;
+    break;
+  }
+  xSemaphoreGive(archive_mutex);
+
+  LOG_D("Archive segment %lu thinned to level %u (%lu bytes)", seg.start,
+        level, bytes);
+}
+
+// Drop the oldest segments past the retention period or the quota
+static void enforce_budget(uint32_t now) {
+  char path[ARCHIVE_PATH_SZ];
+
+  for (;;) {
+    uint32_t victim = 0;
+
+    xSemaphoreTake(archive_mutex, portMAX_DELAY);
+    if (!segments.empty() && segments.front().start != seg_start &&
+        (segments_bytes > ARCHIVE_QUOTA_BYTES ||
+         segments.front().start + ARCHIVE_SEGMENT_SECONDS +
+                 ARCHIVE_RETENTION_SECONDS <=
+             now)) {
+      victim = segments.front().start;
+      segments_bytes -= segments.front().bytes;
+      segments.erase(segments.begin());
+      segment_path(path, sizeof(path), victim, "jpg");
+      SD_MMC.remove(path);
+      segment_path(path, sizeof(path), victim, "idx");
+      SD_MMC.remove(path);
+    }
+    xSemaphoreGive(archive_mutex);
+
+    if (victim == 0) return;
+    LOG_D("Archive segment %lu dropped", victim);
+  }
+}
+
+// Copy archived footage into the outbox so it is uploaded like an event
+static void export_clip(const archive_request_t &req) {
+  static archive_frame_t frames[ARCHIVE_MAX_FRAMES_PER_SECOND];
+  char path[ARCHIVE_PATH_SZ];
+  char open_path[ARCHIVE_PATH_SZ] = "";
+  uint32_t to = min(req.to, req.from + CONFIG_ARCHIVE_MAX_CLIP_SECONDS);
+  uint32_t last_offset = UINT32_MAX;
+  bool ok = true;
+  File data;
+
+  if (!event_outbox_clip_begin(req.from)) return;
+
+  for (uint32_t t = req.from; ok && t < to; t++) {
+    int count = archive_find(t, path, sizeof(path), frames,
+                             ARCHIVE_MAX_FRAMES_PER_SECOND);
+    if (count == 0) continue;
+
+    if (strcmp(path, open_path) != 0) {
+      if (data) data.close();
+      data = SD_MMC.open(path, FILE_READ);
+      strcpy(open_path, path);
+      last_offset = UINT32_MAX;
+    }
+    ok = data && event_outbox_clip_second(t);
+
+    for (int n = 0; ok && n < count; n++) {
+      if (frames[n].offset == last_offset) {
+        ok = event_outbox_clip_frame(NULL, 0);
+      } else {
+        data.seek(frames[n].offset);
+        ok = event_outbox_clip_frame(&data, frames[n].size);
+        last_offset = frames[n].offset;
+      }
+    }
+  }
+  if (data) data.close();
+
+  if (!ok) {
+    LOG_E("Failed to export archive range [%lu, %lu)", req.from, to);
+  }
+  event_outbox_clip_end(ok);
+}
+
+static bool read_entries(uint32_t start, std::vector<archive_entry_t> &out) {
+  char path[ARCHIVE_PATH_SZ];
+  archive_header_t header;
+  archive_entry_t e;
+
+  segment_path(path, sizeof(path), start, "idx");
+  File index = SD_MMC.open(path, FILE_READ);
+  if (!index) return false;
+  if (index.read((uint8_t *)&header, sizeof(header)) != sizeof(header) ||
+      header.magic != ARCHIVE_MAGIC) {
+    index.close();
+    return false;
+  }
+  out.reserve((index.size() - sizeof(header)) / sizeof(e));
+  // A partly written entry at the end is ignored
+  while (index.read((uint8_t *)&e, sizeof(e)) == sizeof(e)) {
+    out.push_back(e);
+  }
+  index.close();
+  return true;
+}
+
+static bool keep_frame(uint8_t level, uint32_t epoch, uint32_t *last_kept) {
+  bool keep;
+
+  switch (level) {
+    case LEVEL_FULL:
+      keep = true;
+      break;
+    case LEVEL_SECOND:
+      keep = epoch != *last_kept;
+      break;
+    default:
+      keep = *last_kept == UINT32_MAX ||
+             epoch / CONFIG_ARCHIVE_SPARSE_INTERVAL !=
+                 *last_kept / CONFIG_ARCHIVE_SPARSE_INTERVAL;
+      break;
+  }
+  if (keep) *last_kept = epoch;
+  return keep;
+}
+
+static uint8_t level_for_age(uint32_t age) {
+  if (age < CONFIG_ARCHIVE_FULL_SECONDS) return LEVEL_FULL;
+  if (age < CONFIG_ARCHIVE_SPARSE_AFTER_SECONDS) return LEVEL_SECOND;
+  return LEVEL_SPARSE;
+}
+
+static size_t copy_bytes(Stream &from, File &to, size_t len) {
+  static uint8_t buf[ARCHIVE_CHUNK_SZ];
+  size_t copied = 0;
+
+  while (copied < len) {
+    size_t got = from.readBytes(buf, min<size_t>(len - copied, sizeof(buf)));
+    if (got == 0 || to.write(buf, got) != got) break;
+    copied += got;
+  }
+  return copied;
+}
+
+static void segment_path(char *path, size_t len, uint32_t start,
+                         const char *ext) {
+  snprintf(path, len, "%s/%lu.%s", CAMERA_ARCHIVE_ROOT, (unsigned long)start,
+           ext);
+}
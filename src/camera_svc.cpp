@@ -2,35 +2,52 @@
 #include <WiFi.h>
 
 #include "app_config.h"
+#include "archive.h"
 #include "board_config.h"
 #include "esp32-hal-ledc.h"
 #include "esp_camera.h"
 #include "esp_http_server.h"
 #include "esp_timer.h"
+#include "event_outbox.h"
+#include "event_preview.h"
 #include "fb_gfx.h"
+#include "frame_index.h"
+#include "frame_pool.h"
 #include "img_converters.h"
+#include "jpeg_tables.h"
+#include "link_arbiter.h"
+#include "log_ring.h"
 #include "main.h"
+#include "perf_config.h"
+#include "pipeline_device.h"
 #include "sdkconfig.h"
+#include "static_scene.h"
+#include "udp_stream.h"
 
 // === Enum Classes ===
 
 enum class CAM_STATE {
   NORMAL,     // normal operations, passively saving + straming
   RECORDING,  // Notified that it will upload its rolling buffer soon
-  UPLOADING,  // Actively uploading its video
+  UPLOADING,  // Window closed, handing its last seconds over to the outbox
 };
 
 // === Variables ===
 
 CAM_STATE camera_state;
 /**
- * @brief Time since the event event occured.
- * @note When uploading, the camera will look
- * from send from times [start_time - CAMERA_FB_SECOND_RANGE,
- * start_time + CAMERA_FB_SECOND_RANGE] (with
- * wraparound)
+ * @brief Time (epoch seconds) the event window is centered on
+ * @note The window covers [record_anchor_time - pre_event_seconds,
+ * record_anchor_time + post_event_seconds). This is the event
+ * `timestamp` unless it is too far off from the camera clock
  */
-int record_start_time;
+uint32_t record_anchor_time;
+/**
+ * @brief Time (epoch seconds) at which the event window closes,
+ * 0 when no window is open
+ *
+ */
+uint32_t record_end_time;
 /**
  * @brief Timestamp of event sent over by the sensor
  * This will be sent over to the coordinator
@@ -48,17 +65,27 @@ int global_second_counter;
 
 // === Local Defines ===
 
-#define CAMERA_FB_SAVE_SZ (CONFIG_CAMERA_FRAME_RATE * 2)
-#define MAX_FRAME_RETRIES (5)
-#define BASE_BACKOFF_MS (200)
+#define PREVIEW_STATS_INTERVAL (50)
+#define MAILBOX_STATS_INTERVAL (100)
+// Frames thrown away after switching capture profiles, while
+// the sensor settles on the new frame size
+#define CAMERA_PROFILE_SETTLE_FRAMES (2)
+// Extra ring buffer seconds so that the second being written
+// never belongs to the window being handed over
+#define CAMERA_FB_RING_SLACK (2)
+#define CAMERA_FB_MAX_SLOTS (PERF_MAX_WINDOW_SECONDS * 2 + CAMERA_FB_RING_SLACK)
 
 // === Local Functions ===
 
 void camera_svc_start();
-static void _ensure_empty_dir(const char *path);
-static void save_fb_to_sd(const camera_fb_t *fb, int time_index,
-                          int frame_index);
-static void upload_frames(int start_index, int end_index);
+static void hand_over_seconds(uint32_t epoch);
+static void close_event_window();
+static void open_event_window(uint32_t now);
+static int ring_size();
+static bool transcode_preview(const camera_fb_t *fb, int scale, uint8_t **out,
+                              size_t *out_len);
+static void perf_config_commit();
+static void camera_set_profile(bool event);
 
 // === Task Functions ===
 
@@ -74,17 +101,55 @@ TaskHandle_t CameraServiceSaveTask;
 TaskHandle_t CameraServiceHTTPTask;
 TaskHandle_t CameraServiceEventTask;
 
-QueueHandle_t CameraFBSaveQ;  // <camera_frame_t*>
-QueueHandle_t CameraFBHTTPQ;  // <camera_frame_t*>
+// Can be swapped at runtime when resized (see `frame_queue_resize`)
+QueueHandle_t volatile CameraFBSaveQ;  // <camera_frame_t*>
+// Queue replaced by the last resize, until it has been drained
+static QueueHandle_t volatile retired_queue = NULL;
+
+// Stages of the pipeline, on the device backends (see `pipeline.h`)
+static CaptureStage<EspCameraSource, NtpClock> capture_stage;
+static CropStage<NtpClock> save_crop("save");
+static SaveStage<SdFrameSink> save_stage;
+static CropStage<NtpClock> stream_crop("stream");
+static StreamStage<HttpStreamTransport, NtpClock> http_stream;
+static StreamStage<UdpStreamTransport, NtpClock> udp_stream;
+
+// Next second of the event window to hand over to the outbox,
+// 0 until the event has been opened there (see `hand_over_seconds`)
+static uint32_t handed_until = 0;
+static bool event_open = false;
+
+// Largest frame size the driver buffers were allocated for
+static framesize_t camera_max_framesize = FRAMESIZE_UXGA;
+
+// Performance profile waiting to be applied by the camera task
+static perf_config_t pending_perf;
+static volatile bool perf_pending = false;
+// Bumped whenever `pending_perf` is replaced
+static uint32_t perf_seq = 0;
+static portMUX_TYPE perf_mux = portMUX_INITIALIZER_UNLOCKED;
 
 // Reference-counted frame wrapper
 typedef struct _app_camera_frame {
   camera_fb_t *fb;
+  camera_fb_t copy;   // `fb` points here when the frame was pooled
+  bool pooled;
   int time_index;
   int frame_index;
+  uint32_t epoch;     // Capture time in seconds
+  uint16_t ms;        // Capture time within `epoch`
+  bool closes_event;  // Event window ends right before this frame
   int refs;
 } camera_frame_t;
 
+// Newest frame waiting to be streamed, NULL when empty. A newer
+// frame replaces it instead of queuing up behind it, so the stream
+// never falls behind the camera
+static camera_frame_t *stream_mailbox = NULL;
+static portMUX_TYPE mailbox_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t stat_posted = 0;
+static uint32_t stat_superseded = 0;
+
 /**
  * @note The refs counter to ensure free only once
  * was generated using AI. The logic of passing
@@ -94,13 +159,32 @@ typedef struct _app_camera_frame {
 
 static portMUX_TYPE frame_mux = portMUX_INITIALIZER_UNLOCKED;
 
-static camera_frame_t *frame_alloc(camera_fb_t *fb, int time_index,
+static camera_frame_t *frame_alloc(camera_fb_t *fb, uint32_t epoch,
+                                   uint16_t ms, int time_index,
                                    int frame_index) {
   camera_frame_t *f = (camera_frame_t *)pvPortMalloc(sizeof(camera_frame_t));
   if (!f) return NULL;
   f->fb = fb;
+  f->pooled = false;
+
+#if CONFIG_CAMERA_FB_COPY_POOL
+  // Give the driver its buffer back straight away. When the pool
+  // is exhausted the driver buffer is held as before
+  uint8_t *buf = frame_pool_copy(fb->buf, fb->len);
+  if (buf) {
+    f->copy = *fb;
+    f->copy.buf = buf;
+    f->fb = &f->copy;
+    f->pooled = true;
+    capture_stage.release(fb);
+  }
+#endif
+
   f->time_index = time_index;
   f->frame_index = frame_index;
+  f->epoch = epoch;
+  f->ms = ms;
+  f->closes_event = false;
   f->refs = 1;
   return f;
 }
@@ -125,14 +209,134 @@ static void frame_release(camera_frame_t *f) {
   portEXIT_CRITICAL(&frame_mux);
 
   if (do_free) {
-    if (f->fb) {
+    if (f->pooled) {
+      frame_pool_free(f->fb->buf);
+    } else if (f->fb) {
       // return framebuffer to driver
-      esp_camera_fb_return(f->fb);
+      capture_stage.release(f->fb);
     }
     vPortFree(f);
   }
 }
 
+/**
+ * @brief Replace a frame queue with one of a different depth
+ * @note Must only be called by the task which sends to `q`.
+ * A NULL sentinel is pushed to the old queue so the receiving
+ * task knows when it has been drained and can delete it
+ */
+static bool frame_queue_resize(QueueHandle_t volatile *q, int depth) {
+  // The queue of the last resize would be replaced before it is
+  // ever read, leaking it along with its frames. Wait for the
+  // receiving task to switch over to it first
+  while (retired_queue) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+
+  QueueHandle_t new_q = xQueueCreate(depth, sizeof(camera_frame_t *));
+  if (!new_q) return false;
+
+  QueueHandle_t old_q = *q;
+  camera_frame_t *sentinel = NULL;
+  retired_queue = old_q;
+  *q = new_q;
+  xQueueSend(old_q, &sentinel, portMAX_DELAY);
+  return true;
+}
+
+/**
+ * @brief Receive a frame from a queue which may be resized
+ * @note `frame` is set to NULL when switching over to a new queue
+ */
+static bool frame_queue_receive(QueueHandle_t volatile *q,
+                                camera_frame_t **frame) {
+  QueueHandle_t cur = *q;
+  if (xQueueReceive(cur, frame, portMAX_DELAY) != pdPASS) return false;
+
+  if (*frame == NULL && cur != *q) {
+    vQueueDelete(cur);
+    retired_queue = NULL;
+  }
+  return true;
+}
+
+/**
+ * @brief Hand a frame to the stream task, releasing the frame
+ * it has not picked up yet, if any
+ * @note Takes over the caller's reference to `frame`
+ */
+static void stream_mailbox_post(camera_frame_t *frame) {
+  camera_frame_t *old;
+
+  portENTER_CRITICAL(&mailbox_mux);
+  old = stream_mailbox;
+  stream_mailbox = frame;
+  portEXIT_CRITICAL(&mailbox_mux);
+
+  if (old) {
+    frame_release(old);
+    stat_superseded++;
+  }
+  xTaskNotifyGive(CameraServiceHTTPTask);
+
+  if (++stat_posted >= MAILBOX_STATS_INTERVAL) {
+    LOG_I("Stream mailbox: %lu of %lu frames superseded", stat_superseded,
+          stat_posted);
+    stat_posted = 0;
+    stat_superseded = 0;
+  }
+}
+
+/**
+ * @brief Wait for the next frame to stream
+ * @return NULL if woken up with nothing to send
+ */
+static camera_frame_t *stream_mailbox_take() {
+  camera_frame_t *frame;
+
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  portENTER_CRITICAL(&mailbox_mux);
+  frame = stream_mailbox;
+  stream_mailbox = NULL;
+  portEXIT_CRITICAL(&mailbox_mux);
+  return frame;
+}
+
+void camera_svc_apply_perf_config(const perf_config_t &cfg) {
+  portENTER_CRITICAL(&perf_mux);
+  pending_perf = cfg;
+  perf_pending = true;
+  perf_seq++;
+  portEXIT_CRITICAL(&perf_mux);
+}
+
+bool camera_svc_merge_perf_config(ArduinoJson::JsonVariantConst json) {
+  perf_config_t cfg;
+  uint32_t seq;
+  bool merged = false;
+
+  // Parsed outside of the critical section, and done again if
+  // another profile was requested in the meantime
+  while (!merged) {
+    portENTER_CRITICAL(&perf_mux);
+    cfg = perf_pending ? pending_perf : perfConfig;
+    seq = perf_seq;
+    portEXIT_CRITICAL(&perf_mux);
+
+    if (!perf_config_from_json(json, cfg)) return false;
+
+    portENTER_CRITICAL(&perf_mux);
+    if (seq == perf_seq) {
+      pending_perf = cfg;
+      perf_pending = true;
+      perf_seq++;
+      merged = true;
+    }
+    portEXIT_CRITICAL(&perf_mux);
+  }
+  return true;
+}
+
 void camera_svc_start() {
   Serial.println("Starting Camera...");
 
@@ -142,11 +346,18 @@ void camera_svc_start() {
   }
   SD_MMC.mkdir(CAMERA_FB_ROOT);
 
-  // Queues hold pointers to camera_frame_t
-  CameraFBSaveQ = xQueueCreate(CAMERA_FB_SAVE_SZ, sizeof(camera_frame_t *));
-  CameraFBHTTPQ =
-      xQueueCreate(CAMERA_FB_SAVE_SZ / CONFIG_CAMERA_STREAM_FRAME_DOWNSCALE,
-                   sizeof(camera_frame_t *));
+  if (!frame_index_init(CAMERA_FB_MAX_SLOTS)) {
+    Serial.println("Failed to allocate frame index");
+    return;
+  }
+
+  event_outbox_start();
+  archive_start();
+  event_preview_start();
+
+  // Queue holds pointers to camera_frame_t
+  CameraFBSaveQ =
+      xQueueCreate(perfConfig.save_queue_depth, sizeof(camera_frame_t *));
 
   camera_config_t config;
   config.ledc_channel = LEDC_CHANNEL_0;
@@ -216,9 +427,10 @@ void camera_svc_start() {
     s->set_brightness(s, 1);
     s->set_saturation(s, -2);
   }
-  // drop down frame size for higher initial frame rate
+  // Run at the idle profile until an event comes in
+  camera_max_framesize = config.frame_size;
   if (config.pixel_format == PIXFORMAT_JPEG) {
-    s->set_framesize(s, FRAMESIZE_QVGA);
+    camera_set_profile(false);
   }
 
 #if defined(CAMERA_MODEL_M5STACK_WIDE) || defined(CAMERA_MODEL_M5STACK_ESP32CAM)
@@ -246,79 +458,76 @@ void camera_svc_start() {
 
 void camera_svc_task(void *pvParameters) {
   camera_fb_t *fb = NULL;
-  int prev_time_index;
   int time_index;
   int frame_index = 0;
+  uint32_t epoch;
+  uint16_t ms;
 
   camera_frame_t *frame_ptr = NULL;
+  bool first_frame = true;
+  bool close_pending = false;
 
   TickType_t prevTick = xTaskGetTickCount();
-  prev_time_index = timeClient.getEpochTime() % (CAMERA_FB_SECOND_RANGE * 2);
-  record_start_time = -1;
+  capture_stage.reset(ring_size());
+  record_end_time = 0;
   for (;;) {
+    // Only change pacing and buffer layout in between events
+    if (perf_pending && camera_state == CAM_STATE::NORMAL) {
+      perf_config_commit();
+      camera_set_profile(false);
+      prevTick = xTaskGetTickCount();
+      capture_stage.reset(ring_size());
+      frame_index = 0;
+    }
+
     // Upate folder to write to based on the current time
-    time_index = timeClient.getEpochTime() % (CAMERA_FB_SECOND_RANGE * 2);
-    if (prev_time_index != time_index) {
-      prev_time_index = time_index;
+    if (capture_stage.tick(ring_size())) {
       frame_index = 0;
       // Icrement the number of seconds which have passed
       // since the previous upload
       global_second_counter++;
     }
+    epoch = capture_stage.epoch();
+    time_index = capture_stage.slot();
 
-    if (record_start_time != -1) {
-      // Handle wrap around times
-      int dt = (time_index - record_start_time + (CAMERA_FB_SECOND_RANGE * 2)) %
-               (CAMERA_FB_SECOND_RANGE * 2);
-
-      if (dt > CAMERA_FB_SECOND_RANGE) {
-        camera_state = CAM_STATE::UPLOADING;
-
-        // Calculate the number
-        int size = 2 * CAMERA_FB_SECOND_RANGE;
-
-        int record_start_index =
-            ((record_start_time - CAMERA_FB_SECOND_RANGE) % size + size) % size;
-
-        int record_end_index =
-            ((record_start_time + CAMERA_FB_SECOND_RANGE - 1) % size + size) %
-            size;
-
-        // Wait for the save buffer to be emptied before uploading
-        while (uxQueueMessagesWaiting(CameraFBHTTPQ) != 0) {
-          portYIELD();
-        }
-        upload_frames(record_start_index, record_end_index);
+    if (camera_state == CAM_STATE::RECORDING && record_end_time == 0) {
+      open_event_window(epoch);
+      camera_set_profile(true);
+    }
 
-        // Reset globals
-        global_second_counter = 0;
-        camera_state = CAM_STATE::NORMAL;
-        record_start_time = -1;
-      }
+    // The last seconds are handed over to the outbox by the save
+    // task, once it reaches the first frame past the window
+    if (camera_state == CAM_STATE::RECORDING && epoch >= record_end_time) {
+      camera_state = CAM_STATE::UPLOADING;
+      close_pending = true;
+      camera_set_profile(false);
     }
 
-    fb = esp_camera_fb_get();
+    fb = capture_stage.capture(&ms);
     if (fb == NULL) {
-      Serial.println("Error capturing video buffer!");
+      LOG_E("Error capturing video buffer!");
     } else {
-      frame_ptr = frame_alloc(fb, time_index, frame_index++);
+      if (first_frame) {
+        first_frame = false;
+        LOG_I("Time to first frame: %lu ms", millis());
+      }
+
+      frame_ptr = frame_alloc(fb, epoch, ms, time_index, frame_index++);
       if (!frame_ptr) {
-        Serial.println("Failed to allocate frame wrapper; returning fb");
-        esp_camera_fb_return(fb);
+        LOG_E("Failed to allocate frame wrapper; returning fb");
+        capture_stage.release(fb);
       } else {
+        frame_ptr->closes_event = close_pending;
         if (xQueueSend(CameraFBSaveQ, &frame_ptr, 0) != pdPASS) {
-          Serial.println("Frame dropped when passing it to save routine...");
+          LOG_W("Frame dropped when passing it to save routine...");
           frame_release(frame_ptr);
+        } else {
+          close_pending = false;
         }
       }
     }
 
-    if (camera_state == CAM_STATE::RECORDING && record_start_time == -1) {
-      Serial.println("Begining Capture...");
-      record_start_time = time_index;
-    }
-
-    vTaskDelayUntil(&prevTick, pdMS_TO_TICKS(1000 / CONFIG_CAMERA_FRAME_RATE));
+    vTaskDelayUntil(&prevTick, pdMS_TO_TICKS(1000 / perfConfig.frame_rate));
   }
 }
 
@@ -327,24 +536,33 @@ void camera_svc_save_task(void *pvParameters) {
   int frame_count = 0;
 
   for (;;) {
-    if (xQueueReceive(CameraFBSaveQ, &frame_ptr, portMAX_DELAY) == pdPASS) {
+    if (frame_queue_receive(&CameraFBSaveQ, &frame_ptr)) {
       if (!frame_ptr) continue;
 
-      save_fb_to_sd(frame_ptr->fb, frame_ptr->time_index,
-                    frame_ptr->frame_index);
+      // Seconds of the window go out while it is still open, as
+      // soon as the save task moves past them
+      if (frame_ptr->closes_event) {
+        close_event_window();
+      } else if (record_end_time) {
+        hand_over_seconds(frame_ptr->epoch);
+      }
+
+      if (frame_ptr->fb) {
+        camera_fb_t roi_fb;
+        const camera_fb_t *fb = frame_ptr->fb;
+        if (perfConfig.roi_stages & JPEG_ROI_SAVE) {
+          fb = save_crop.apply(fb, &roi_fb);
+        }
+        save_stage.save(frame_ptr->time_index, frame_ptr->epoch,
+                        frame_ptr->frame_index, frame_ptr->ms, fb);
+      }
       frame_count++;
 
       // Only send some frames to HTTP Task (since it is slower)
-      if (frame_count >=
-          (CONFIG_CAMERA_FRAME_RATE / CONFIG_CAMERA_STREAM_FRAME_DOWNSCALE)) {
+      if (frame_count >= max(1, perfConfig.frame_rate /
+                                    perfConfig.stream_downscale)) {
         frame_count = 0;
-        frame_ref(frame_ptr);
-        if (xQueueSend(CameraFBHTTPQ, &frame_ptr, 0) != pdPASS) {
-          Serial.println(
-              "Frame dropped when passing it to http routine... undoing ref");
-          frame_release(frame_ptr);
-        }
-        frame_release(frame_ptr);
+        stream_mailbox_post(frame_ptr);
       } else {
         frame_release(frame_ptr);
       }
@@ -356,38 +574,78 @@ void camera_svc_save_task(void *pvParameters) {
 void camera_svc_http_task(void *pvParameters) {
   static char url_buf[256];
   camera_frame_t *frame_ptr = NULL;
-  String url;
-  int resp;
 
   // Create url to use for API call
+  // Coordinator address is known from the config, the network does not
+  // need to be up yet
   memset(url_buf, 0, sizeof(url_buf));
   snprintf(url_buf, sizeof(url_buf), "http://%s:%d/api/device/stream?device=%s",
            coordinatorIP.toString().c_str(), coordinatorPort,
            deviceName.c_str());
-  url = url_buf;
+  http_stream.transport().begin(url_buf);
 
   for (;;) {
-    if (xQueueReceive(CameraFBHTTPQ, &frame_ptr, portMAX_DELAY) == pdPASS) {
-      if (!frame_ptr) continue;
-
-      camera_fb_t *fb = frame_ptr->fb;
-
-      http.begin(url);
-      http.addHeader("Content-Type", "image/jpeg");
+    if ((frame_ptr = stream_mailbox_take()) != NULL) {
+      // Nowhere to stream to yet, frames are still saved to SD
+      if (!networkOnline) {
+        frame_release(frame_ptr);
+        continue;
+      }
 
-      http.setTimeout(CONFIG_HTTP_UPLOAD_TIMEOUT_MS);
+      // Full frames carry their capture second and number, so that
+      // event uploads can refer to them instead of sending them again
+      const uint32_t epoch = frame_ptr->epoch;
+      const int time_index = frame_ptr->time_index;
+      const int frame_index = frame_ptr->frame_index;
+
+      camera_fb_t roi_fb;
+      const camera_fb_t *fb = frame_ptr->fb;
+      const int roi_stages = perfConfig.roi_stages;
+      if (roi_stages & JPEG_ROI_STREAM) {
+        fb = stream_crop.apply(fb, &roi_fb);
+      }
 
-      resp = http.PUT(fb->buf, fb->len);
+      const int preview_scale = perfConfig.stream_preview_scale;
+      uint8_t *send_buf = fb->buf;
+      size_t send_len = fb->len;
+      uint8_t *preview_buf = NULL;
+      size_t preview_len = 0;
+
+      if (preview_scale > 1) {
+        if (transcode_preview(fb, preview_scale, &preview_buf,
+                              &preview_len)) {
+          send_buf = preview_buf;
+          send_len = preview_len;
+          // Full frame is no longer needed, give it back early
+          frame_release(frame_ptr);
+          frame_ptr = NULL;
+        } else {
+          LOG_W("Preview transcode failed, sending full frame");
+        }
+      }
 
-      // Dont bother printing timeout errors
-      if ((resp != HTTP_CODE_NO_CONTENT) &&
-          (resp != HTTPC_ERROR_READ_TIMEOUT)) {
-        String err = http.errorToString(resp);
-        Serial.printf("HTTP error: %s (%d)\n", err.c_str(), resp);
+      // Frames cropped differently from the stored ones cannot
+      // stand in for them either
+      const bool same_roi =
+          !(roi_stages & JPEG_ROI_STREAM) == !(roi_stages & JPEG_ROI_SAVE);
+      const int frame_number = frame_ptr && same_roi ? frame_index : -1;
+      bool kept;
+      if (perfConfig.stream_transport == STREAM_TRANSPORT_UDP) {
+        // Never spend more than one stream frame interval on a frame
+        uint32_t interval_ms =
+            1000 * max(1, perfConfig.frame_rate / perfConfig.stream_downscale) /
+            perfConfig.frame_rate;
+        udp_stream.send(send_buf, send_len, epoch, frame_number, interval_ms,
+                        &kept);
+      } else {
+        http_stream.send(send_buf, send_len, epoch, frame_number, 0, &kept);
       }
 
-      http.end();
+      if (kept) {
+        frame_index_mark_streamed(time_index, epoch, frame_index);
+      }
 
+      if (preview_buf) free(preview_buf);
       frame_release(frame_ptr);
     }
   }
@@ -399,184 +657,246 @@ void camera_svc_event_task(void *pvParameters) {
     // Wait until notified
     event_timestamp = ulTaskNotifyTake(pdPASS, portMAX_DELAY);
     if (camera_state != CAM_STATE::NORMAL) {
-      Serial.println("Camera is already busy. Blocking...");
+      LOG_W("Camera is already busy. Blocking...");
       continue;
     }
     // Only start recording if the entire frame buffer in SD
     // has been reset
-    if (global_second_counter < CAMERA_FB_SECOND_RANGE) {
-      Serial.print("Not enough time has passed since previous upload ");
-      Serial.printf("(Time passed: %ds)", global_second_counter);
-      Serial.println();
+    if (global_second_counter < perfConfig.pre_event_seconds) {
+      LOG_W("Not enough time has passed since previous upload "
+            "(Time passed: %ds)",
+            global_second_counter);
       continue;
     }
     // Start recording
     timestamp = event_timestamp;
-    Serial.printf("Got timestamp of event: %lu", timestamp);
-    Serial.println();
+    LOG_I("Got timestamp of event: %lu", timestamp);
     camera_state = CAM_STATE::RECORDING;
+    // Something to look at long before the window closes
+    event_preview_notify(timestamp);
   }
 }
 
-static void _ensure_empty_dir(const char *path) {
-  if (!SD_MMC.exists(path)) {
-    SD_MMC.mkdir(path);
-    return;
-  }
-
-  File dir = SD_MMC.open(path);
-  if (!dir || !dir.isDirectory()) {
-    Serial.printf("Failed to open existing directory: %s\n", path);
-    return;
+/**
+ * @brief Hand the seconds of the window which are complete over to
+ * the outbox, which uploads them right away
+ * @param epoch Capture second of the frame about to be saved, every
+ * second before it has been written
+ * @note Runs in the save task, no other task writes to the ring buffer
+ */
+static void hand_over_seconds(uint32_t epoch) {
+  const int size = ring_size();
+  const uint32_t until = min(epoch, record_end_time);
+
+  // The pre-event seconds are complete as soon as the event fires
+  if (handed_until == 0) {
+    handed_until = record_anchor_time - perfConfig.pre_event_seconds;
+    event_open = event_outbox_open(timestamp);
+    if (!event_open) {
+      LOG_W("Failed to store event, video not uploaded");
+    }
   }
 
-  File entry;
-  while ((entry = dir.openNextFile())) {
-    String entryPath = String(path) + "/" + entry.name();
-    if (entry.isDirectory()) {
-      SD_MMC.rmdir(entryPath.c_str());
-    } else {
-      SD_MMC.remove(entryPath.c_str());
-    }
-    entry.close();
+  // Only take slots whose frames were captured inside the window.
+  // Others were either never written or hold older footage
+  for (; handed_until < until; handed_until++) {
+    int slot = handed_until % size;
+    if (!event_open || frame_index_epoch(slot) != handed_until) continue;
+    event_outbox_append(slot);
+    frame_index_clear_slot(slot);
   }
-  dir.close();
 }
 
-static void save_fb_to_sd(const camera_fb_t *fb, int time_index,
-                          int frame_index) {
-  if (!fb) return;
-
-  char dir_path[64];
-  snprintf(dir_path, sizeof(dir_path), "%s/%d", CAMERA_FB_ROOT, time_index);
-
-  static int last_time_index = -1;
-  if (time_index != last_time_index) {
-    _ensure_empty_dir(dir_path);
-    last_time_index = time_index;
+/**
+ * @brief Hand the rest of the window over to the outbox and
+ * return to normal operation
+ * @note Runs in the save task so that no frame of the
+ * window can still be waiting to be written
+ */
+static void close_event_window() {
+  hand_over_seconds(record_end_time);
+  if (event_open) {
+    event_outbox_seal();
   }
+  handed_until = 0;
+  event_open = false;
 
-  char file_path[96];
-  snprintf(file_path, sizeof(file_path), "%s/%d.jpg", dir_path, frame_index);
+  // Reset globals
+  global_second_counter = 0;
+  record_end_time = 0;
+  camera_state = CAM_STATE::NORMAL;
+}
 
-  File file = SD_MMC.open(file_path, FILE_WRITE);
-  if (!file) {
-    Serial.printf("Failed to open file for writing: %s\n", file_path);
-    return;
+/**
+ * @brief Place the event window around the event timestamp
+ * @note Falls back to the camera clock when the timestamp would put
+ * the window entirely outside of what the ring buffer can hold
+ */
+static void open_event_window(uint32_t now) {
+  const uint32_t pre = perfConfig.pre_event_seconds;
+  const uint32_t post = perfConfig.post_event_seconds;
+  const uint32_t size = ring_size();
+
+  record_anchor_time = timestamp;
+  if (timestamp > now + post || timestamp + post + size <= now ||
+      timestamp < pre) {
+    LOG_W("Event time %lu is too far from camera time %lu", timestamp, now);
+    record_anchor_time = now;
   }
+  record_end_time = record_anchor_time + post;
 
-  file.write(fb->buf, fb->len);
-  file.close();
+  LOG_I("Begining Capture of [%lu, %lu)...", record_anchor_time - pre,
+        record_end_time);
 }
 
-static void upload_frames(int start_index, int end_index) {
-  int major = start_index;
-  int minor = 0;
-  static char url_buf[256];
-  static char path[128];
-  String url;
-  int resp;
-  bool first_frame = true;
+static int ring_size() {
+  return perfConfig.pre_event_seconds + perfConfig.post_event_seconds +
+         CAMERA_FB_RING_SLACK;
+}
 
-  // Create url to use for API call
-  memset(url_buf, 0, sizeof(url_buf));
-  snprintf(url_buf, sizeof(url_buf), "http://%s:%d/api/device/upload?device=%s",
-           coordinatorIP.toString().c_str(), coordinatorPort,
-           deviceName.c_str());
-  url = url_buf;
+int camera_svc_ring_size() { return ring_size(); }
 
-  Serial.printf("Sending Frames from %d to %d", start_index, end_index);
-  Serial.println();
+/**
+ * @brief Switch the sensor to the idle or event capture profile
+ * @note Frames captured while the sensor settles are thrown away.
+ * Later stages never assume a fixed frame size, so a window can
+ * hold frames of both profiles
+ */
+static void camera_set_profile(bool event) {
+  sensor_t *s = esp_camera_sensor_get();
+  if (!s) return;
 
-  for (;; major = (major + 1) % (2 * CAMERA_FB_SECOND_RANGE)) {
-    Serial.printf("Uploading second %d ", major);
+  framesize_t size = (framesize_t)(event ? perfConfig.event_framesize
+                                         : perfConfig.idle_framesize);
+  int quality = event ? perfConfig.event_quality : perfConfig.idle_quality;
+  if (size > camera_max_framesize) size = camera_max_framesize;
 
-    // iterate frames inside directory "major"
-    for (minor = 0;; minor++) {
-      snprintf(path, sizeof(path), "%s/%d/%d.jpg", CAMERA_FB_ROOT, major,
-               minor);
+  if (s->status.framesize == size && s->status.quality == quality) {
+    return;
+  }
+  s->set_framesize(s, size);
+  s->set_quality(s, quality);
 
-      // Since each "major" (second) might vary in the number
-      // of frames it contains, exit the moment a file does
-      // not exist
-      if (!SD_MMC.exists(path)) {
-        break;
-      }
+  for (int i = 0; i < CAMERA_PROFILE_SETTLE_FRAMES; i++) {
+    camera_fb_t *fb = esp_camera_fb_get();
+    if (fb) esp_camera_fb_return(fb);
+  }
+  LOG_I("Switched to %s capture profile (%ux%u, quality %d)",
+        event ? "event" : "idle", resolution[size].width,
+        resolution[size].height, quality);
+}
 
-      // Main upload loop for a single frame
-      // Read contents from file before entring
-      // retry loop
-      bool frame_uploaded = false;
-      int attempt = 0;
-      fs::File file = SD_MMC.open(path, "r");
-      size_t rd_size = file.size();
-      uint8_t *rd_buf = (uint8_t *)pvPortMalloc(rd_size);
-      file.read(rd_buf, rd_size);
-      while (!frame_uploaded && attempt < MAX_FRAME_RETRIES) {
-        attempt++;
-
-        // Prepare and send HTTP request
-        http.begin(url);
-        http.addHeader("Content-Type", "image/jpeg");
-        http.addHeader("Event-Timestamp", String(timestamp));
-        http.addHeader("First-Frame", first_frame ? "true" : "false");
-        http.addHeader("Upload-Complete", "false");
-        http.setTimeout(CONFIG_HTTP_UPLOAD_TIMEOUT_MS);
-
-        resp = http.sendRequest("POST", rd_buf, rd_size);
-
-        // Clean up resources used for this attempt
-        http.end();
-
-        if (resp == HTTP_CODE_NO_CONTENT) {
-          frame_uploaded = true;
-          if (first_frame) first_frame = false;
-        } else {
-          Serial.printf("(Retry Frame %d) ", minor);
-          vTaskDelay(pdMS_TO_TICKS(BASE_BACKOFF_MS * attempt));
-        }
-      }
-      file.close();
-      vPortFree(rd_buf);
+/**
+ * @brief Make the pending performance profile the active one
+ * @note Called from the camera task, which sends to the save
+ * queue and owns the ring buffer layout
+ */
+static void perf_config_commit() {
+  perf_config_t cfg;
+  portENTER_CRITICAL(&perf_mux);
+  cfg = pending_perf;
+  perf_pending = false;
+  portEXIT_CRITICAL(&perf_mux);
+
+  bool resize_save = cfg.save_queue_depth != perfConfig.save_queue_depth;
+  bool reset_ring = cfg.pre_event_seconds != perfConfig.pre_event_seconds ||
+                    cfg.post_event_seconds != perfConfig.post_event_seconds;
+
+  portENTER_CRITICAL(&perf_mux);
+  perfConfig = cfg;
+  portEXIT_CRITICAL(&perf_mux);
+
+  if (resize_save && !frame_queue_resize(&CameraFBSaveQ,
+                                         cfg.save_queue_depth)) {
+    LOG_E("Failed to resize save queue");
+  }
+  // Ring buffer slots no longer line up with the new window,
+  // wait for it to be refilled before accepting an event
+  if (reset_ring) {
+    global_second_counter = 0;
+  }
 
-      if (!frame_uploaded) {
-        Serial.printf("(Skipping frame %d) ", minor);
-      }
-    }
+  LOG_I(
+      "Applied performance profile: %d fps, stream 1/%d (preview 1/%d), "
+      "timeout %d ms, window -%d/+%d s, save queue %d",
+      cfg.frame_rate, cfg.stream_downscale, cfg.stream_preview_scale,
+      cfg.upload_timeout_ms, cfg.pre_event_seconds, cfg.post_event_seconds,
+      cfg.save_queue_depth);
+}
 
-    Serial.println();
-    // Exit once after last index was read
-    if (major == end_index) {
-      break;
-    }
+static jpg_scale_t preview_jpg_scale(int scale) {
+  switch (scale) {
+    case 2:
+      return JPG_SCALE_2X;
+    case 4:
+      return JPG_SCALE_4X;
+    case 8:
+      return JPG_SCALE_8X;
+    default:
+      return JPG_SCALE_NONE;
   }
+}
 
-  // Send final upload complete flag
-  Serial.print("Completed Sending Frames. Sending indicator");
-  int attempt = 0;
-  do {
-    http.begin(url);
-    http.addHeader("Content-Type", "image/jpeg");
-    http.addHeader("Event-Timestamp", String(timestamp));
-    http.addHeader("Upload-Complete", "true");
-    http.addHeader("First-Frame", "false");
-    http.setTimeout(CONFIG_HTTP_UPLOAD_TIMEOUT_MS);
-    resp = http.POST((uint8_t *)"", 0);
-    http.end();
-    attempt++;
-
-    if (resp != HTTP_CODE_NO_CONTENT) {
-      Serial.print(".");
-      vTaskDelay(pdMS_TO_TICKS(BASE_BACKOFF_MS * attempt));
-    } else {
-      break;
-    }
-  } while (resp != HTTP_CODE_NO_CONTENT && attempt <= MAX_FRAME_RETRIES);
+/**
+ * @brief Re-encode a frame at 1/`scale` of its resolution
+ * @note On success `out` holds a newly allocated JPEG which must
+ * be released with `free()`. The cost of each call is accumulated
+ * and periodically printed
+ */
+static bool transcode_preview(const camera_fb_t *fb, int scale, uint8_t **out,
+                              size_t *out_len) {
+  // RGB565 scratch buffer, kept between frames to avoid
+  // reallocating it for every streamed frame
+  static uint8_t *rgb_buf = NULL;
+  static size_t rgb_buf_sz = 0;
+
+  static uint32_t stat_frames = 0;
+  static uint64_t stat_us_total = 0;
+  static uint32_t stat_us_max = 0;
+  static uint64_t stat_bytes_in = 0;
+  static uint64_t stat_bytes_out = 0;
+
+  if (!fb || fb->format != PIXFORMAT_JPEG) return false;
+
+  int64_t t_start = esp_timer_get_time();
+
+  uint16_t width = fb->width / scale;
+  uint16_t height = fb->height / scale;
+  size_t rgb_len = (size_t)width * height * 2;
+
+  if (rgb_len > rgb_buf_sz) {
+    free(rgb_buf);
+    rgb_buf = (uint8_t *)ps_malloc(rgb_len);
+    if (!rgb_buf) rgb_buf = (uint8_t *)malloc(rgb_len);
+    rgb_buf_sz = rgb_buf ? rgb_len : 0;
+    if (!rgb_buf) return false;
+  }
 
-  Serial.println();
-  if (attempt > MAX_FRAME_RETRIES) {
-    Serial.println("Failed to indicate upload end. Video not uploaded");
-  } else {
-    Serial.println("Complete video buffer sent!");
+  if (!jpg2rgb565(fb->buf, fb->len, rgb_buf, preview_jpg_scale(scale))) {
+    return false;
+  }
+  if (!fmt2jpg(rgb_buf, rgb_len, width, height, PIXFORMAT_RGB565,
+               CONFIG_CAMERA_STREAM_PREVIEW_QUALITY, out, out_len)) {
+    return false;
+  }
+
+  uint32_t elapsed = (uint32_t)(esp_timer_get_time() - t_start);
+  stat_frames++;
+  stat_us_total += elapsed;
+  stat_bytes_in += fb->len;
+  stat_bytes_out += *out_len;
+  if (elapsed > stat_us_max) stat_us_max = elapsed;
+
+  if (stat_frames >= PREVIEW_STATS_INTERVAL) {
+    LOG_I(
+        "Preview 1/%d: %lu frames, avg %lu us, max %lu us, %u%% of bytes",
+        scale, stat_frames, (uint32_t)(stat_us_total / stat_frames),
+        stat_us_max, (unsigned)(stat_bytes_out * 100 / stat_bytes_in));
+    stat_frames = 0;
+    stat_us_total = 0;
+    stat_us_max = 0;
+    stat_bytes_in = 0;
+    stat_bytes_out = 0;
   }
+  return true;
 }
@@ -2,11 +2,16 @@
 #include <ArduinoJson.h>
 #include <FS.h>
 
+#include "app_config.h"
+#include "coordinator_pool.h"
+#include "esp_camera.h"
+#include "jpeg_crop.h"
 #include "main.h"
+#include "perf_config.h"
 
 // === Macros ===
 
-#define JSON_MAX_SIZE 1024
+#define JSON_MAX_SIZE (CONFIG_JSON_MAX_SIZE)
 
 // === Externally Defined Variables ===
 
@@ -19,9 +24,37 @@ uint16_t brokerPort;
 IPAddress coordinatorIP;
 uint16_t coordinatorPort;
 
+perf_config_t perfConfig = {
+    CONFIG_CAMERA_FRAME_RATE,
+    CONFIG_CAMERA_STREAM_FRAME_DOWNSCALE,
+    CONFIG_CAMERA_STREAM_PREVIEW_SCALE,
+    CONFIG_HTTP_UPLOAD_TIMEOUT_MS,
+    CONFIG_EVENT_PRE_SECONDS,
+    CONFIG_EVENT_POST_SECONDS,
+    CONFIG_CAMERA_SAVE_QUEUE_DEPTH,
+    CONFIG_STATIC_SCENE_THRESHOLD,
+    CONFIG_LINK_STREAM_POLICY,
+    CONFIG_LINK_STREAM_MIN_FPS,
+    CONFIG_LINK_BUDGET_KBPS,
+    CONFIG_STREAM_TRANSPORT,
+    CONFIG_CAMERA_IDLE_FRAMESIZE,
+    CONFIG_CAMERA_IDLE_QUALITY,
+    CONFIG_CAMERA_EVENT_FRAMESIZE,
+    CONFIG_CAMERA_EVENT_QUALITY,
+    CONFIG_ROI_LEFT,
+    CONFIG_ROI_TOP,
+    CONFIG_ROI_WIDTH,
+    CONFIG_ROI_HEIGHT,
+    CONFIG_ROI_STAGES,
+};
+
 // === Function Declarations ===
 
 bool load_device_configs(fs::FS &fs);
+static bool _read_int(ArduinoJson::JsonVariantConst json, const char *key,
+                      int min, int max, int &out);
+static bool _read_coordinators(ArduinoJson::JsonVariantConst json);
+static bool _read_coordinator(ArduinoJson::JsonVariantConst json);
 
 bool load_device_configs(fs::FS &fs) {
   ArduinoJson::JsonDocument json;
@@ -44,8 +77,7 @@ bool load_device_configs(fs::FS &fs) {
       !json["DeviceName"].is<const char *>() ||
       !json["MQTT"]["IP"].is<const char *>() ||
       !json["MQTT"]["Port"].is<uint16_t>() ||
-      !json["HTTP"]["IP"].is<const char *>() ||
-      !json["HTTP"]["Port"].is<uint16_t>()) {
+      !_read_coordinators(json["HTTP"])) {
     return false;
   }
 
@@ -57,8 +89,120 @@ bool load_device_configs(fs::FS &fs) {
   brokerIP.fromString((json["MQTT"]["IP"].as<const char *>()));
   brokerPort = json["MQTT"]["Port"].as<uint16_t>();
 
-  coordinatorIP.fromString((json["HTTP"]["IP"].as<const char *>()));
-  coordinatorPort = json["HTTP"]["Port"].as<uint16_t>();
+  // Optional section, defaults from app_config.h are kept otherwise
+  if (!json["Performance"].isNull() &&
+      !perf_config_from_json(json["Performance"], perfConfig)) {
+    return false;
+  }
+
+  return true;
+}
+
+bool perf_config_from_json(ArduinoJson::JsonVariantConst json,
+                           perf_config_t &cfg) {
+  perf_config_t tmp = cfg;
+
+  if (!json.is<ArduinoJson::JsonObjectConst>()) {
+    return false;
+  }
+
+  if (!_read_int(json, "FrameRate", 1, 30, tmp.frame_rate) ||
+      !_read_int(json, "StreamDownscale", 1, 30, tmp.stream_downscale) ||
+      !_read_int(json, "StreamPreviewScale", 1, 8,
+                 tmp.stream_preview_scale) ||
+      !_read_int(json, "UploadTimeoutMs", 100, 30000,
+                 tmp.upload_timeout_ms) ||
+      !_read_int(json, "PreEventSeconds", 1, PERF_MAX_WINDOW_SECONDS,
+                 tmp.pre_event_seconds) ||
+      !_read_int(json, "PostEventSeconds", 1, PERF_MAX_WINDOW_SECONDS,
+                 tmp.post_event_seconds) ||
+      !_read_int(json, "SaveQueueDepth", 1, 64, tmp.save_queue_depth) ||
+      !_read_int(json, "StaticSceneThreshold", 0, 255,
+                 tmp.static_threshold) ||
+      !_read_int(json, "StreamPolicy", 0, 2, tmp.stream_policy) ||
+      !_read_int(json, "StreamMinFps", 0, 30, tmp.stream_min_fps) ||
+      !_read_int(json, "LinkBudgetKBps", 0, 10000, tmp.link_budget_kbps) ||
+      !_read_int(json, "StreamTransport", 0, 1, tmp.stream_transport) ||
+      !_read_int(json, "IdleFrameSize", 0, FRAMESIZE_UXGA,
+                 tmp.idle_framesize) ||
+      !_read_int(json, "IdleQuality", 0, 63, tmp.idle_quality) ||
+      !_read_int(json, "EventFrameSize", 0, FRAMESIZE_UXGA,
+                 tmp.event_framesize) ||
+      !_read_int(json, "EventQuality", 0, 63, tmp.event_quality) ||
+      !_read_int(json, "RoiLeft", 0, 99, tmp.roi_left) ||
+      !_read_int(json, "RoiTop", 0, 99, tmp.roi_top) ||
+      !_read_int(json, "RoiWidth", 1, 100, tmp.roi_width) ||
+      !_read_int(json, "RoiHeight", 1, 100, tmp.roi_height) ||
+      !_read_int(json, "RoiStages", 0, JPEG_ROI_STREAM | JPEG_ROI_SAVE,
+                 tmp.roi_stages)) {
+    return false;
+  }
+
+  if (tmp.roi_left + tmp.roi_width > 100 ||
+      tmp.roi_top + tmp.roi_height > 100) {
+    return false;
+  }
+
+  // jpg2rgb565 can only scale by powers of two
+  if (tmp.stream_preview_scale != 1 && tmp.stream_preview_scale != 2 &&
+      tmp.stream_preview_scale != 4 && tmp.stream_preview_scale != 8) {
+    return false;
+  }
+
+  cfg = tmp;
+  return true;
+}
+
+// Missing keys are not an error and leave `out` unchanged
+static bool _read_int(ArduinoJson::JsonVariantConst json, const char *key,
+                      int min, int max, int &out) {
+  ArduinoJson::JsonVariantConst value = json[key];
+  if (value.isNull()) {
+    return true;
+  }
+  if (!value.is<int>()) {
+    return false;
+  }
 
+  int v = value.as<int>();
+  if (v < min || v > max) {
+    return false;
+  }
+  out = v;
   return true;
-}
\ No newline at end of file
+}
+
+// A single {"IP", "Port"} object, or a list of them. The first
+// one is also used for registration and the live stream
+static bool _read_coordinators(ArduinoJson::JsonVariantConst json) {
+  if (!json.is<ArduinoJson::JsonArrayConst>()) {
+    return _read_coordinator(json);
+  }
+
+  ArduinoJson::JsonArrayConst list = json.as<ArduinoJson::JsonArrayConst>();
+  if (list.size() == 0 || list.size() > CONFIG_COORDINATOR_MAX) {
+    return false;
+  }
+  for (ArduinoJson::JsonVariantConst entry : list) {
+    if (!_read_coordinator(entry)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool _read_coordinator(ArduinoJson::JsonVariantConst json) {
+  IPAddress ip;
+
+  if (!json["IP"].is<const char *>() || !json["Port"].is<uint16_t>() ||
+      !ip.fromString(json["IP"].as<const char *>())) {
+    return false;
+  }
+
+  uint16_t port = json["Port"].as<uint16_t>();
+  if (coordinator_pool_size() == 0) {
+    coordinatorIP = ip;
+    coordinatorPort = port;
+  }
+  return coordinator_pool_add(ip, port);
+}
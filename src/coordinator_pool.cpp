@@ -0,0 +1,182 @@
+#include "coordinator_pool.h"
+
+#include <Arduino.h>
+
+#include "app_config.h"
+#include "log_ring.h"
+
+// === Types ===
+
+typedef struct {
+  IPAddress ip;
+  uint16_t port;
+  // Failed requests in a row
+  int fails;
+  // Times it went down without answering in between
+  int downs;
+  bool down;
+  uint32_t down_until_ms;
+  // Moving average of answered requests, 0 until the first one
+  uint32_t latency_ms;
+  uint32_t latency_at_ms;  // Time of the last answer
+} coordinator_t;
+
+// === Variables ===
+
+static portMUX_TYPE pool_mux = portMUX_INITIALIZER_UNLOCKED;
+static coordinator_t pool[CONFIG_COORDINATOR_MAX];
+static int pool_size = 0;
+
+// === Local Functions ===
+
+static uint32_t rendezvous_score(const String &key, const coordinator_t &c);
+static bool is_up(coordinator_t &c, uint32_t now);
+static uint32_t latency(const coordinator_t &c, uint32_t now);
+
+bool coordinator_pool_add(const IPAddress &ip, uint16_t port) {
+  if (pool_size >= CONFIG_COORDINATOR_MAX) return false;
+  pool[pool_size] = {ip, port, 0, 0, false, 0, 0, 0};
+  pool_size++;
+  return true;
+}
+
+int coordinator_pool_size() { return pool_size; }
+
+int coordinator_pick(const String &key, int exclude) {
+  uint32_t now = millis();
+  uint32_t best_score = 0, next_score = 0;
+  int best = -1, next = -1;
+  int soonest = -1;
+
+  portENTER_CRITICAL(&pool_mux);
+  for (int i = 0; i < pool_size; i++) {
+    if (i == exclude) continue;
+    if (!is_up(pool[i], now)) {
+      if (soonest < 0 || (int32_t)(pool[i].down_until_ms -
+                                   pool[soonest].down_until_ms) < 0) {
+        soonest = i;
+      }
+      continue;
+    }
+
+    uint32_t score = rendezvous_score(key, pool[i]);
+    if (best < 0 || score > best_score) {
+      next = best;
+      next_score = best_score;
+      best = i;
+      best_score = score;
+    } else if (next < 0 || score > next_score) {
+      next = i;
+      next_score = score;
+    }
+  }
+
+  // Only move away from the home coordinator when both have been
+  // measured, so a single slow answer does not send everyone away.
+  // Only the one in use is measured, the home coordinator gets
+  // another try once its latency is too old to count
+  uint32_t best_ms = best >= 0 ? latency(pool[best], now) : 0;
+  uint32_t next_ms = next >= 0 ? latency(pool[next], now) : 0;
+  if (best_ms && next_ms &&
+      best_ms > next_ms * CONFIG_COORDINATOR_LATENCY_RATIO) {
+    best = next;
+  }
+  portEXIT_CRITICAL(&pool_mux);
+
+  if (best < 0 && exclude < 0) return soonest;
+  return best;
+}
+
+void coordinator_report(int idx, bool ok, uint32_t elapsed_ms) {
+  bool went_down = false;
+  uint32_t down_ms = 0;
+
+  if (idx < 0 || idx >= pool_size) return;
+  coordinator_t &c = pool[idx];
+
+  portENTER_CRITICAL(&pool_mux);
+  if (ok) {
+    c.fails = 0;
+    c.downs = 0;
+    c.down = false;
+    // 1/4 of the new sample, the rest from the history
+    // Starts over once too old to count
+    c.latency_ms = latency(c, millis())
+                       ? (c.latency_ms * 3 + max<uint32_t>(elapsed_ms, 1)) / 4
+                       : max<uint32_t>(elapsed_ms, 1);
+    c.latency_at_ms = millis();
+  } else if (++c.fails >= CONFIG_COORDINATOR_FAIL_LIMIT) {
+    down_ms = min<uint32_t>(CONFIG_COORDINATOR_DOWN_MIN_MS << min(c.downs, 8),
+                            CONFIG_COORDINATOR_DOWN_MAX_MS);
+    c.down = true;
+    c.down_until_ms = millis() + down_ms;
+    c.downs++;
+    // Once back, a single failure takes it down again
+    c.fails = CONFIG_COORDINATOR_FAIL_LIMIT - 1;
+    went_down = true;
+  }
+  portEXIT_CRITICAL(&pool_mux);
+
+  if (went_down) {
+    LOG_W("Coordinator %s:%u down for %lu ms", c.ip.toString().c_str(),
+          c.port, down_ms);
+  }
+}
+
+bool coordinator_up(int idx) {
+  bool up;
+
+  if (idx < 0 || idx >= pool_size) return false;
+  portENTER_CRITICAL(&pool_mux);
+  up = is_up(pool[idx], millis());
+  portEXIT_CRITICAL(&pool_mux);
+  return up;
+}
+
+void coordinator_url(int idx, const char *path, char *buf, size_t len) {
+  if (idx < 0 || idx >= pool_size) {
+    buf[0] = '\0';
+    return;
+  }
+  snprintf(buf, len, "http://%s:%u%s", pool[idx].ip.toString().c_str(),
+           pool[idx].port, path);
+}
+
+// Hash of the key and the coordinator address (FNV-1a). The
+// coordinator with the highest score is the home of the key
+static uint32_t rendezvous_score(const String &key, const coordinator_t &c) {
+  uint32_t h = 2166136261u;
+  uint8_t addr[6] = {c.ip[0],
+                     c.ip[1],
+                     c.ip[2],
+                     c.ip[3],
+                     (uint8_t)(c.port >> 8),
+                     (uint8_t)c.port};
+
+  for (unsigned i = 0; i < key.length(); i++) {
+    h = (h ^ (uint8_t)key[i]) * 16777619u;
+  }
+  for (uint8_t b : addr) {
+    h = (h ^ b) * 16777619u;
+  }
+  // FNV leaves the last bytes poorly mixed
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  return h;
+}
+
+static bool is_up(coordinator_t &c, uint32_t now) {
+  if (c.down && (int32_t)(now - c.down_until_ms) >= 0) {
+    c.down = false;
+  }
+  return !c.down;
+}
+
+// Latency of `c`, 0 if unknown or too old to count
+static uint32_t latency(const coordinator_t &c, uint32_t now) {
+  if (now - c.latency_at_ms > CONFIG_COORDINATOR_LATENCY_MAX_AGE_MS) {
+    return 0;
+  }
+  return c.latency_ms;
+}
@@ -0,0 +1,1337 @@
+#include "event_outbox.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "app_config.h"
+#include "coordinator_pool.h"
+#include "frame_index.h"
+#include "jpeg_tables.h"
+#include "link_arbiter.h"
+#include "log_ring.h"
+#include "main.h"
+#include "perf_config.h"
+
+// === Local Defines ===
+
+#define MAX_FRAME_RETRIES (5)
+#define BASE_BACKOFF_MS (200)
+// Consecutive failures after which the coordinator is considered
+// unreachable and the event is kept for later
+#define MAX_CONSECUTIVE_FAILURES (8)
+// Upper bound on the frames listed in the missing frame report
+#define MAX_MISSING_REPORT (64)
+// Times in a row the coordinator may turn a request away before
+// the event is put back for later
+#define MAX_BUSY_RETRIES (10)
+#define OUTBOX_POLL_MS (5000)
+#define OUTBOX_QUOTA_BYTES ((uint64_t)CONFIG_OUTBOX_QUOTA_MB * 1024 * 1024)
+
+// === Types ===
+
+typedef struct {
+  uint32_t timestamp;
+  int seconds;
+  size_t bytes;
+} outbox_event_t;
+
+// A frame listed in the index of a stored event
+typedef struct {
+  uint16_t second;  // Directory inside the event
+  uint16_t frame;
+  uint32_t size;
+  uint32_t epoch;   // Capture second
+  bool streamed;    // Already sent over the live stream
+  uint8_t tables;   // JPEG table set to expand it with, 0 if stored in full
+  // Frame a repeat (size 0) stands for, the last one stored before it
+  uint16_t repeat_second;
+  uint16_t repeat_frame;
+} outbox_frame_t;
+
+// A frame which failed to upload and waits to be sent again
+typedef struct {
+  size_t frame;  // Position in the frames of the event
+  int attempts;
+  uint32_t due_ms;
+} outbox_retry_t;
+
+// === Variables ===
+
+// Stored events, oldest first
+static std::vector<outbox_event_t> events;
+static uint64_t events_bytes = 0;
+// Event currently being uploaded, protected from eviction
+static uint32_t uploading_timestamp = 0;
+static SemaphoreHandle_t events_mutex;
+// Held for the whole of `event_outbox_find`, which the footage
+// server, archive and preview tasks all share a cache through
+static SemaphoreHandle_t find_mutex;
+
+static HTTPClient outbox_http;
+// Bytes of the current event not sent again thanks to the live stream
+static uint32_t stream_ref_bytes = 0;
+// Coordinator the current event goes to, and its upload endpoint
+static int upload_node = -1;
+static String upload_url;
+// Set once the event moved away from a coordinator which went down
+static String upload_previous;
+static uint32_t request_start_ms = 0;
+// Admission token handed out by the coordinator for the current event
+static String upload_token;
+// Delay asked for by the last 429/503 response, 0 if none
+static uint32_t retry_after_ms = 0;
+// JPEG table sets of the current event, loaded when first needed
+static jpeg_tables_t *event_tables[JPEG_TABLES_MAX_SETS + 1];
+// Table sets the coordinator already got for the current event, by
+// bit. Set when it does not take table sets at all
+static uint32_t tables_sent = 0;
+static bool tables_refused = false;
+// Bytes of tables left out of the frames of the current event, and
+// sent as table sets instead
+static uint32_t tables_left_out = 0;
+static uint32_t tables_set_bytes = 0;
+
+// Event being built by `event_outbox_clip_*`. Its index lines are
+// kept in a file until the header can be written
+static struct {
+  uint32_t timestamp;
+  int seconds;
+  int frames;  // In the current second
+  size_t bytes;
+  File lines;
+} clip;
+
+// Event still being recorded (see `event_outbox_open`). Its index is
+// also kept in memory, where the upload picks up new seconds from
+static struct {
+  uint32_t timestamp;  // 0 when none is open
+  int seconds;
+  size_t bytes;
+  uint32_t tables_saved;
+  outbox_frame_t last_stored;  // For the repeats which follow it
+  std::vector<outbox_frame_t> frames;
+  File lines;
+} live;
+
+// Capture time of the newest second appended to an event
+static volatile uint32_t handed_until = 0;
+
+TaskHandle_t EventOutboxTask;
+
+// === Local Functions ===
+
+static void outbox_restore();
+static bool outbox_next(outbox_event_t &ev);
+static void outbox_remove(uint32_t timestamp);
+static void outbox_evict_for(size_t bytes);
+static bool outbox_read_index(const outbox_event_t &ev,
+                              std::vector<outbox_frame_t> &frames);
+static bool outbox_write_index(uint32_t timestamp, int seconds, size_t bytes,
+                               size_t lines_len = SIZE_MAX);
+static bool outbox_recover_index(uint32_t timestamp);
+static bool outbox_wait_frames(const outbox_event_t &ev,
+                               std::vector<outbox_frame_t> &frames);
+static bool upload_event(const outbox_event_t &ev);
+static int send_frame_failover(const outbox_event_t &ev,
+                               const outbox_frame_t &f, bool first_frame);
+static int send_frame(const String &url, const outbox_event_t &ev,
+                      const outbox_frame_t &f, bool first_frame);
+static bool send_upload_complete(const outbox_event_t &ev,
+                                 const String &missing);
+static void upload_set_node(int node);
+static bool upload_failover();
+static int send_table_set(const String &url, const outbox_event_t &ev, int k,
+                          const jpeg_tables_t &tables);
+static const jpeg_tables_t *outbox_tables(const outbox_event_t &ev, int k);
+static void outbox_free_tables();
+static void request_begin(const String &url, const outbox_event_t &ev,
+                          bool first_frame, bool complete);
+static void request_end(int resp);
+static bool coordinator_busy(int resp);
+static bool coordinator_failed(int resp);
+static bool wait_busy(int busy_count);
+static uint32_t retry_delay_ms(int attempt);
+static void _remove_dir_r(const char *path);
+
+void event_outbox_task(void *pvParameters);
+
+void event_outbox_start() {
+  events_mutex = xSemaphoreCreateMutex();
+  find_mutex = xSemaphoreCreateMutex();
+
+  if (!SD_MMC.exists(CAMERA_OUTBOX_ROOT)) {
+    SD_MMC.mkdir(CAMERA_OUTBOX_ROOT);
+  }
+  outbox_restore();
+
+  xTaskCreate(event_outbox_task, "EventOutboxTask", 8192, NULL, 4,
+              &EventOutboxTask);
+}
+
+bool event_outbox_open(uint32_t timestamp) {
+  char path[64];
+
+  snprintf(path, sizeof(path), "%s/%lu", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  if (SD_MMC.exists(path)) {
+    LOG_W("Event %lu is already stored", timestamp);
+    return false;
+  }
+  if (!SD_MMC.mkdir(path)) {
+    LOG_E("Failed to create %s", path);
+    return false;
+  }
+
+  snprintf(path, sizeof(path), "%s/%lu/lines", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  File lines = SD_MMC.open(path, FILE_WRITE);
+  if (!lines) {
+    LOG_E("Failed to create %s", path);
+    *strrchr(path, '/') = '\0';
+    _remove_dir_r(path);
+    return false;
+  }
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  live.timestamp = timestamp;
+  live.seconds = 0;
+  live.bytes = 0;
+  live.tables_saved = 0;
+  live.last_stored = {};
+  live.frames.clear();
+  live.lines = lines;
+  events.push_back({timestamp, 0, 0});
+  std::sort(events.begin(), events.end(),
+            [](const outbox_event_t &a, const outbox_event_t &b) {
+              return a.timestamp < b.timestamp;
+            });
+  xSemaphoreGive(events_mutex);
+
+  LOG_I("Opened event %lu", timestamp);
+  xTaskNotifyGive(EventOutboxTask);
+  return true;
+}
+
+bool event_outbox_append(int slot) {
+  static frame_index_slot_t info;
+  std::vector<outbox_frame_t> added;
+  char from[64];
+  char to[64];
+
+  if (live.timestamp == 0) return false;
+  if (!frame_index_get(slot, &info)) {
+    info.count = 0;
+    info.bytes = 0;
+  }
+
+  outbox_evict_for(info.bytes);
+
+  // Renaming pins the frames, the ring buffer recreates
+  // the slot directory as it reaches it again
+  const int second = live.seconds;
+  snprintf(from, sizeof(from), "%s/%d", CAMERA_FB_ROOT, slot);
+  snprintf(to, sizeof(to), "%s/%lu/%d", CAMERA_OUTBOX_ROOT,
+           (unsigned long)live.timestamp, second);
+  if (!SD_MMC.exists(from) || !SD_MMC.rename(from, to)) {
+    SD_MMC.mkdir(to);
+  }
+
+  // Index of the event. The first line holds the number of seconds
+  // and total size, then one line per second (starting with its
+  // capture time) listing its valid frames as <frame>:<size>.
+  // Repeated frames have a size of 0, frames the coordinator
+  // already got over the live stream end with :s and abbreviated
+  // frames end with :t<set>, the set being stored as tables<set>.
+  // Lines are kept apart until the header is known
+  live.lines.printf("%lu", (unsigned long)info.epoch);
+  for (int n = 0; n < info.count; n++) {
+    const frame_index_entry_t &e = info.frames[n];
+    if (!e.valid) continue;
+    const bool streamed = e.streamed && e.size > 0;
+    live.lines.printf(" %d:%lu", n, (unsigned long)e.size);
+    if (streamed) live.lines.print(":s");
+    if (e.tables) live.lines.printf(":t%u", e.tables);
+    outbox_frame_t f = {(uint16_t)second, (uint16_t)n, (uint32_t)e.size,
+                        info.epoch, streamed, e.tables,
+                        live.last_stored.second, live.last_stored.frame};
+    if (f.size > 0) live.last_stored = f;
+    added.push_back(f);
+
+    // Table sets only live in memory, the event needs its own copy
+    if (e.tables && !(live.tables_saved & (1 << e.tables))) {
+      snprintf(to, sizeof(to), "%s/%lu/tables%d", CAMERA_OUTBOX_ROOT,
+               (unsigned long)live.timestamp, e.tables);
+      if (!jpeg_tables_save(jpeg_tables_get(e.tables), to)) {
+        LOG_E("Failed to save JPEG tables to %s", to);
+      }
+      live.tables_saved |= 1 << e.tables;
+    }
+  }
+  live.lines.print('\n');
+  live.lines.flush();
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  live.frames.insert(live.frames.end(), added.begin(), added.end());
+  live.seconds++;
+  live.bytes += info.bytes;
+  for (outbox_event_t &ev : events) {
+    if (ev.timestamp == live.timestamp) {
+      ev.seconds = live.seconds;
+      ev.bytes = live.bytes;
+    }
+  }
+  events_bytes += info.bytes;
+  xSemaphoreGive(events_mutex);
+
+  if (info.count > 0) handed_until = info.epoch;
+  xTaskNotifyGive(EventOutboxTask);
+  return true;
+}
+
+uint32_t event_outbox_handed_until() { return handed_until; }
+
+void event_outbox_seal() {
+  const uint32_t timestamp = live.timestamp;
+  if (timestamp == 0) return;
+
+  live.lines.close();
+  // The lines stay if this fails, and the index is written again
+  // from them after a reboot. The upload still sends what it has
+  if (!outbox_write_index(timestamp, live.seconds, live.bytes)) {
+    LOG_E("Failed to write the index of event %lu", timestamp);
+  }
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  live.timestamp = 0;
+  live.frames.clear();
+  live.frames.shrink_to_fit();
+  xSemaphoreGive(events_mutex);
+
+  LOG_I("Stored event %lu (%ds, %u bytes)", timestamp, live.seconds,
+        (unsigned)live.bytes);
+  xTaskNotifyGive(EventOutboxTask);
+}
+
+bool event_outbox_find(uint32_t epoch, char *dir, char *event_dir, size_t len,
+                       frame_index_slot_t *out) {
+  // Index of the last event looked up, lookups usually walk
+  // through the seconds of a single event
+  static outbox_event_t cached = {0, 0, 0};
+  static std::vector<outbox_frame_t> cached_frames;
+  std::vector<outbox_event_t> candidates;
+  bool found = false;
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  for (const outbox_event_t &ev : events) {
+    // Windows never reach further than this from the event time
+    uint32_t reach = PERF_MAX_WINDOW_SECONDS * 2;
+    if (epoch + reach >= ev.timestamp && epoch <= ev.timestamp + reach) {
+      candidates.push_back(ev);
+    }
+  }
+  xSemaphoreGive(events_mutex);
+
+  xSemaphoreTake(find_mutex, portMAX_DELAY);
+  for (const outbox_event_t &ev : candidates) {
+    // Events still being recorded grow one second at a time
+    if (ev.timestamp != cached.timestamp || ev.seconds != cached.seconds) {
+      cached_frames.clear();
+      cached = {0, 0, 0};
+      if (!outbox_read_index(ev, cached_frames)) continue;
+      cached = ev;
+    }
+
+    int second = -1;
+    out->epoch = epoch;
+    out->bytes = 0;
+    out->count = 0;
+    for (const outbox_frame_t &f : cached_frames) {
+      if (f.epoch != epoch || f.frame >= FRAME_INDEX_MAX_FRAMES) continue;
+      second = f.second;
+      while (out->count < f.frame) {
+        out->frames[out->count++] = {0, 0, false, false, false, 0};
+      }
+      out->frames[f.frame] = {f.size, 0, true, f.size == 0, f.streamed,
+                              f.tables};
+      if (out->count <= f.frame) out->count = f.frame + 1;
+      out->bytes += f.size;
+    }
+    if (second < 0) continue;
+
+    snprintf(event_dir, len, "%s/%lu", CAMERA_OUTBOX_ROOT,
+             (unsigned long)ev.timestamp);
+    snprintf(dir, len, "%s/%d", event_dir, second);
+    found = true;
+    break;
+  }
+  xSemaphoreGive(find_mutex);
+  return found;
+}
+
+bool event_outbox_clip_begin(uint32_t timestamp) {
+  char path[64];
+
+  snprintf(path, sizeof(path), "%s/%lu", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  if (SD_MMC.exists(path)) {
+    LOG_W("Event %lu is already stored", timestamp);
+    return false;
+  }
+  if (!SD_MMC.mkdir(path)) {
+    LOG_E("Failed to create %s", path);
+    return false;
+  }
+
+  snprintf(path, sizeof(path), "%s/%lu/lines", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  clip.lines = SD_MMC.open(path, FILE_WRITE);
+  clip.timestamp = timestamp;
+  clip.seconds = 0;
+  clip.frames = 0;
+  clip.bytes = 0;
+  if (!clip.lines) {
+    event_outbox_clip_end(false);
+    return false;
+  }
+  return true;
+}
+
+bool event_outbox_clip_second(uint32_t epoch) {
+  char path[64];
+
+  snprintf(path, sizeof(path), "%s/%lu/%d", CAMERA_OUTBOX_ROOT,
+           (unsigned long)clip.timestamp, clip.seconds);
+  if (!SD_MMC.mkdir(path)) return false;
+
+  if (clip.seconds > 0) clip.lines.print('\n');
+  clip.lines.printf("%lu", (unsigned long)epoch);
+  clip.seconds++;
+  clip.frames = 0;
+  return true;
+}
+
+bool event_outbox_clip_frame(Stream *data, size_t size) {
+  static uint8_t buf[1024];
+  char path[64];
+
+  if (clip.seconds == 0) return false;
+  // A clip cannot start with a repeat, there is nothing to repeat
+  if (!data) {
+    if (clip.bytes == 0) return false;
+    clip.lines.printf(" %d:0", clip.frames++);
+    return true;
+  }
+
+  outbox_evict_for(clip.bytes + size);
+
+  snprintf(path, sizeof(path), "%s/%lu/%d/%d.jpg", CAMERA_OUTBOX_ROOT,
+           (unsigned long)clip.timestamp, clip.seconds - 1, clip.frames);
+  File file = SD_MMC.open(path, FILE_WRITE);
+  if (!file) return false;
+
+  size_t copied = 0;
+  while (copied < size) {
+    size_t got = data->readBytes(buf, min<size_t>(size - copied, sizeof(buf)));
+    if (got == 0 || file.write(buf, got) != got) break;
+    copied += got;
+  }
+  file.close();
+  if (copied != size) {
+    SD_MMC.remove(path);
+    return false;
+  }
+
+  clip.lines.printf(" %d:%u", clip.frames++, (unsigned)size);
+  clip.bytes += size;
+  return true;
+}
+
+bool event_outbox_clip_end(bool keep) {
+  char path[64];
+
+  if (clip.lines) {
+    if (clip.seconds > 0) clip.lines.print('\n');
+    clip.lines.close();
+  }
+  snprintf(path, sizeof(path), "%s/%lu", CAMERA_OUTBOX_ROOT,
+           (unsigned long)clip.timestamp);
+  if (!keep || clip.bytes == 0 ||
+      !outbox_write_index(clip.timestamp, clip.seconds, clip.bytes)) {
+    _remove_dir_r(path);
+    return false;
+  }
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  events.push_back({clip.timestamp, clip.seconds, clip.bytes});
+  events_bytes += clip.bytes;
+  // Uploaded oldest first, keep the list in order
+  std::sort(events.begin(), events.end(),
+            [](const outbox_event_t &a, const outbox_event_t &b) {
+              return a.timestamp < b.timestamp;
+            });
+  xSemaphoreGive(events_mutex);
+
+  LOG_I("Stored clip %lu (%ds, %u bytes)", clip.timestamp, clip.seconds,
+        (unsigned)clip.bytes);
+  xTaskNotifyGive(EventOutboxTask);
+  return true;
+}
+
+void event_outbox_task(void *pvParameters) {
+  uint32_t backoff_ms = BASE_BACKOFF_MS;
+  outbox_event_t ev;
+
+  for (;;) {
+    // Woken up by new events, otherwise check periodically
+    // in case the network came back
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(OUTBOX_POLL_MS));
+
+    while (networkOnline && outbox_next(ev)) {
+      vTaskDelay(pdMS_TO_TICKS(esp_random() %
+                               (CONFIG_UPLOAD_START_JITTER_MS + 1)));
+      bool uploaded = upload_event(ev);
+      // Rate hints only hold for the upload they were given in
+      link_set_upload_rate(0);
+      outbox_free_tables();
+
+      if (uploaded) {
+        outbox_remove(ev.timestamp);
+        backoff_ms = BASE_BACKOFF_MS;
+      } else {
+        // Keep the event and try again later
+        LOG_W("Upload of event %lu failed, retrying in %lu ms", ev.timestamp,
+              backoff_ms);
+        vTaskDelay(pdMS_TO_TICKS(backoff_ms));
+        backoff_ms = min<uint32_t>(backoff_ms * 2, CONFIG_NET_BACKOFF_MAX_MS);
+        break;
+      }
+    }
+
+    xSemaphoreTake(events_mutex, portMAX_DELAY);
+    uploading_timestamp = 0;
+    xSemaphoreGive(events_mutex);
+  }
+}
+
+// Rebuild the event list from what is on the card
+static void outbox_restore() {
+  File root = SD_MMC.open(CAMERA_OUTBOX_ROOT);
+  if (!root || !root.isDirectory()) {
+    return;
+  }
+
+  File entry;
+  while ((entry = root.openNextFile())) {
+    char dir[48];
+    char path[64];
+    int seconds = 0;
+    unsigned bytes = 0;
+    outbox_event_t ev;
+
+    bool is_dir = entry.isDirectory();
+    ev.timestamp = strtoul(entry.name(), NULL, 10);
+    snprintf(dir, sizeof(dir), "%s/%s", CAMERA_OUTBOX_ROOT, entry.name());
+    entry.close();
+    if (!is_dir || ev.timestamp == 0) {
+      continue;
+    }
+
+    // Lines are only left while the index is not complete, e.g.
+    // after a reboot during the post-event window. The seconds they
+    // list are pinned footage, so the index is written from them
+    snprintf(path, sizeof(path), "%s/lines", dir);
+    if (SD_MMC.exists(path) && !outbox_recover_index(ev.timestamp)) {
+      _remove_dir_r(dir);
+      continue;
+    }
+
+    snprintf(path, sizeof(path), "%s/index", dir);
+    File index = SD_MMC.open(path, FILE_READ);
+    if (!index) {
+      // Interrupted before anything was stored
+      _remove_dir_r(dir);
+      continue;
+    }
+    String line = index.readStringUntil('\n');
+    index.close();
+    if (sscanf(line.c_str(), "%d %u", &seconds, &bytes) != 2) {
+      continue;
+    }
+
+    ev.seconds = seconds;
+    ev.bytes = bytes;
+    events.push_back(ev);
+    events_bytes += bytes;
+  }
+  root.close();
+
+  std::sort(events.begin(), events.end(),
+            [](const outbox_event_t &a, const outbox_event_t &b) {
+              return a.timestamp < b.timestamp;
+            });
+
+  if (!events.empty()) {
+    Serial.printf("Restored %u stored events (%llu bytes)\n",
+                  (unsigned)events.size(), events_bytes);
+  }
+}
+
+// Oldest stored event, unless one is being recorded. That one goes
+// first, so the coordinator gets it while it happens
+static bool outbox_next(outbox_event_t &ev) {
+  bool found = false;
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  for (const outbox_event_t &e : events) {
+    if (!found || e.timestamp == live.timestamp) {
+      ev = e;
+      found = true;
+    }
+  }
+  if (found) uploading_timestamp = ev.timestamp;
+  xSemaphoreGive(events_mutex);
+  return found;
+}
+
+static void outbox_remove(uint32_t timestamp) {
+  char path[64];
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  for (auto it = events.begin(); it != events.end(); ++it) {
+    if (it->timestamp == timestamp) {
+      events_bytes -= it->bytes;
+      events.erase(it);
+      break;
+    }
+  }
+  if (uploading_timestamp == timestamp) {
+    uploading_timestamp = 0;
+  }
+  xSemaphoreGive(events_mutex);
+
+  snprintf(path, sizeof(path), "%s/%lu", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  _remove_dir_r(path);
+}
+
+// Drop the oldest events until `bytes` more fit in the quota
+static void outbox_evict_for(size_t bytes) {
+  for (;;) {
+    uint32_t victim = 0;
+
+    xSemaphoreTake(events_mutex, portMAX_DELAY);
+    if (events_bytes + bytes > OUTBOX_QUOTA_BYTES) {
+      for (const outbox_event_t &ev : events) {
+        if (ev.timestamp != uploading_timestamp &&
+            ev.timestamp != live.timestamp) {
+          victim = ev.timestamp;
+          break;
+        }
+      }
+    }
+    xSemaphoreGive(events_mutex);
+
+    if (victim == 0) {
+      return;
+    }
+    LOG_W("Outbox full, evicting event %lu", victim);
+    outbox_remove(victim);
+  }
+}
+
+static bool outbox_read_index(const outbox_event_t &ev,
+                              std::vector<outbox_frame_t> &frames) {
+  char path[64];
+
+  // Only complete in memory while it is being recorded
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  const bool recording = ev.timestamp == live.timestamp;
+  if (recording) {
+    frames.insert(frames.end(), live.frames.begin(), live.frames.end());
+  }
+  xSemaphoreGive(events_mutex);
+  if (recording) {
+    return true;
+  }
+  snprintf(path, sizeof(path), "%s/%lu/index", CAMERA_OUTBOX_ROOT,
+           (unsigned long)ev.timestamp);
+
+  File index = SD_MMC.open(path, FILE_READ);
+  if (!index) {
+    return false;
+  }
+
+  // Skip the header line
+  index.readStringUntil('\n');
+  outbox_frame_t last_stored = {};
+  for (int second = 0; index.available(); second++) {
+    String line = index.readStringUntil('\n');
+    const char *p = line.c_str();
+    uint32_t epoch = strtoul(p, NULL, 10);
+    unsigned frame;
+    unsigned long size;
+    int consumed;
+
+    p = strchr(p, ' ');
+    while (p && sscanf(p, " %u:%lu%n", &frame, &size, &consumed) == 2) {
+      bool streamed = false;
+      unsigned tables = 0;
+
+      p += consumed;
+      while (p[0] == ':') {
+        if (p[1] == 's') {
+          streamed = true;
+          p += 2;
+        } else if (p[1] == 't' && sscanf(p, ":t%u%n", &tables, &consumed) == 1) {
+          p += consumed;
+        } else {
+          break;
+        }
+      }
+      outbox_frame_t f = {(uint16_t)second, (uint16_t)frame, (uint32_t)size,
+                          epoch, streamed, (uint8_t)tables,
+                          last_stored.second, last_stored.frame};
+      if (f.size > 0) last_stored = f;
+      frames.push_back(f);
+    }
+  }
+  index.close();
+  return true;
+}
+
+/**
+ * @brief Write the index of an event from the lines kept apart while
+ * it was built. The event is complete from then on
+ * @param lines_len Only the lines up to there are taken
+ */
+static bool outbox_write_index(uint32_t timestamp, int seconds, size_t bytes,
+                               size_t lines_len) {
+  static uint8_t buf[512];
+  char path[64];
+
+  snprintf(path, sizeof(path), "%s/%lu/lines", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  File lines = SD_MMC.open(path, FILE_READ);
+  snprintf(path, sizeof(path), "%s/%lu/index", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  File index = SD_MMC.open(path, FILE_WRITE);
+  bool ok = lines && index;
+  if (ok) {
+    index.printf("%d %u\n", seconds, (unsigned)bytes);
+    size_t got;
+    while (lines_len > 0 &&
+           (got = lines.read(buf, min(sizeof(buf), lines_len))) > 0) {
+      ok = ok && index.write(buf, got) == got;
+      lines_len -= got;
+    }
+  }
+  if (lines) lines.close();
+  if (index) index.close();
+  // Until the index is complete, a reboot writes it again
+  if (ok) {
+    snprintf(path, sizeof(path), "%s/%lu/lines", CAMERA_OUTBOX_ROOT,
+             (unsigned long)timestamp);
+    SD_MMC.remove(path);
+  }
+  return ok;
+}
+
+/**
+ * @brief Write the index of an event left without one by a reboot,
+ * e.g. during its post-event window, from the seconds it got
+ * @note A line cut off by the reboot is left out
+ * @return false if not a single second was complete
+ */
+static bool outbox_recover_index(uint32_t timestamp) {
+  char path[64];
+  int seconds = 0;
+  size_t bytes = 0;
+  size_t complete = 0;
+  size_t pos = 0;
+
+  snprintf(path, sizeof(path), "%s/%lu/lines", CAMERA_OUTBOX_ROOT,
+           (unsigned long)timestamp);
+  File lines = SD_MMC.open(path, FILE_READ);
+  if (!lines) {
+    return false;
+  }
+  const size_t len = lines.size();
+  while (lines.available()) {
+    String line = lines.readStringUntil('\n');
+    pos += line.length() + 1;
+    if (pos > len) {
+      break;
+    }
+
+    // <epoch> <frame>:<size>[:s][:t<set>] ...
+    const char *p = strchr(line.c_str(), ' ');
+    unsigned frame;
+    unsigned long size;
+    while (p && sscanf(p, " %u:%lu", &frame, &size) == 2) {
+      bytes += size;
+      p = strchr(p + 1, ' ');
+    }
+    seconds++;
+    complete = pos;
+  }
+  lines.close();
+
+  if (seconds == 0) {
+    return false;
+  }
+  LOG_W("Event %lu was cut short, keeping its first %ds", timestamp,
+        seconds);
+  return outbox_write_index(timestamp, seconds, bytes, complete);
+}
+
+/**
+ * @brief Wait for more seconds of an event being recorded
+ * @note Woken up as each second is added
+ * @return false once `frames` holds the whole event
+ */
+static bool outbox_wait_frames(const outbox_event_t &ev,
+                               std::vector<outbox_frame_t> &frames) {
+  for (;;) {
+    const size_t have = frames.size();
+
+    xSemaphoreTake(events_mutex, portMAX_DELAY);
+    const bool recording = ev.timestamp == live.timestamp;
+    if (recording && live.frames.size() > have) {
+      frames.insert(frames.end(), live.frames.begin() + have,
+                    live.frames.end());
+    }
+    xSemaphoreGive(events_mutex);
+    if (frames.size() > have) {
+      return true;
+    }
+
+    // Sealed in the meantime, its last seconds are in the index
+    if (!recording) {
+      std::vector<outbox_frame_t> all;
+      if (!outbox_read_index(ev, all) || all.size() <= have) {
+        return false;
+      }
+      frames.insert(frames.end(), all.begin() + have, all.end());
+      return true;
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(OUTBOX_POLL_MS));
+  }
+}
+
+/**
+ * @brief Upload every frame of a stored event
+ * @note Frames which fail are not retried in place. They are put
+ * aside and sent again after the rest of the event, each with its
+ * own backoff, so a single bad frame does not hold up the others.
+ * Frames which still fail are reported with the completion marker.
+ * An event still being recorded is sent as its seconds are added
+ * @return false if the coordinator looks unreachable
+ */
+static bool upload_event(const outbox_event_t &ev) {
+  std::vector<outbox_frame_t> frames;
+  std::vector<outbox_retry_t> deferred;
+  String missing;
+  int missing_count = 0;
+  int consecutive_failures = 0;
+  int busy_count = 0;
+  int resp;
+  bool first_frame = true;
+  int last_second = -1;
+  size_t bytes = 0;
+
+  xSemaphoreTake(events_mutex, portMAX_DELAY);
+  const bool recording = ev.timestamp == live.timestamp;
+  xSemaphoreGive(events_mutex);
+
+  if (!outbox_read_index(ev, frames)) {
+    LOG_E("Event %lu has no index, dropping it", ev.timestamp);
+    return true;
+  }
+
+  // Every event of this camera goes to the same coordinator
+  // while it is up
+  int node = coordinator_pick(deviceName);
+  if (node < 0) {
+    LOG_E("No coordinator to send event %lu to", ev.timestamp);
+    return false;
+  }
+  upload_set_node(node);
+  upload_previous = "";
+  stream_ref_bytes = 0;
+  tables_left_out = 0;
+  tables_set_bytes = 0;
+  outbox_free_tables();
+
+  if (recording) {
+    LOG_I("Sending event %lu while it is recorded", ev.timestamp);
+  } else {
+    LOG_I("Sending event %lu (%d seconds, %u frames)", ev.timestamp,
+          ev.seconds, (unsigned)frames.size());
+  }
+
+  for (size_t i = 0;; i++) {
+    if (i == frames.size() &&
+        (!recording || !outbox_wait_frames(ev, frames))) {
+      break;
+    }
+    const outbox_frame_t &f = frames[i];
+    bytes += f.size;
+    if (f.second != last_second) {
+      LOG_D("Uploading second %d", f.second);
+      last_second = f.second;
+    }
+
+    // Being turned away is not the frame's fault, send it again
+    // once the coordinator has room
+    while (coordinator_busy(resp = send_frame_failover(ev, f, first_frame))) {
+      if (!wait_busy(++busy_count)) return false;
+    }
+    busy_count = 0;
+
+    if (resp == HTTP_CODE_NO_CONTENT) {
+      first_frame = false;
+      consecutive_failures = 0;
+      continue;
+    }
+
+    LOG_W("Deferring frame %d of second %d (%d)", f.frame, f.second, resp);
+    deferred.push_back({i, 1, (uint32_t)(millis() + retry_delay_ms(1))});
+    if (++consecutive_failures >= MAX_CONSECUTIVE_FAILURES) return false;
+  }
+
+  // Retry deferred frames, soonest due first
+  while (!deferred.empty()) {
+    auto next = std::min_element(
+        deferred.begin(), deferred.end(),
+        [](const outbox_retry_t &a, const outbox_retry_t &b) {
+          return (int32_t)(a.due_ms - b.due_ms) < 0;
+        });
+    int32_t wait_ms = (int32_t)(next->due_ms - millis());
+    if (wait_ms > 0) {
+      vTaskDelay(pdMS_TO_TICKS(wait_ms));
+    }
+
+    const outbox_frame_t &f = frames[next->frame];
+    LOG_I("Retrying frame %d of second %d (attempt %d)", f.frame, f.second,
+          next->attempts + 1);
+    while (coordinator_busy(resp = send_frame_failover(ev, f, first_frame))) {
+      if (!wait_busy(++busy_count)) return false;
+    }
+    busy_count = 0;
+
+    if (resp == HTTP_CODE_NO_CONTENT) {
+      first_frame = false;
+      deferred.erase(next);
+      continue;
+    }
+
+    if (++next->attempts >= MAX_FRAME_RETRIES) {
+      LOG_W("Giving up on frame %d of second %d", f.frame, f.second);
+      if (missing_count++ < MAX_MISSING_REPORT) {
+        if (missing.length()) missing += ",";
+        missing += String(f.second) + ":" + String(f.frame);
+      }
+      deferred.erase(next);
+    } else {
+      next->due_ms = millis() + retry_delay_ms(next->attempts);
+    }
+  }
+
+  // Nothing made it through, keep the event for later
+  if (first_frame && !frames.empty()) {
+    return false;
+  }
+
+  LOG_I("Completed Sending Frames. Sending indicator");
+  if (!send_upload_complete(ev, missing)) {
+    LOG_E("Failed to indicate upload end. Video not uploaded");
+    return false;
+  }
+  if (missing_count) {
+    LOG_W("Video sent with %d missing frames", missing_count);
+  } else {
+    LOG_I("Complete video buffer sent!");
+  }
+  if (stream_ref_bytes) {
+    LOG_I("%lu of %u bytes were already streamed", stream_ref_bytes,
+          (unsigned)bytes);
+  }
+  if (tables_left_out) {
+    LOG_I("JPEG tables: %lu bytes left out of frames, %lu sent as sets",
+          tables_left_out, tables_set_bytes);
+  }
+  return true;
+}
+
+/**
+ * @brief Send a stored frame, moving the event to another
+ * coordinator if the current one goes down
+ * @note Frames already sent are not sent again, the next
+ * coordinator takes the event over from there
+ * @return HTTP response code
+ */
+static int send_frame_failover(const outbox_event_t &ev,
+                               const outbox_frame_t &f, bool first_frame) {
+  for (;;) {
+    int resp = send_frame(upload_url, ev, f, first_frame);
+    if (!coordinator_failed(resp) || !upload_failover()) return resp;
+  }
+}
+
+/**
+ * @brief Make a single attempt at sending a stored frame
+ * @note The frame is streamed from the card into the connection,
+ * so memory use does not depend on the size of the frame
+ * @return HTTP response code
+ */
+static int send_frame(const String &url, const outbox_event_t &ev,
+                      const outbox_frame_t &f, bool first_frame) {
+  static char path[128];
+  fs::File file;
+  int resp;
+
+  // Ask the coordinator to reuse the copy it got over the live
+  // stream. It answers 404 if it did not keep it
+  if (f.streamed) {
+    request_begin(url, ev, first_frame, false);
+    outbox_http.addHeader("Frame-Second", String(f.second));
+    outbox_http.addHeader("Frame-Number", String(f.frame));
+    outbox_http.addHeader("Stream-Reference", String(f.epoch));
+    resp = outbox_http.sendRequest("POST", (uint8_t *)"", 0);
+    request_end(resp);
+
+    if (resp != HTTP_CODE_NOT_FOUND) {
+      if (resp == HTTP_CODE_NO_CONTENT) stream_ref_bytes += f.size;
+      return resp;
+    }
+  }
+
+  // Repeated frames have nothing on the card, the coordinator
+  // reuses the frame they repeat instead
+  if (f.size > 0) {
+    snprintf(path, sizeof(path), "%s/%lu/%d/%d.jpg", CAMERA_OUTBOX_ROOT,
+             (unsigned long)ev.timestamp, f.second, f.frame);
+
+    file = SD_MMC.open(path, "r");
+    if (!file) {
+      return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    }
+  }
+
+  // Abbreviated frames refer to a table set sent ahead of them, or
+  // go out as the original JPEG to coordinators which cannot
+  // put them back together
+  const jpeg_tables_t *tables = NULL;
+  if (f.size > 0 && f.tables) {
+    tables = outbox_tables(ev, f.tables);
+    if (!tables) {
+      file.close();
+      return HTTPC_ERROR_SEND_PAYLOAD_FAILED;
+    }
+    if (!tables_refused && !(tables_sent & (1u << f.tables))) {
+      resp = send_table_set(url, ev, f.tables, *tables);
+      if (resp != HTTP_CODE_NO_CONTENT) {
+        file.close();
+        return resp;
+      }
+    }
+  }
+  const bool expand = tables && tables_refused;
+
+  // Deferred frames arrive out of order, so each one says
+  // where it belongs in the event
+  request_begin(url, ev, first_frame, false);
+  outbox_http.addHeader("Frame-Second", String(f.second));
+  outbox_http.addHeader("Frame-Number", String(f.frame));
+
+  if (f.size > 0) {
+    size_t len = expand ? JpegExpandStream::expanded_len(f.size, *tables)
+                        : f.size;
+    if (tables && !expand) {
+      outbox_http.addHeader("Frame-Tables", String(f.tables));
+    }
+    link_acquire(LINK_CLASS::UPLOAD, len);
+    uint32_t start_ms = millis();
+    if (expand) {
+      JpegExpandStream expanded(file, *tables);
+      resp = outbox_http.sendRequest("POST", &expanded, len);
+    } else {
+      resp = outbox_http.sendRequest("POST", &file, len);
+    }
+    file.close();
+    if (resp > 0) {
+      link_report(LINK_CLASS::UPLOAD, len, millis() - start_ms);
+    }
+    if (tables && !expand && resp == HTTP_CODE_NO_CONTENT) {
+      tables_left_out += tables->len;
+    }
+    // The coordinator lost the set (e.g. it restarted), it is sent
+    // again when the frame is retried
+    if (tables && !expand && resp == HTTP_CODE_CONFLICT) {
+      tables_sent &= ~(1u << f.tables);
+    }
+  } else {
+    // Named explicitly, as deferred frames arrive out of order
+    outbox_http.addHeader("Repeat-Of", String(f.repeat_second) + "/" +
+                                           String(f.repeat_frame));
+    resp = outbox_http.sendRequest("POST", (uint8_t *)"", 0);
+  }
+
+  request_end(resp);
+  return resp;
+}
+
+/**
+ * @brief Send the end of upload marker, along with the
+ * frames which could not be sent (as <second>:<frame>)
+ */
+static bool send_upload_complete(const outbox_event_t &ev,
+                                 const String &missing) {
+  int busy_count = 0;
+  int resp;
+
+  for (int attempt = 1; attempt <= MAX_FRAME_RETRIES; attempt++) {
+    request_begin(upload_url, ev, false, true);
+    if (missing.length()) {
+      outbox_http.addHeader("Missing-Frames", missing);
+    }
+    resp = outbox_http.POST((uint8_t *)"", 0);
+    request_end(resp);
+
+    if (resp == HTTP_CODE_NO_CONTENT) return true;
+    LOG_D("Upload end not acknowledged (%d)", resp);
+    // Moving on does not use up an attempt either
+    if (coordinator_failed(resp) && upload_failover()) {
+      attempt--;
+      continue;
+    }
+    // Busy answers do not use up an attempt
+    if (coordinator_busy(resp)) {
+      if (!wait_busy(++busy_count)) break;
+      attempt--;
+      continue;
+    }
+    vTaskDelay(pdMS_TO_TICKS(retry_delay_ms(attempt)));
+  }
+  return false;
+}
+
+/**
+ * @brief Send table set `k` of the event. Frames which use it then
+ * go out abbreviated, naming it in `Frame-Tables`
+ * @note The body holds the DQT and DHT segments of the set, and
+ * `Table-Runs` where each run of them goes back in the frame. The
+ * coordinator answers with the same `Table-Set` header once it has
+ * kept the set, and 409 to a frame whose set it does not have.
+ * Coordinators which do not answer with it get expanded frames
+ * @return HTTP response code
+ */
+static int send_table_set(const String &url, const outbox_event_t &ev, int k,
+                          const jpeg_tables_t &tables) {
+  char runs[64];
+
+  jpeg_tables_format_runs(&tables, runs, sizeof(runs));
+  request_begin(url, ev, false, false);
+  outbox_http.addHeader("Content-Type", "application/octet-stream");
+  outbox_http.addHeader("Table-Set", String(k));
+  outbox_http.addHeader("Table-Runs", runs);
+
+  link_acquire(LINK_CLASS::UPLOAD, tables.len);
+  int resp = outbox_http.sendRequest("POST", (uint8_t *)tables.data,
+                                     tables.len);
+  if (resp == HTTP_CODE_NO_CONTENT) {
+    if (outbox_http.header("Table-Set").toInt() == k) {
+      tables_sent |= 1u << k;
+      tables_set_bytes += tables.len;
+    } else {
+      LOG_W("Coordinator does not take JPEG table sets, sending full frames");
+      tables_refused = true;
+    }
+  }
+  request_end(resp);
+  return resp;
+}
+
+// Table set `k` of the event, NULL if it cannot be loaded
+static const jpeg_tables_t *outbox_tables(const outbox_event_t &ev, int k) {
+  char path[64];
+
+  if (k <= 0 || k > JPEG_TABLES_MAX_SETS) return NULL;
+  if (event_tables[k]) return event_tables[k];
+
+  jpeg_tables_t *t = (jpeg_tables_t *)pvPortMalloc(sizeof(jpeg_tables_t));
+  if (!t) return NULL;
+  snprintf(path, sizeof(path), "%s/%lu/tables%d", CAMERA_OUTBOX_ROOT,
+           (unsigned long)ev.timestamp, k);
+  if (!jpeg_tables_load(t, path)) {
+    LOG_E("Missing JPEG tables %s", path);
+    vPortFree(t);
+    return NULL;
+  }
+  event_tables[k] = t;
+  return t;
+}
+
+static void outbox_free_tables() {
+  for (int k = 0; k <= JPEG_TABLES_MAX_SETS; k++) {
+    if (event_tables[k]) vPortFree(event_tables[k]);
+    event_tables[k] = NULL;
+  }
+}
+
+/**
+ * @brief Start a request to the upload endpoint with the headers
+ * shared by every request of an event
+ */
+static void request_begin(const String &url, const outbox_event_t &ev,
+                          bool first_frame, bool complete) {
+  static const char *response_headers[] = {"Retry-After", "Upload-Token",
+                                           "Upload-Rate", "Table-Set"};
+
+  // The live stream only makes way while a request is going on
+  link_upload_begin();
+  request_start_ms = millis();
+  outbox_http.begin(url);
+  outbox_http.collectHeaders(response_headers, 4);
+  outbox_http.addHeader("Content-Type", "image/jpeg");
+  outbox_http.addHeader("Event-Timestamp", String(ev.timestamp));
+  outbox_http.addHeader("First-Frame", first_frame ? "true" : "false");
+  outbox_http.addHeader("Upload-Complete", complete ? "true" : "false");
+  if (upload_token.length()) {
+    outbox_http.addHeader("Upload-Token", upload_token);
+  }
+  // Tells the coordinator where the start of the event went
+  if (upload_previous.length()) {
+    outbox_http.addHeader("Previous-Coordinator", upload_previous);
+  }
+  outbox_http.setTimeout(perfConfig.upload_timeout_ms);
+}
+
+/**
+ * @brief Close the request, keeping what the coordinator asked for:
+ * an admission token to send back, a rate to pace uploads at and
+ * how long to stay away when it is busy
+ */
+static void request_end(int resp) {
+  coordinator_report(upload_node, !coordinator_failed(resp),
+                     millis() - request_start_ms);
+  retry_after_ms = 0;
+  if (resp > 0) {
+    if (outbox_http.hasHeader("Upload-Token")) {
+      upload_token = outbox_http.header("Upload-Token");
+    }
+    if (outbox_http.hasHeader("Upload-Rate")) {
+      link_set_upload_rate(outbox_http.header("Upload-Rate").toInt());
+    }
+    // Only the delay-seconds form is supported, dates fall back
+    // to the regular backoff
+    if (coordinator_busy(resp) && outbox_http.hasHeader("Retry-After")) {
+      uint32_t seconds = outbox_http.header("Retry-After").toInt();
+      retry_after_ms = min<uint32_t>(seconds * 1000, CONFIG_NET_BACKOFF_MAX_MS);
+    }
+  }
+  outbox_http.end();
+  link_upload_end();
+}
+
+static bool coordinator_busy(int resp) {
+  return resp == HTTP_CODE_TOO_MANY_REQUESTS ||
+         resp == HTTP_CODE_SERVICE_UNAVAILABLE;
+}
+
+// Could not be reached or failed on its side. Being busy is not
+// a failure, and neither is a frame which could not be read
+static bool coordinator_failed(int resp) {
+  switch (resp) {
+    case HTTPC_ERROR_CONNECTION_REFUSED:
+    case HTTPC_ERROR_SEND_HEADER_FAILED:
+    case HTTPC_ERROR_NOT_CONNECTED:
+    case HTTPC_ERROR_CONNECTION_LOST:
+    case HTTPC_ERROR_NO_HTTP_SERVER:
+    case HTTPC_ERROR_READ_TIMEOUT:
+      return true;
+  }
+  return resp >= 500 && !coordinator_busy(resp);
+}
+
+static void upload_set_node(int node) {
+  static char url_buf[256];
+  char path[160];
+
+  snprintf(path, sizeof(path), "/api/device/upload?device=%s",
+           deviceName.c_str());
+  coordinator_url(node, path, url_buf, sizeof(url_buf));
+  upload_node = node;
+  upload_url = url_buf;
+  // Tokens are handed out by each coordinator for itself, and
+  // each keeps its own table sets
+  upload_token = "";
+  retry_after_ms = 0;
+  tables_sent = 0;
+  tables_refused = false;
+}
+
+/**
+ * @brief Move the rest of the current event to the next coordinator,
+ * once the current one is down
+ * @return false if it is still up or there is nowhere else to go
+ */
+static bool upload_failover() {
+  char previous[64];
+
+  if (coordinator_up(upload_node)) return false;
+  int node = coordinator_pick(deviceName, upload_node);
+  if (node < 0) return false;
+
+  coordinator_url(upload_node, "", previous, sizeof(previous));
+  upload_previous = previous;
+  upload_set_node(node);
+  LOG_W("Moving upload from %s to %s", previous, upload_url.c_str());
+  return true;
+}
+
+/**
+ * @brief Stay away for as long as the coordinator asked, with some
+ * jitter so cameras turned away together do not come back together
+ * @return false if it has been busy for too long
+ */
+static bool wait_busy(int busy_count) {
+  if (busy_count > MAX_BUSY_RETRIES) {
+    LOG_W("Coordinator busy, keeping event for later");
+    return false;
+  }
+  uint32_t delay_ms =
+      retry_after_ms ? retry_after_ms : retry_delay_ms(busy_count);
+  delay_ms += esp_random() % (delay_ms / 4 + 1);
+  LOG_I("Coordinator busy, waiting %lu ms", delay_ms);
+  vTaskDelay(pdMS_TO_TICKS(delay_ms));
+  return true;
+}
+
+// Exponential backoff with up to 50% of random jitter
+static uint32_t retry_delay_ms(int attempt) {
+  uint32_t delay_ms = BASE_BACKOFF_MS << min(attempt - 1, 6);
+  return delay_ms + esp_random() % (delay_ms / 2 + 1);
+}
+
+static void _remove_dir_r(const char *path) {
+  File dir = SD_MMC.open(path);
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+
+  File entry;
+  while ((entry = dir.openNextFile())) {
+    String entryPath = String(path) + "/" + entry.name();
+    bool is_dir = entry.isDirectory();
+    entry.close();
+    if (is_dir) {
+      _remove_dir_r(entryPath.c_str());
+    } else {
+      SD_MMC.remove(entryPath.c_str());
+    }
+  }
+  dir.close();
+  SD_MMC.rmdir(path);
+}
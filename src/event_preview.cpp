@@ -0,0 +1,353 @@
+#include "event_preview.h"
+
+#include <Arduino.h>
+
+#include <vector>
+
+#include "app_config.h"
+#include "coordinator_pool.h"
+#include "event_outbox.h"
+#include "frame_index.h"
+#include "img_converters.h"
+#include "jpeg_tables.h"
+#include "link_arbiter.h"
+#include "log_ring.h"
+#include "main.h"
+#include "perf_config.h"
+
+// === Local Defines ===
+
+#define PREVIEW_TILE_HEIGHT (CONFIG_EVENT_PREVIEW_TILE_WIDTH * 3 / 4)
+
+// === Types ===
+
+// A stored frame picked for the preview
+typedef struct {
+  uint32_t epoch;
+  uint16_t ms;
+  int slot;  // -1 once handed over to the outbox
+  int frame;
+  uint32_t size;
+  uint8_t tables;
+  char dir[32];
+  char event_dir[32];  // Holds the table sets of outbox frames
+} preview_frame_t;
+
+// === Variables ===
+
+TaskHandle_t EventPreviewTask = NULL;
+static HTTPClient preview_http;
+
+// === Local Functions ===
+
+static void event_preview_task(void *pvParameters);
+static int pick_frames(uint32_t timestamp, preview_frame_t *out, int limit);
+static uint8_t *read_frame(const preview_frame_t &f, size_t *len);
+static bool build_mosaic(uint8_t *const *frames, const size_t *lens,
+                         int count, uint8_t **out, size_t *out_len);
+static bool send_preview(uint32_t timestamp, const uint8_t *buf, size_t len,
+                         const preview_frame_t *frames, int count);
+static bool jpeg_size(const uint8_t *buf, size_t len, uint16_t *width,
+                      uint16_t *height);
+static uint8_t *alloc_large(size_t len);
+
+void event_preview_start() {
+#if CONFIG_EVENT_PREVIEW_FRAMES
+  xTaskCreate(event_preview_task, "EventPreviewTask", 8192, NULL, 4,
+              &EventPreviewTask);
+#endif
+}
+
+void event_preview_notify(uint32_t timestamp) {
+  if (EventPreviewTask) {
+    xTaskNotify(EventPreviewTask, timestamp, eSetValueWithOverwrite);
+  }
+}
+
+static void event_preview_task(void *pvParameters) {
+  preview_frame_t picked[CONFIG_EVENT_PREVIEW_FRAMES];
+  uint8_t *bufs[CONFIG_EVENT_PREVIEW_FRAMES];
+  size_t lens[CONFIG_EVENT_PREVIEW_FRAMES];
+
+  for (;;) {
+    uint32_t timestamp = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t start_ms = millis();
+
+    // Let the frames of the event second reach the card
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_EVENT_PREVIEW_DELAY_MS));
+    if (!networkOnline) continue;
+
+    int count = pick_frames(timestamp, picked, CONFIG_EVENT_PREVIEW_FRAMES);
+    int loaded = 0;
+    for (int i = 0; i < count; i++) {
+      bufs[loaded] = read_frame(picked[i], &lens[loaded]);
+      if (bufs[loaded]) picked[loaded++] = picked[i];
+    }
+    if (!loaded) {
+      LOG_W("No frames to preview event %lu with", timestamp);
+      continue;
+    }
+
+    // A single frame, or frames which could not be decoded, go out
+    // as they were stored
+    uint8_t *mosaic = NULL;
+    size_t mosaic_len = 0;
+    bool sent;
+    if (loaded > 1 &&
+        build_mosaic(bufs, lens, loaded, &mosaic, &mosaic_len)) {
+      sent = send_preview(timestamp, mosaic, mosaic_len, picked, loaded);
+      free(mosaic);
+    } else {
+      sent = send_preview(timestamp, bufs[loaded - 1], lens[loaded - 1],
+                          &picked[loaded - 1], 1);
+    }
+
+    for (int i = 0; i < loaded; i++) free(bufs[i]);
+    if (sent) {
+      LOG_I("Preview of event %lu sent after %lu ms (%d frames)", timestamp,
+            millis() - start_ms, loaded);
+    }
+  }
+}
+
+/**
+ * @brief Pick frames spread evenly over the seconds around the
+ * event, the newest frame included
+ * @return Number of frames picked
+ */
+static int pick_frames(uint32_t timestamp, preview_frame_t *out, int limit) {
+  static frame_index_slot_t info;
+  std::vector<preview_frame_t> found;
+  char dir[32];
+  char event_dir[32];
+  const int size = camera_svc_ring_size();
+  const uint32_t now = timeClient.getEpochTime();
+  // Never look past what the ring buffer holds, whatever the
+  // sensor clock says
+  uint32_t first = min(timestamp, now) - CONFIG_EVENT_PREVIEW_SECONDS;
+  first = max(first, now - size + 1);
+  int slot;
+
+  for (uint32_t t = first; t <= now; t++) {
+    // Seconds before the event leave the ring buffer for the
+    // outbox as soon as it fires
+    if (frame_index_find(t, size, &info, &slot)) {
+      snprintf(dir, sizeof(dir), "%s/%d", CAMERA_FB_ROOT, slot);
+    } else if (event_outbox_find(t, dir, event_dir, sizeof(dir), &info)) {
+      slot = -1;
+    } else {
+      continue;
+    }
+    for (int n = 0; n < info.count; n++) {
+      const frame_index_entry_t &e = info.frames[n];
+      if (!e.valid || e.repeat) continue;
+      preview_frame_t f = {t, e.ms, slot, n, e.size, e.tables, {}, {}};
+      snprintf(f.dir, sizeof(f.dir), "%s", dir);
+      if (slot < 0) snprintf(f.event_dir, sizeof(f.event_dir), "%s", event_dir);
+      found.push_back(f);
+    }
+  }
+
+  int count = min<int>(limit, found.size());
+  for (int i = 0; i < count; i++) {
+    size_t idx = count == 1 ? found.size() - 1
+                            : i * (found.size() - 1) / (count - 1);
+    out[i] = found[idx];
+  }
+  return count;
+}
+
+/**
+ * @brief Read a stored frame as a complete JPEG
+ * @return Allocated with `malloc`, NULL if it could not be read
+ */
+static uint8_t *read_frame(const preview_frame_t &f, size_t *len) {
+  static const jpeg_tables_t no_tables = {};
+  static jpeg_tables_t event_set;
+  static frame_index_slot_t info;
+  char path[64];
+
+  // Sets in memory only cover the ring buffer, an event has its own
+  const jpeg_tables_t *tables = &no_tables;
+  if (f.tables && f.slot >= 0) {
+    tables = jpeg_tables_get(f.tables);
+  } else if (f.tables) {
+    snprintf(path, sizeof(path), "%s/tables%u", f.event_dir, f.tables);
+    tables = jpeg_tables_load(&event_set, path) ? &event_set : NULL;
+  }
+  if (!tables) return NULL;
+
+  snprintf(path, sizeof(path), "%s/%d.jpg", f.dir, f.frame);
+  File file = SD_MMC.open(path, FILE_READ);
+  if (!file && f.slot >= 0 && frame_index_epoch(f.slot) == f.epoch) {
+    // Seconds around the event move to the outbox while the preview
+    // is being built, the slot still lists them until it is reused
+    preview_frame_t moved = f;
+    moved.slot = -1;
+    if (!event_outbox_find(f.epoch, moved.dir, moved.event_dir,
+                           sizeof(moved.dir), &info) ||
+        f.frame >= info.count || !info.frames[f.frame].valid) {
+      return NULL;
+    }
+    moved.size = info.frames[f.frame].size;
+    return read_frame(moved, len);
+  }
+  if (!file) return NULL;
+
+  *len = JpegExpandStream::expanded_len(f.size, *tables);
+  uint8_t *buf = alloc_large(*len);
+  size_t got = 0;
+  if (buf) {
+    JpegExpandStream src(file, *tables);
+    got = src.readBytes((char *)buf, *len);
+  }
+  file.close();
+
+  // Overwritten by the ring buffer in the meantime
+  if (buf && (got != *len ||
+              (f.slot >= 0 && frame_index_epoch(f.slot) != f.epoch))) {
+    free(buf);
+    buf = NULL;
+  }
+  return buf;
+}
+
+/**
+ * @brief Tile the frames into a single JPEG, in the order given
+ * @note Each frame is decoded at the largest power of two scale which
+ * fits its tile, centered and cut to the tile if it is too tall
+ */
+static bool build_mosaic(uint8_t *const *frames, const size_t *lens,
+                         int count, uint8_t **out, size_t *out_len) {
+  const int tile_w = CONFIG_EVENT_PREVIEW_TILE_WIDTH;
+  const int tile_h = PREVIEW_TILE_HEIGHT;
+  int cols = 1;
+  while (cols * cols < count) cols++;
+  const int rows = (count + cols - 1) / cols;
+  const int width = cols * tile_w;
+  const int height = rows * tile_h;
+  const size_t mosaic_len = (size_t)width * height * 2;
+  uint8_t *rgb = NULL;
+  size_t rgb_sz = 0;
+  int decoded = 0;
+
+  uint8_t *mosaic = alloc_large(mosaic_len);
+  if (!mosaic) return false;
+  memset(mosaic, 0, mosaic_len);
+
+  for (int i = 0; i < count; i++) {
+    uint16_t w, h;
+    if (!jpeg_size(frames[i], lens[i], &w, &h)) continue;
+
+    // JPG_SCALE_* go up in powers of two
+    int shift = 0;
+    while (shift < JPG_SCALE_MAX && (w >> shift) > tile_w) shift++;
+    const int sw = w >> shift;
+    const int sh = h >> shift;
+    const size_t need = (size_t)sw * sh * 2;
+
+    if (need > rgb_sz) {
+      free(rgb);
+      rgb = alloc_large(need);
+      rgb_sz = rgb ? need : 0;
+      if (!rgb) break;
+    }
+    if (!jpg2rgb565(frames[i], lens[i], rgb, (jpg_scale_t)shift)) continue;
+
+    const int cw = min(sw, tile_w);
+    const int ch = min(sh, tile_h);
+    const int dx = (i % cols) * tile_w + (tile_w - cw) / 2;
+    const int dy = (i / cols) * tile_h + (tile_h - ch) / 2;
+    const int sx = (sw - cw) / 2;
+    const int sy = (sh - ch) / 2;
+    for (int y = 0; y < ch; y++) {
+      memcpy(mosaic + ((size_t)(dy + y) * width + dx) * 2,
+             rgb + ((size_t)(sy + y) * sw + sx) * 2, cw * 2);
+    }
+    decoded++;
+  }
+  free(rgb);
+
+  bool ok = decoded > 0 &&
+            fmt2jpg(mosaic, mosaic_len, width, height, PIXFORMAT_RGB565,
+                    CONFIG_EVENT_PREVIEW_QUALITY, out, out_len);
+  free(mosaic);
+  return ok;
+}
+
+/**
+ * @brief Make a single attempt at sending the preview
+ * @note The capture time of each frame is listed in
+ * `Preview-Frames` (as <epoch>.<ms>), in the order of the tiles
+ */
+static bool send_preview(uint32_t timestamp, const uint8_t *buf, size_t len,
+                         const preview_frame_t *frames, int count) {
+  char url[256];
+  char path[160];
+  char time[24];
+  String times;
+
+  // Same coordinator the event itself goes to
+  int node = coordinator_pick(deviceName);
+  if (node < 0) return false;
+  snprintf(path, sizeof(path), "/api/device/preview?device=%s",
+           deviceName.c_str());
+  coordinator_url(node, path, url, sizeof(url));
+
+  for (int i = 0; i < count; i++) {
+    snprintf(time, sizeof(time), "%lu.%03u", (unsigned long)frames[i].epoch,
+             frames[i].ms);
+    if (i) times += ",";
+    times += time;
+  }
+
+  link_acquire(LINK_CLASS::UPLOAD, len);
+  uint32_t start_ms = millis();
+  preview_http.begin(url);
+  preview_http.addHeader("Content-Type", "image/jpeg");
+  preview_http.addHeader("Event-Timestamp", String(timestamp));
+  preview_http.addHeader("Preview-Frames", times);
+  preview_http.setTimeout(perfConfig.upload_timeout_ms);
+  int resp = preview_http.POST((uint8_t *)buf, len);
+  preview_http.end();
+
+  uint32_t elapsed_ms = millis() - start_ms;
+  coordinator_report(node, resp > 0, elapsed_ms);
+  if (resp > 0) {
+    link_report(LINK_CLASS::UPLOAD, len, elapsed_ms);
+  }
+
+  if (resp != HTTP_CODE_NO_CONTENT) {
+    LOG_W("Preview of event %lu not accepted (%d)", timestamp, resp);
+    return false;
+  }
+  return true;
+}
+
+// Dimensions from the start of frame segment
+static bool jpeg_size(const uint8_t *buf, size_t len, uint16_t *width,
+                      uint16_t *height) {
+  size_t pos = 2;
+
+  while (pos + 9 <= len && buf[pos] == 0xFF) {
+    uint8_t marker = buf[pos + 1];
+    if (marker == 0xFF) {
+      pos++;
+      continue;
+    }
+    if (marker >= 0xC0 && marker <= 0xC2) {
+      *height = (buf[pos + 5] << 8) | buf[pos + 6];
+      *width = (buf[pos + 7] << 8) | buf[pos + 8];
+      return *width && *height;
+    }
+    pos += 2 + ((buf[pos + 2] << 8) | buf[pos + 3]);
+  }
+  return false;
+}
+
+// PSRAM when there is some
+static uint8_t *alloc_large(size_t len) {
+  uint8_t *buf = (uint8_t *)ps_malloc(len);
+  if (!buf) buf = (uint8_t *)malloc(len);
+  return buf;
+}
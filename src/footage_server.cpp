@@ -0,0 +1,425 @@
+#include "footage_server.h"
+
+#include <Arduino.h>
+
+#include <vector>
+
+#include "app_config.h"
+#include "archive.h"
+#include "esp_http_server.h"
+#include "event_outbox.h"
+#include "frame_index.h"
+#include "jpeg_tables.h"
+#include "log_ring.h"
+#include "main.h"
+#include "perf_config.h"
+
+// === Local Defines ===
+
+#define FOOTAGE_CHUNK_SZ (4096)
+// Longest range served by a single request
+#define FOOTAGE_MAX_SECONDS (PERF_MAX_WINDOW_SECONDS * 2)
+#define FOOTAGE_PATH_SZ (48)
+
+// === Types ===
+
+// A second of footage, from the ring buffer, a stored event
+// or the archive
+typedef struct {
+  char dir[FOOTAGE_PATH_SZ];        // Segment file for the archive
+  char event_dir[FOOTAGE_PATH_SZ];  // Empty for the ring buffer
+  int slot;                         // -1 unless from the ring buffer
+  bool archived;
+} footage_second_t;
+
+typedef struct {
+  uint32_t epoch;
+  uint16_t frame;
+  uint16_t ms;
+  uint32_t size;    // Bytes on the card, 0 for a repeat
+  uint32_t length;  // Bytes served, after expansion
+  const jpeg_tables_t *tables;
+  uint16_t second;  // Index in `footage_t::seconds`
+  uint32_t offset;  // In the segment file, for archived frames
+} footage_frame_t;
+
+// JPEG table set loaded from a stored event
+typedef struct {
+  String path;
+  jpeg_tables_t *tables;
+} footage_tables_t;
+
+// Frames of a request and what is needed to read them back
+typedef struct {
+  std::vector<footage_second_t> seconds;
+  std::vector<footage_frame_t> frames;
+  std::vector<footage_tables_t> loaded;
+} footage_t;
+
+// === Variables ===
+
+static httpd_handle_t footage_httpd = NULL;
+static const jpeg_tables_t no_tables = {};
+
+// === Local Functions ===
+
+static esp_err_t list_handler(httpd_req_t *req);
+static esp_err_t window_handler(httpd_req_t *req);
+static esp_err_t frame_handler(httpd_req_t *req);
+static bool query_u32(httpd_req_t *req, const char *key, uint32_t *out);
+static bool collect(uint32_t from, uint32_t to, footage_t &fg);
+static const jpeg_tables_t *event_tables(footage_t &fg, const char *event_dir,
+                                         uint8_t k);
+static void release(footage_t &fg);
+static esp_err_t serve(httpd_req_t *req, footage_t &fg,
+                       const std::vector<const footage_frame_t *> &parts,
+                       const char *type);
+static bool parse_range(const char *hdr, uint32_t total, uint32_t *first,
+                        uint32_t *last);
+static void layout_etag(const std::vector<const footage_frame_t *> &parts,
+                        char *out, size_t len);
+
+void footage_server_start() {
+#if CONFIG_FOOTAGE_SERVER_PORT
+  httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+  config.server_port = CONFIG_FOOTAGE_SERVER_PORT;
+  // Only used by this server, must not clash with other instances
+  config.ctrl_port = CONFIG_FOOTAGE_SERVER_PORT + 1;
+  config.stack_size = 8192;
+  config.task_priority = 2;
+
+  if (httpd_start(&footage_httpd, &config) != ESP_OK) {
+    Serial.println("Failed to start footage server");
+    return;
+  }
+
+  httpd_uri_t list_uri = {"/footage/list", HTTP_GET, list_handler, NULL};
+  httpd_uri_t window_uri = {"/footage/window", HTTP_GET, window_handler, NULL};
+  httpd_uri_t frame_uri = {"/footage/frame", HTTP_GET, frame_handler, NULL};
+  httpd_register_uri_handler(footage_httpd, &list_uri);
+  httpd_register_uri_handler(footage_httpd, &window_uri);
+  httpd_register_uri_handler(footage_httpd, &frame_uri);
+
+  Serial.printf("Footage server listening on port %d\n",
+                CONFIG_FOOTAGE_SERVER_PORT);
+#endif
+}
+
+static esp_err_t list_handler(httpd_req_t *req) {
+  std::vector<const footage_frame_t *> parts;
+  char line[64];
+  char etag[16];
+  uint32_t from, to;
+  uint32_t offset = 0;
+  footage_t fg;
+
+  if (!query_u32(req, "from", &from) || !query_u32(req, "to", &to) ||
+      to <= from || to - from > FOOTAGE_MAX_SECONDS) {
+    return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Bad time range");
+  }
+
+  collect(from, to, fg);
+  // Same tag as the window, for it to be pulled with If-Range
+  for (const footage_frame_t &f : fg.frames) {
+    if (f.size > 0) parts.push_back(&f);
+  }
+  layout_etag(parts, etag, sizeof(etag));
+  httpd_resp_set_type(req, "text/plain");
+  httpd_resp_set_hdr(req, "ETag", etag);
+  for (const footage_frame_t &f : fg.frames) {
+    snprintf(line, sizeof(line), "%lu %u %u %lu %lu\n",
+             (unsigned long)f.epoch, f.frame, f.ms, (unsigned long)f.length,
+             (unsigned long)offset);
+    offset += f.length;
+    if (httpd_resp_sendstr_chunk(req, line) != ESP_OK) break;
+  }
+  release(fg);
+  return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+static esp_err_t window_handler(httpd_req_t *req) {
+  std::vector<const footage_frame_t *> parts;
+  uint32_t from, to;
+  footage_t fg;
+
+  if (!query_u32(req, "from", &from) || !query_u32(req, "to", &to) ||
+      to <= from || to - from > FOOTAGE_MAX_SECONDS) {
+    return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Bad time range");
+  }
+
+  collect(from, to, fg);
+  for (const footage_frame_t &f : fg.frames) {
+    if (f.size > 0) parts.push_back(&f);
+  }
+  esp_err_t err = serve(req, fg, parts, "application/octet-stream");
+  release(fg);
+  return err;
+}
+
+static esp_err_t frame_handler(httpd_req_t *req) {
+  std::vector<const footage_frame_t *> parts;
+  uint32_t t, n;
+  footage_t fg;
+
+  if (!query_u32(req, "t", &t) || !query_u32(req, "n", &n)) {
+    return httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Bad frame");
+  }
+
+  // A repeat is served as the frame it repeats, which is always
+  // in the same second
+  collect(t, t + 1, fg);
+  const footage_frame_t *found = NULL;
+  for (const footage_frame_t &f : fg.frames) {
+    if (f.frame > n) break;
+    if (f.size > 0) found = &f;
+    if (f.frame == n) break;
+  }
+  if (!found) {
+    release(fg);
+    return httpd_resp_send_404(req);
+  }
+
+  parts.push_back(found);
+  esp_err_t err = serve(req, fg, parts, "image/jpeg");
+  release(fg);
+  return err;
+}
+
+static bool query_u32(httpd_req_t *req, const char *key, uint32_t *out) {
+  char query[128];
+  char value[16];
+  char *end;
+
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK ||
+      httpd_query_key_value(query, key, value, sizeof(value)) != ESP_OK) {
+    return false;
+  }
+  *out = strtoul(value, &end, 10);
+  return end != value && *end == '\0';
+}
+
+// Gather the frames captured in [from, to), oldest first
+static bool collect(uint32_t from, uint32_t to, footage_t &fg) {
+  static frame_index_slot_t info;
+  static archive_frame_t archived[ARCHIVE_MAX_FRAMES_PER_SECOND];
+  footage_second_t sec;
+  int slot;
+
+  for (uint32_t t = from; t < to; t++) {
+    bool from_ring = frame_index_find(t, camera_svc_ring_size(), &info, &slot);
+    sec.archived = false;
+    sec.slot = from_ring ? slot : -1;
+    if (from_ring) {
+      snprintf(sec.dir, sizeof(sec.dir), "%s/%d", CAMERA_FB_ROOT, slot);
+      sec.event_dir[0] = '\0';
+    } else if (!event_outbox_find(t, sec.dir, sec.event_dir, FOOTAGE_PATH_SZ,
+                                  &info)) {
+      // Archived frames are complete JPEGs, repeats included
+      int count = archive_find(t, sec.dir, FOOTAGE_PATH_SZ, archived,
+                               ARCHIVE_MAX_FRAMES_PER_SECOND);
+      if (count == 0) continue;
+      sec.archived = true;
+      fg.seconds.push_back(sec);
+      for (int n = 0; n < count; n++) {
+        fg.frames.push_back({t, (uint16_t)n, archived[n].ms, archived[n].size,
+                             archived[n].size, NULL,
+                             (uint16_t)(fg.seconds.size() - 1),
+                             archived[n].offset});
+      }
+      continue;
+    }
+
+    fg.seconds.push_back(sec);
+    for (int n = 0; n < info.count; n++) {
+      const frame_index_entry_t &e = info.frames[n];
+      if (!e.valid) continue;
+
+      const jpeg_tables_t *tables = NULL;
+      if (e.tables && !e.repeat) {
+        tables = from_ring ? jpeg_tables_get(e.tables)
+                           : event_tables(fg, sec.event_dir, e.tables);
+        // Cannot be put back together
+        if (!tables) continue;
+      }
+      uint32_t length = e.repeat ? 0 : e.size + (tables ? tables->len : 0);
+      fg.frames.push_back({t, (uint16_t)n, e.ms, e.repeat ? 0 : e.size, length,
+                           tables, (uint16_t)(fg.seconds.size() - 1), 0});
+    }
+  }
+  return !fg.frames.empty();
+}
+
+static const jpeg_tables_t *event_tables(footage_t &fg, const char *event_dir,
+                                         uint8_t k) {
+  String path = String(event_dir) + "/tables" + String(k);
+
+  for (const footage_tables_t &l : fg.loaded) {
+    if (l.path == path) return l.tables;
+  }
+
+  jpeg_tables_t *t = (jpeg_tables_t *)pvPortMalloc(sizeof(jpeg_tables_t));
+  if (!t) return NULL;
+  if (!jpeg_tables_load(t, path.c_str())) {
+    vPortFree(t);
+    return NULL;
+  }
+  fg.loaded.push_back({path, t});
+  return t;
+}
+
+static void release(footage_t &fg) {
+  for (footage_tables_t &l : fg.loaded) {
+    vPortFree(l.tables);
+  }
+  fg.loaded.clear();
+}
+
+/**
+ * @brief Send `parts` back to back, or the requested byte range of them
+ * @note Frames are read from the card straight into a single chunk
+ * buffer, nothing is held in memory in between
+ */
+static esp_err_t serve(httpd_req_t *req, footage_t &fg,
+                       const std::vector<const footage_frame_t *> &parts,
+                       const char *type) {
+  static char chunk[FOOTAGE_CHUNK_SZ];
+  char range[64];
+  char if_range[24];
+  char etag[16];
+  char content_range[48];
+  uint32_t total = 0;
+  uint32_t first, last;
+
+  for (const footage_frame_t *f : parts) total += f->length;
+  if (total == 0) {
+    return httpd_resp_send_404(req);
+  }
+
+  first = 0;
+  last = total - 1;
+  layout_etag(parts, etag, sizeof(etag));
+  httpd_resp_set_type(req, type);
+  httpd_resp_set_hdr(req, "Accept-Ranges", "bytes");
+  httpd_resp_set_hdr(req, "ETag", etag);
+  bool ranged = httpd_req_get_hdr_value_str(req, "Range", range,
+                                            sizeof(range)) == ESP_OK;
+  // Offsets move as seconds go from the ring buffer to the outbox
+  // and the archive. Resuming against another layout would splice
+  // two of them together, it gets the whole response instead
+  if (ranged && httpd_req_get_hdr_value_len(req, "If-Range") > 0 &&
+      (httpd_req_get_hdr_value_str(req, "If-Range", if_range,
+                                   sizeof(if_range)) != ESP_OK ||
+       strcmp(if_range, etag) != 0)) {
+    ranged = false;
+  }
+  if (ranged) {
+    if (!parse_range(range, total, &first, &last)) {
+      snprintf(content_range, sizeof(content_range), "bytes */%lu",
+               (unsigned long)total);
+      httpd_resp_set_status(req, "416 Range Not Satisfiable");
+      httpd_resp_set_hdr(req, "Content-Range", content_range);
+      return httpd_resp_send(req, NULL, 0);
+    }
+    snprintf(content_range, sizeof(content_range), "bytes %lu-%lu/%lu",
+             (unsigned long)first, (unsigned long)last, (unsigned long)total);
+    httpd_resp_set_status(req, "206 Partial Content");
+    httpd_resp_set_hdr(req, "Content-Range", content_range);
+  }
+
+  uint32_t pos = 0;  // Offset of the current part
+  for (const footage_frame_t *f : parts) {
+    uint32_t start = pos;
+    pos += f->length;
+    if (pos <= first) continue;
+    if (start > last) break;
+
+    const footage_second_t &sec = fg.seconds[f->second];
+    char path[FOOTAGE_PATH_SZ + 16];
+    if (sec.archived) {
+      snprintf(path, sizeof(path), "%s", sec.dir);
+    } else {
+      snprintf(path, sizeof(path), "%s/%u.jpg", sec.dir, f->frame);
+    }
+    fs::File file;
+    if (sec.slot < 0 || frame_index_epoch(sec.slot) == f->epoch) {
+      file = SD_MMC.open(path, FILE_READ);
+    }
+    if (!file || !file.seek(f->offset)) {
+      // Evicted or overwritten while being served
+      LOG_W("Footage server: %s is gone", path);
+      if (file) file.close();
+      break;
+    }
+
+    // Without any runs to insert, this just reads the file
+    JpegExpandStream src(file, f->tables ? *f->tables : no_tables);
+
+    // Skip to the start of the range, then send up to its end
+    uint32_t skip = first > start ? first - start : 0;
+    uint32_t remaining = min(last + 1, pos) - (start + skip);
+    while (skip > 0) {
+      size_t got = src.readBytes(chunk, min<uint32_t>(skip, sizeof(chunk)));
+      if (got == 0) break;
+      skip -= got;
+    }
+    while (remaining > 0) {
+      size_t got =
+          src.readBytes(chunk, min<uint32_t>(remaining, sizeof(chunk)));
+      if (got == 0) break;
+      if (httpd_resp_send_chunk(req, chunk, got) != ESP_OK) break;
+      remaining -= got;
+    }
+    file.close();
+    if (remaining > 0) {
+      // Client went away, or the file was cut short
+      return ESP_FAIL;
+    }
+    // The ring buffer reuses slot paths. A frame overwritten while
+    // it was read was sent with another frame's bytes
+    if (sec.slot >= 0 && frame_index_epoch(sec.slot) != f->epoch) {
+      LOG_W("Footage server: %s was overwritten", path);
+      return ESP_FAIL;
+    }
+  }
+  return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// Single ranges only: "bytes=a-b", "bytes=a-" and "bytes=-n"
+static bool parse_range(const char *hdr, uint32_t total, uint32_t *first,
+                        uint32_t *last) {
+  unsigned long a, b;
+
+  if (strncmp(hdr, "bytes=", 6) != 0 || strchr(hdr, ',')) return false;
+  hdr += 6;
+
+  if (sscanf(hdr, "-%lu", &b) == 1) {
+    if (b == 0) return false;
+    *first = b >= total ? 0 : total - b;
+    *last = total - 1;
+    return true;
+  }
+  int fields = sscanf(hdr, "%lu-%lu", &a, &b);
+  if (fields < 1 || a >= total) return false;
+  *first = a;
+  *last = (fields == 2 && b < total) ? b : total - 1;
+  return *first <= *last;
+}
+
+// Strong tag of the frames and lengths making up a response (FNV-1a)
+static void layout_etag(const std::vector<const footage_frame_t *> &parts,
+                        char *out, size_t len) {
+  uint32_t h = 2166136261u;
+  auto mix = [&h](uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+      h ^= (v >> (i * 8)) & 0xff;
+      h *= 16777619u;
+    }
+  };
+
+  for (const footage_frame_t *f : parts) {
+    mix(f->epoch);
+    mix(f->frame);
+    mix(f->length);
+  }
+  snprintf(out, len, "\"%08lx\"", (unsigned long)h);
+}
@@ -0,0 +1,114 @@
+#include "frame_index.h"
+
+#include <Arduino.h>
+
+// === Variables ===
+
+static frame_index_slot_t *slots = NULL;
+static int slot_count = 0;
+
+// Slots are small enough to be copied out while holding the lock
+static portMUX_TYPE index_mux = portMUX_INITIALIZER_UNLOCKED;
+
+bool frame_index_init(int max_slots) {
+  size_t sz = sizeof(frame_index_slot_t) * max_slots;
+
+  slots = (frame_index_slot_t *)ps_malloc(sz);
+  if (!slots) slots = (frame_index_slot_t *)malloc(sz);
+  if (!slots) return false;
+
+  memset(slots, 0, sz);
+  slot_count = max_slots;
+  return true;
+}
+
+void frame_index_begin_slot(int slot, uint32_t epoch) {
+  if (slot < 0 || slot >= slot_count) return;
+
+  portENTER_CRITICAL(&index_mux);
+  slots[slot].epoch = epoch;
+  slots[slot].bytes = 0;
+  slots[slot].count = 0;
+  portEXIT_CRITICAL(&index_mux);
+}
+
+void frame_index_add(int slot, int frame_index, uint32_t size, uint16_t ms,
+                     bool valid, bool repeat, uint8_t tables) {
+  if (slot < 0 || slot >= slot_count) return;
+  if (frame_index < 0 || frame_index >= FRAME_INDEX_MAX_FRAMES) return;
+
+  portENTER_CRITICAL(&index_mux);
+  frame_index_slot_t *s = &slots[slot];
+  // Frames dropped before being saved leave invalid gaps
+  while (s->count < frame_index) {
+    s->frames[s->count++] = {0, 0, false, false, false, 0};
+  }
+  s->frames[frame_index] = {size, ms, valid, repeat, false, tables};
+  if (s->count <= frame_index) s->count = frame_index + 1;
+  if (valid) s->bytes += size;
+  portEXIT_CRITICAL(&index_mux);
+}
+
+void frame_index_mark_streamed(int slot, uint32_t epoch, int frame_index) {
+  if (slot < 0 || slot >= slot_count) return;
+  if (frame_index < 0 || frame_index >= FRAME_INDEX_MAX_FRAMES) return;
+
+  portENTER_CRITICAL(&index_mux);
+  frame_index_slot_t *s = &slots[slot];
+  // The slot may have been reused while the frame was in flight
+  if (s->epoch == epoch && frame_index < s->count) {
+    s->frames[frame_index].streamed = true;
+  }
+  portEXIT_CRITICAL(&index_mux);
+}
+
+void frame_index_clear_slot(int slot) {
+  if (slot < 0 || slot >= slot_count) return;
+
+  portENTER_CRITICAL(&index_mux);
+  slots[slot].epoch = 0;
+  slots[slot].bytes = 0;
+  slots[slot].count = 0;
+  portEXIT_CRITICAL(&index_mux);
+}
+
+uint32_t frame_index_epoch(int slot) {
+  if (slot < 0 || slot >= slot_count) return 0;
+  return slots[slot].epoch;
+}
+
+bool frame_index_get(int slot, frame_index_slot_t *out) {
+  if (slot < 0 || slot >= slot_count) return false;
+
+  portENTER_CRITICAL(&index_mux);
+  *out = slots[slot];
+  portEXIT_CRITICAL(&index_mux);
+  return out->epoch != 0;
+}
+
+uint32_t frame_index_tables_used() {
+  uint32_t used = 0;
+
+  // One slot at a time, not to hold off the other core for long
+  for (int i = 0; i < slot_count; i++) {
+    portENTER_CRITICAL(&index_mux);
+    const frame_index_slot_t *s = &slots[i];
+    if (s->epoch != 0) {
+      for (int n = 0; n < s->count; n++) used |= 1u << s->frames[n].tables;
+    }
+    portEXIT_CRITICAL(&index_mux);
+  }
+  return used & ~1u;
+}
+
+bool frame_index_find(uint32_t epoch, int ring_size, frame_index_slot_t *out,
+                      int *slot) {
+  if (epoch == 0 || ring_size <= 0) return false;
+
+  int s = epoch % ring_size;
+  if (!frame_index_get(s, out) || out->epoch != epoch) {
+    return false;
+  }
+  if (slot) *slot = s;
+  return true;
+}
@@ -0,0 +1,144 @@
+#include "frame_pool.h"
+
+#include <Arduino.h>
+#include <stddef.h>
+
+#include "app_config.h"
+#include "esp_timer.h"
+#include "log_ring.h"
+
+// === Local Defines ===
+
+// Size classes are 16KB, 32KB, ..., 512KB
+#define POOL_MIN_SHIFT (14)
+#define POOL_CLASSES (6)
+#define POOL_BUDGET_BYTES ((size_t)CONFIG_FRAME_POOL_BUDGET_KB * 1024)
+#define POOL_STATS_INTERVAL (300)
+
+// === Types ===
+
+typedef struct _pool_buf {
+  struct _pool_buf *next;
+  uint8_t cls;
+  uint8_t data[];
+} pool_buf_t;
+
+typedef struct {
+  pool_buf_t *free_list;
+  uint16_t allocated;
+  uint16_t in_use;
+  uint16_t peak;
+} pool_class_t;
+
+// === Variables ===
+
+static pool_class_t classes[POOL_CLASSES];
+static size_t pool_bytes = 0;
+static portMUX_TYPE pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t stat_copies = 0;
+static uint32_t stat_misses = 0;
+static uint64_t stat_us_total = 0;
+static uint32_t stat_us_max = 0;
+
+// === Local Functions ===
+
+static pool_buf_t *pool_take(int cls);
+static void print_stats();
+
+uint8_t *frame_pool_copy(const uint8_t *src, size_t len) {
+  int cls = 0;
+  while (cls < POOL_CLASSES && ((size_t)1 << (POOL_MIN_SHIFT + cls)) < len) {
+    cls++;
+  }
+  if (cls == POOL_CLASSES) {
+    stat_misses++;
+    return NULL;
+  }
+
+  int64_t t_start = esp_timer_get_time();
+
+  pool_buf_t *b = pool_take(cls);
+  if (!b) {
+    stat_misses++;
+    return NULL;
+  }
+  memcpy(b->data, src, len);
+
+  uint32_t elapsed = (uint32_t)(esp_timer_get_time() - t_start);
+  stat_copies++;
+  stat_us_total += elapsed;
+  if (elapsed > stat_us_max) stat_us_max = elapsed;
+  if (stat_copies + stat_misses >= POOL_STATS_INTERVAL) {
+    print_stats();
+  }
+  return b->data;
+}
+
+void frame_pool_free(uint8_t *buf) {
+  if (!buf) return;
+  pool_buf_t *b = (pool_buf_t *)(buf - offsetof(pool_buf_t, data));
+
+  portENTER_CRITICAL(&pool_mux);
+  b->next = classes[b->cls].free_list;
+  classes[b->cls].free_list = b;
+  classes[b->cls].in_use--;
+  portEXIT_CRITICAL(&pool_mux);
+}
+
+// Reuse a free buffer of the class, or grow the pool if the
+// budget allows it
+static pool_buf_t *pool_take(int cls) {
+  size_t sz = sizeof(pool_buf_t) + ((size_t)1 << (POOL_MIN_SHIFT + cls));
+  pool_class_t *c = &classes[cls];
+  pool_buf_t *b = NULL;
+  bool grow = false;
+
+  portENTER_CRITICAL(&pool_mux);
+  if (c->free_list) {
+    b = c->free_list;
+    c->free_list = b->next;
+  } else if (pool_bytes + sz <= POOL_BUDGET_BYTES) {
+    // Reserve the space now, allocate outside of the lock
+    pool_bytes += sz;
+    grow = true;
+  }
+  portEXIT_CRITICAL(&pool_mux);
+
+  if (grow) {
+    b = (pool_buf_t *)ps_malloc(sz);
+    portENTER_CRITICAL(&pool_mux);
+    if (b) {
+      b->cls = cls;
+      c->allocated++;
+    } else {
+      pool_bytes -= sz;
+    }
+    portEXIT_CRITICAL(&pool_mux);
+  }
+  if (!b) return NULL;
+
+  portENTER_CRITICAL(&pool_mux);
+  c->in_use++;
+  if (c->in_use > c->peak) c->peak = c->in_use;
+  portEXIT_CRITICAL(&pool_mux);
+  return b;
+}
+
+static void print_stats() {
+  LOG_I("Frame pool: %lu copies (avg %lu us, max %lu us), %lu misses, "
+        "%u KB allocated",
+        stat_copies, stat_copies ? (uint32_t)(stat_us_total / stat_copies) : 0,
+        stat_us_max, stat_misses, (unsigned)(pool_bytes / 1024));
+  for (int i = 0; i < POOL_CLASSES; i++) {
+    pool_class_t *c = &classes[i];
+    if (!c->allocated) continue;
+    LOG_I("  %3uKB: %u/%u in use, peak %u",
+          (unsigned)(1 << (POOL_MIN_SHIFT + i - 10)), c->in_use, c->allocated,
+          c->peak);
+  }
+  stat_copies = 0;
+  stat_misses = 0;
+  stat_us_total = 0;
+  stat_us_max = 0;
+}
@@ -0,0 +1,470 @@
+#include "jpeg_crop.h"
+
+#include <Arduino.h>
+#include <stddef.h>
+
+// === Local Defines ===
+
+#define JPEG_MARKER_SOF0 (0xC0)
+#define JPEG_MARKER_SOF1 (0xC1)
+#define JPEG_MARKER_DHT (0xC4)
+#define JPEG_MARKER_SOI (0xD8)
+#define JPEG_MARKER_EOI (0xD9)
+#define JPEG_MARKER_SOS (0xDA)
+#define JPEG_MARKER_DRI (0xDD)
+
+// Baseline frames have at most two tables of each class
+#define CROP_MAX_TABLES (2)
+#define CROP_MAX_COMPS (3)
+// Codes up to this long are decoded with a single lookup
+#define CROP_LOOKUP_BITS (8)
+// Room for DC differences which grow at the edges of the region
+#define CROP_SLACK_BYTES (1024)
+
+// === Types ===
+
+typedef struct {
+  // Decoding, indexed by code length (JPEG spec F.2.2.3)
+  int32_t maxcode[17];
+  int32_t valptr[17];
+  uint16_t mincode[17];
+  // (length << 8) | value of the code starting with the index,
+  // 0 if the code is longer than CROP_LOOKUP_BITS
+  uint16_t lookup[1 << CROP_LOOKUP_BITS];
+  uint8_t vals[256];
+  // Encoding, indexed by value. A size of 0 means there is no code
+  uint16_t code[256];
+  uint8_t size[256];
+  bool defined;
+} crop_huff_t;
+
+typedef struct {
+  uint8_t id;
+  uint8_t h;
+  uint8_t v;
+  uint8_t dc;  // Tables used by the scan
+  uint8_t ac;
+  int pred;      // DC predictor of the input
+  int out_pred;  // and of the output
+} crop_comp_t;
+
+typedef struct {
+  const uint8_t *p;
+  const uint8_t *end;
+  uint32_t acc;  // Next bits, first one in the MSB
+  int bits;
+  bool marker;  // Stopped at a marker, only zeros come after
+} bit_reader_t;
+
+typedef struct {
+  uint8_t *p;
+  uint8_t *end;
+  uint32_t acc;
+  int bits;
+  bool overflow;
+} bit_writer_t;
+
+struct jpeg_crop {
+  crop_huff_t huff[2][CROP_MAX_TABLES];  // [DC / AC][table]
+  uint8_t *buf;
+  size_t buf_size;
+};
+
+// === Local Functions ===
+
+static bool reserve(jpeg_crop_t *c, size_t size);
+static bool huff_build(crop_huff_t *h, const uint8_t *counts,
+                       const uint8_t *vals, int total);
+static bool crop_block(jpeg_crop_t *c, bit_reader_t *br, bit_writer_t *bw,
+                       crop_comp_t *comp, bool keep);
+static void br_fill(bit_reader_t *br);
+static uint32_t br_get(bit_reader_t *br, int n);
+static int br_huff(bit_reader_t *br, const crop_huff_t *h);
+static bool br_restart(bit_reader_t *br);
+static void bw_put(bit_writer_t *bw, uint32_t v, int n);
+static int extend(uint32_t v, int s);
+static int category(int v);
+
+jpeg_crop_t *jpeg_crop_new() {
+  // Tables are looked up for every symbol, keep them in internal RAM
+  return (jpeg_crop_t *)calloc(1, sizeof(jpeg_crop_t));
+}
+
+void jpeg_crop_free(jpeg_crop_t *c) {
+  if (!c) return;
+  free(c->buf);
+  free(c);
+}
+
+bool jpeg_roi_crops(const jpeg_roi_t &roi) {
+  return roi.width > 0 && roi.height > 0 &&
+         (roi.left > 0 || roi.top > 0 || roi.width < 100 || roi.height < 100);
+}
+
+bool jpeg_crop(jpeg_crop_t *c, const uint8_t *buf, size_t len,
+               const jpeg_roi_t &roi, jpeg_crop_out_t *out) {
+  crop_comp_t comps[CROP_MAX_COMPS];
+  int ncomp = 0;
+  uint16_t width = 0;
+  uint16_t height = 0;
+  int restart = 0;
+  size_t pos = 2;
+  size_t scan = 0;
+  size_t out_pos = 2;
+  size_t out_sof = 0;
+
+  if (!jpeg_roi_crops(roi)) return false;
+  if (len < 4 || buf[0] != 0xFF || buf[1] != JPEG_MARKER_SOI) return false;
+  if (!reserve(c, len + CROP_SLACK_BYTES)) return false;
+
+  for (int t = 0; t < CROP_MAX_TABLES; t++) {
+    c->huff[0][t].defined = false;
+    c->huff[1][t].defined = false;
+  }
+  c->buf[0] = 0xFF;
+  c->buf[1] = JPEG_MARKER_SOI;
+
+  // Walk the header segments up to the start of the scan, copying
+  // them as they are except for the frame size and restart interval
+  while (!scan) {
+    if (pos + 4 > len || buf[pos] != 0xFF) return false;
+    uint8_t marker = buf[pos + 1];
+    if (marker == 0xFF) {
+      // Fill byte
+      pos++;
+      continue;
+    }
+
+    size_t seg = 2 + ((buf[pos + 2] << 8) | buf[pos + 3]);
+    if (seg < 4 || pos + seg > len) return false;
+    const uint8_t *d = buf + pos + 4;
+    size_t dlen = seg - 4;
+
+    if (marker == JPEG_MARKER_SOF0 || marker == JPEG_MARKER_SOF1) {
+      if (dlen < 6 || d[0] != 8) return false;
+      height = (d[1] << 8) | d[2];
+      width = (d[3] << 8) | d[4];
+      ncomp = d[5];
+      if (!width || !height || ncomp < 1 || ncomp > CROP_MAX_COMPS ||
+          dlen < 6 + 3 * (size_t)ncomp) {
+        return false;
+      }
+      for (int i = 0; i < ncomp; i++) {
+        comps[i].id = d[6 + 3 * i];
+        comps[i].h = d[7 + 3 * i] >> 4;
+        comps[i].v = d[7 + 3 * i] & 0x0F;
+        if (comps[i].h < 1 || comps[i].h > 2 || comps[i].v < 1 ||
+            comps[i].v > 2) {
+          return false;
+        }
+      }
+      out_sof = out_pos;
+    } else if ((marker & 0xF0) == 0xC0 && marker != JPEG_MARKER_DHT) {
+      // Progressive, lossless or arithmetic coded
+      return false;
+    } else if (marker == JPEG_MARKER_DHT) {
+      while (dlen >= 17) {
+        int cls = d[0] >> 4;
+        int id = d[0] & 0x0F;
+        int total = 0;
+        for (int i = 1; i <= 16; i++) total += d[i];
+        if (cls > 1 || id >= CROP_MAX_TABLES || 17 + (size_t)total > dlen ||
+            !huff_build(&c->huff[cls][id], d + 1, d + 17, total)) {
+          return false;
+        }
+        d += 17 + total;
+        dlen -= 17 + total;
+      }
+    } else if (marker == JPEG_MARKER_DRI) {
+      if (dlen < 2) return false;
+      restart = (d[0] << 8) | d[1];
+      // The output is a single interval
+      pos += seg;
+      continue;
+    } else if (marker == JPEG_MARKER_SOS) {
+      // Only a single scan holding every component
+      if (!ncomp || dlen < 4 + 2 * (size_t)ncomp || d[0] != ncomp) {
+        return false;
+      }
+      for (int i = 0; i < ncomp; i++) {
+        int j = 0;
+        while (j < ncomp && comps[j].id != d[1 + 2 * i]) j++;
+        if (j == ncomp) return false;
+        comps[j].dc = d[2 + 2 * i] >> 4;
+        comps[j].ac = d[2 + 2 * i] & 0x0F;
+        if (comps[j].dc >= CROP_MAX_TABLES || comps[j].ac >= CROP_MAX_TABLES ||
+            !c->huff[0][comps[j].dc].defined ||
+            !c->huff[1][comps[j].ac].defined) {
+          return false;
+        }
+      }
+      const uint8_t *sel = d + 1 + 2 * ncomp;
+      if (sel[0] != 0 || sel[1] != 63 || sel[2] != 0) return false;
+      scan = pos + seg;
+    }
+
+    memcpy(c->buf + out_pos, buf + pos, seg);
+    out_pos += seg;
+    pos += seg;
+  }
+  if (!out_sof) return false;
+
+  // A single component is coded one block at a time, whatever its
+  // sampling factors say
+  int hmax = 1, vmax = 1;
+  if (ncomp == 1) {
+    comps[0].h = comps[0].v = 1;
+  }
+  for (int i = 0; i < ncomp; i++) {
+    hmax = max<int>(hmax, comps[i].h);
+    vmax = max<int>(vmax, comps[i].v);
+    comps[i].pred = 0;
+    comps[i].out_pred = 0;
+  }
+
+  // Region in whole MCUs, the right and bottom edges may end
+  // partway through one like the frame itself
+  const int mcu_w = 8 * hmax;
+  const int mcu_h = 8 * vmax;
+  const int cols = (width + mcu_w - 1) / mcu_w;
+  const int rows = (height + mcu_h - 1) / mcu_h;
+  const int right = min(100, roi.left + roi.width);
+  const int bottom = min(100, roi.top + roi.height);
+  const int x0 = min(cols - 1, (int)((uint32_t)width * roi.left / 100 / mcu_w));
+  const int y0 = min(rows - 1, (int)((uint32_t)height * roi.top / 100 / mcu_h));
+  const int x1 = constrain((int)(((uint32_t)width * right / 100 + mcu_w - 1) /
+                                 mcu_w),
+                           x0 + 1, cols);
+  const int y1 = constrain((int)(((uint32_t)height * bottom / 100 + mcu_h - 1) /
+                                 mcu_h),
+                           y0 + 1, rows);
+  if (x0 == 0 && y0 == 0 && x1 == cols && y1 == rows) return false;
+
+  out->width = min<int>(x1 * mcu_w, width) - x0 * mcu_w;
+  out->height = min<int>(y1 * mcu_h, height) - y0 * mcu_h;
+  c->buf[out_sof + 5] = out->height >> 8;
+  c->buf[out_sof + 6] = out->height & 0xFF;
+  c->buf[out_sof + 7] = out->width >> 8;
+  c->buf[out_sof + 8] = out->width & 0xFF;
+
+  // Every MCU up to the last row of the region is walked, since
+  // where one starts is only known once the previous one is decoded
+  bit_reader_t br = {buf + scan, buf + len, 0, 0, false};
+  bit_writer_t bw = {c->buf + out_pos, c->buf + c->buf_size - 2, 0, 0, false};
+  int mcu = 0;
+  for (int my = 0; my < y1; my++) {
+    for (int mx = 0; mx < cols; mx++, mcu++) {
+      if (restart && mcu && mcu % restart == 0) {
+        if (!br_restart(&br)) return false;
+        for (int i = 0; i < ncomp; i++) comps[i].pred = 0;
+      }
+
+      bool keep = my >= y0 && mx >= x0 && mx < x1;
+      for (int i = 0; i < ncomp; i++) {
+        for (int b = 0; b < comps[i].h * comps[i].v; b++) {
+          if (!crop_block(c, &br, &bw, &comps[i], keep)) return false;
+        }
+      }
+    }
+  }
+
+  // Pad the last byte with ones
+  if (bw.bits) bw_put(&bw, 0xFF, 8 - bw.bits);
+  if (bw.overflow) return false;
+  bw.p[0] = 0xFF;
+  bw.p[1] = JPEG_MARKER_EOI;
+
+  out->buf = c->buf;
+  out->len = bw.p + 2 - c->buf;
+  return true;
+}
+
+// Grown with some headroom, frame sizes change from frame to frame
+static bool reserve(jpeg_crop_t *c, size_t size) {
+  if (size <= c->buf_size) return true;
+  size += size / 4;
+  free(c->buf);
+  c->buf = (uint8_t *)ps_malloc(size);
+  if (!c->buf) c->buf = (uint8_t *)malloc(size);
+  c->buf_size = c->buf ? size : 0;
+  return c->buf != NULL;
+}
+
+// Both directions of a DHT table (JPEG spec C.2 and F.2.2.3)
+static bool huff_build(crop_huff_t *h, const uint8_t *counts,
+                       const uint8_t *vals, int total) {
+  uint32_t code = 0;
+  int k = 0;
+
+  if (total > 256) return false;
+  memset(h->lookup, 0, sizeof(h->lookup));
+  memset(h->size, 0, sizeof(h->size));
+  memcpy(h->vals, vals, total);
+
+  for (int l = 1; l <= 16; l++) {
+    h->valptr[l] = k;
+    h->mincode[l] = code;
+    for (int i = 0; i < counts[l - 1]; i++, k++, code++) {
+      uint8_t v = vals[k];
+      h->code[v] = code;
+      h->size[v] = l;
+      if (l <= CROP_LOOKUP_BITS) {
+        int shift = CROP_LOOKUP_BITS - l;
+        for (int f = 0; f < (1 << shift); f++) {
+          h->lookup[(code << shift) | f] = (l << 8) | v;
+        }
+      }
+    }
+    h->maxcode[l] = counts[l - 1] ? (int32_t)code - 1 : -1;
+    if (code > (1u << l)) return false;
+    code <<= 1;
+  }
+  h->defined = true;
+  return true;
+}
+
+/**
+ * @brief Walk one 8x8 block, re-coding it if it is kept
+ * @note The AC coefficients of a kept block are written with the same
+ * codes they were read with. Only the DC difference is computed again
+ */
+static bool crop_block(jpeg_crop_t *c, bit_reader_t *br, bit_writer_t *bw,
+                       crop_comp_t *comp, bool keep) {
+  const crop_huff_t *dc = &c->huff[0][comp->dc];
+  const crop_huff_t *ac = &c->huff[1][comp->ac];
+
+  int s = br_huff(br, dc);
+  if (s < 0 || s > 11) return false;
+  comp->pred += extend(br_get(br, s), s);
+
+  if (keep) {
+    int diff = comp->pred - comp->out_pred;
+    int n = category(diff);
+    if (!dc->size[n]) return false;
+    comp->out_pred = comp->pred;
+    bw_put(bw, dc->code[n], dc->size[n]);
+    bw_put(bw, diff < 0 ? diff - 1 : diff, n);
+  }
+
+  for (int k = 1; k < 64; k++) {
+    int rs = br_huff(br, ac);
+    if (rs < 0) return false;
+    int run = rs >> 4;
+    int n = rs & 0x0F;
+    uint32_t bits = br_get(br, n);
+
+    if (keep) {
+      bw_put(bw, ac->code[rs], ac->size[rs]);
+      bw_put(bw, bits, n);
+    }
+
+    if (n == 0) {
+      // End of block, or a run of 16 zeros
+      if (run != 15) break;
+      k += 15;
+    } else {
+      k += run;
+      if (k > 63) return false;
+    }
+  }
+  return true;
+}
+
+static void br_fill(bit_reader_t *br) {
+  while (br->bits <= 24) {
+    uint32_t b = 0;
+    if (!br->marker && br->p < br->end) {
+      b = br->p[0];
+      if (b != 0xFF) {
+        br->p++;
+      } else if (br->p + 1 < br->end && br->p[1] == 0x00) {
+        // Stuffed byte
+        br->p += 2;
+      } else {
+        br->marker = true;
+        b = 0;
+      }
+    }
+    br->acc |= b << (24 - br->bits);
+    br->bits += 8;
+  }
+}
+
+static uint32_t br_get(bit_reader_t *br, int n) {
+  if (n == 0) return 0;
+  br_fill(br);
+  uint32_t v = br->acc >> (32 - n);
+  br->acc <<= n;
+  br->bits -= n;
+  return v;
+}
+
+static int br_huff(bit_reader_t *br, const crop_huff_t *h) {
+  br_fill(br);
+  uint16_t e = h->lookup[br->acc >> (32 - CROP_LOOKUP_BITS)];
+  if (e) {
+    br->acc <<= e >> 8;
+    br->bits -= e >> 8;
+    return e & 0xFF;
+  }
+
+  for (int l = CROP_LOOKUP_BITS + 1; l <= 16; l++) {
+    int32_t code = br->acc >> (32 - l);
+    if (code <= h->maxcode[l]) {
+      br->acc <<= l;
+      br->bits -= l;
+      return h->vals[h->valptr[l] + code - h->mincode[l]];
+    }
+  }
+  return -1;
+}
+
+// Drop the padding and the marker which end a restart interval
+static bool br_restart(bit_reader_t *br) {
+  br->acc = 0;
+  br->bits = 0;
+  br->marker = false;
+  while (br->p + 1 < br->end && br->p[0] == 0xFF && br->p[1] == 0xFF) {
+    br->p++;
+  }
+  if (br->p + 1 >= br->end || br->p[0] != 0xFF ||
+      (br->p[1] & 0xF8) != 0xD0) {
+    return false;
+  }
+  br->p += 2;
+  return true;
+}
+
+static void bw_put(bit_writer_t *bw, uint32_t v, int n) {
+  if (n == 0) return;
+  bw->acc = (bw->acc << n) | (v & ((1u << n) - 1));
+  bw->bits += n;
+  while (bw->bits >= 8) {
+    uint8_t b = bw->acc >> (bw->bits - 8);
+    bw->bits -= 8;
+    // Keeps going to leave the state consistent, the result is dropped
+    if (bw->p + 2 > bw->end) {
+      bw->overflow = true;
+      continue;
+    }
+    *bw->p++ = b;
+    if (b == 0xFF) *bw->p++ = 0x00;
+  }
+}
+
+// Value of `s` extra bits (JPEG spec F.2.2.1)
+static int extend(uint32_t v, int s) {
+  if (s == 0) return 0;
+  return v < (1u << (s - 1)) ? (int)v - (1 << s) + 1 : (int)v;
+}
+
+// Number of bits needed for the magnitude of `v`
+static int category(int v) {
+  unsigned a = v < 0 ? -v : v;
+  int n = 0;
+  while (a) {
+    n++;
+    a >>= 1;
+  }
+  return n;
+}
@@ -0,0 +1,344 @@
+#include "jpeg_tables.h"
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD_MMC.h>
+#include <stddef.h>
+
+#include "frame_index.h"
+#include "log_ring.h"
+
+// === Local Defines ===
+
+#define JPEG_MARKER_SOI (0xD8)
+#define JPEG_MARKER_SOS (0xDA)
+#define JPEG_MARKER_DQT (0xDB)
+#define JPEG_MARKER_DHT (0xC4)
+#define JPEG_STATS_INTERVAL (300)
+// Looking for an unused set goes over the whole frame index
+#define JPEG_REUSE_INTERVAL_MS (1000)
+
+// === Variables ===
+
+// Sets are never freed, so readers only need to look at
+// `set_count`. A set is only overwritten once no frame in the
+// ring buffer refers to it anymore
+static jpeg_tables_t *sets[JPEG_TABLES_MAX_SETS];
+static volatile uint8_t set_count = 0;
+static uint32_t last_reuse_ms = 0;
+static bool full_reported = false;
+
+static uint32_t stat_frames = 0;
+static uint32_t stat_full = 0;
+static uint64_t stat_bytes = 0;
+static uint64_t stat_saved = 0;
+
+// === Local Functions ===
+
+JpegStripStream::JpegStripStream(const uint8_t *buf, const jpeg_strip_t &strip)
+    : buf(buf), strip(strip), pos(0), left(strip.len), run(0) {}
+
+int JpegStripStream::available() { return left; }
+
+int JpegStripStream::read() {
+  char c;
+  return readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+}
+
+int JpegStripStream::peek() {
+  skip_runs();
+  return left ? buf[pos] : -1;
+}
+
+size_t JpegStripStream::readBytes(char *out, size_t len) {
+  size_t n = 0;
+
+  while (n < len && left > 0) {
+    skip_runs();
+    size_t chunk = min<size_t>(len - n, left);
+    if (run < strip.run_count) {
+      chunk = min<size_t>(chunk, strip.runs[run].offset - pos);
+    }
+    memcpy(out + n, buf + pos, chunk);
+    n += chunk;
+    pos += chunk;
+    left -= chunk;
+  }
+  return n;
+}
+
+// Step over the tables which start at the current position
+void JpegStripStream::skip_runs() {
+  while (run < strip.run_count && pos == strip.runs[run].offset) {
+    pos += strip.runs[run].len;
+    run++;
+  }
+}
+
+static bool same_tables(const jpeg_tables_t *a, const jpeg_tables_t *b);
+static uint8_t find_or_register(const jpeg_tables_t *t);
+static uint8_t reuse(const jpeg_tables_t *t);
+static void print_stats();
+
+bool jpeg_tables_strip(const uint8_t *buf, size_t len, jpeg_strip_t *strip) {
+  // Candidate table set, only used by the saving task
+  static jpeg_tables_t cand;
+
+  stat_frames++;
+  stat_bytes += len;
+  if (stat_frames >= JPEG_STATS_INTERVAL) {
+    print_stats();
+  }
+
+  if (!jpeg_tables_split(buf, len, strip, &cand)) {
+    stat_full++;
+    return false;
+  }
+
+  strip->tables = find_or_register(&cand);
+  if (strip->tables == 0) {
+    strip->run_count = 0;
+    strip->len = len;
+    stat_full++;
+    return false;
+  }
+  stat_saved += len - strip->len;
+  return true;
+}
+
+bool jpeg_tables_split(const uint8_t *buf, size_t len, jpeg_strip_t *strip,
+                       jpeg_tables_t *tables) {
+  size_t pos = 2;
+  size_t removed = 0;
+  bool in_run = false;
+  bool found_sos = false;
+
+  strip->tables = 0;
+  strip->run_count = 0;
+  strip->len = len;
+  tables->run_count = 0;
+  tables->len = 0;
+
+  if (len < 4 || buf[0] != 0xFF || buf[1] != JPEG_MARKER_SOI) {
+    return false;
+  }
+
+  // Walk the header segments up to the start of the scan
+  while (pos + 4 <= len && buf[pos] == 0xFF) {
+    uint8_t marker = buf[pos + 1];
+    if (marker == 0xFF) {
+      // Fill byte
+      pos++;
+      in_run = false;
+      continue;
+    }
+    if (marker == JPEG_MARKER_SOS) {
+      found_sos = true;
+      break;
+    }
+
+    size_t seg = 2 + ((buf[pos + 2] << 8) | buf[pos + 3]);
+    if (pos + seg > len) break;
+
+    if (marker == JPEG_MARKER_DQT || marker == JPEG_MARKER_DHT) {
+      if (tables->len + seg > JPEG_TABLES_MAX_BYTES) break;
+      if (!in_run) {
+        if (tables->run_count == JPEG_TABLES_MAX_RUNS) break;
+        tables->runs[tables->run_count].at = pos - removed;
+        tables->runs[tables->run_count].len = 0;
+        strip->runs[tables->run_count].offset = pos;
+        strip->runs[tables->run_count].len = 0;
+        tables->run_count++;
+        in_run = true;
+      }
+      memcpy(tables->data + tables->len, buf + pos, seg);
+      tables->len += seg;
+      tables->runs[tables->run_count - 1].len += seg;
+      strip->runs[tables->run_count - 1].len += seg;
+      removed += seg;
+    } else {
+      in_run = false;
+    }
+    pos += seg;
+  }
+
+  if (!found_sos || tables->run_count == 0) {
+    return false;
+  }
+  strip->run_count = tables->run_count;
+  strip->len = len - removed;
+  return true;
+}
+
+size_t jpeg_tables_write(fs::File &file, const uint8_t *buf,
+                         const jpeg_strip_t *strip) {
+  size_t full_len = strip->len;
+  size_t pos = 0;
+  size_t written = 0;
+
+  for (int i = 0; i < strip->run_count; i++) {
+    full_len += strip->runs[i].len;
+  }
+  for (int i = 0; i < strip->run_count; i++) {
+    written += file.write(buf + pos, strip->runs[i].offset - pos);
+    pos = strip->runs[i].offset + strip->runs[i].len;
+  }
+  written += file.write(buf + pos, full_len - pos);
+  return written;
+}
+
+const jpeg_tables_t *jpeg_tables_get(uint8_t id) {
+  if (id == 0 || id > set_count) return NULL;
+  return sets[id - 1];
+}
+
+bool jpeg_tables_save(const jpeg_tables_t *tables, const char *path) {
+  size_t sz = offsetof(jpeg_tables_t, data) + tables->len;
+
+  fs::File file = SD_MMC.open(path, FILE_WRITE);
+  if (!file) return false;
+  size_t written = file.write((const uint8_t *)tables, sz);
+  file.close();
+  return written == sz;
+}
+
+bool jpeg_tables_load(jpeg_tables_t *tables, const char *path) {
+  const size_t head = offsetof(jpeg_tables_t, data);
+
+  fs::File file = SD_MMC.open(path, FILE_READ);
+  if (!file) return false;
+  bool ok = file.read((uint8_t *)tables, head) == head &&
+            tables->run_count <= JPEG_TABLES_MAX_RUNS &&
+            tables->len <= JPEG_TABLES_MAX_BYTES &&
+            file.read(tables->data, tables->len) == tables->len;
+  file.close();
+  return ok;
+}
+
+size_t jpeg_tables_format_runs(const jpeg_tables_t *tables, char *buf,
+                               size_t len) {
+  size_t n = 0;
+
+  buf[0] = '\0';
+  for (int i = 0; i < tables->run_count && n < len; i++) {
+    n += snprintf(buf + n, len - n, "%s%lu:%u", i ? "," : "",
+                  (unsigned long)tables->runs[i].at, tables->runs[i].len);
+  }
+  return min(n, len - 1);
+}
+
+JpegExpandStream::JpegExpandStream(Stream &src, const jpeg_tables_t &tables)
+    : src(src), tables(tables), src_pos(0), run(0), run_pos(0), data_pos(0) {}
+
+size_t JpegExpandStream::expanded_len(size_t len, const jpeg_tables_t &tables) {
+  return len + tables.len;
+}
+
+int JpegExpandStream::available() {
+  return src.available() + (tables.len - data_pos - run_pos);
+}
+
+int JpegExpandStream::read() {
+  char c;
+  return readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+}
+
+int JpegExpandStream::peek() {
+  if (run < tables.run_count && src_pos == tables.runs[run].at) {
+    return tables.data[data_pos + run_pos];
+  }
+  return src.peek();
+}
+
+size_t JpegExpandStream::readBytes(char *buf, size_t len) {
+  size_t n = 0;
+
+  while (n < len) {
+    // Put the tables back where they were taken from
+    if (run < tables.run_count && src_pos == tables.runs[run].at) {
+      size_t chunk = min<size_t>(len - n, tables.runs[run].len - run_pos);
+      memcpy(buf + n, tables.data + data_pos + run_pos, chunk);
+      n += chunk;
+      run_pos += chunk;
+      if (run_pos == tables.runs[run].len) {
+        data_pos += run_pos;
+        run_pos = 0;
+        run++;
+      }
+      continue;
+    }
+
+    size_t want = len - n;
+    if (run < tables.run_count) {
+      want = min<size_t>(want, tables.runs[run].at - src_pos);
+    }
+    size_t got = src.readBytes(buf + n, want);
+    if (got == 0) break;
+    n += got;
+    src_pos += got;
+  }
+  return n;
+}
+
+static bool same_tables(const jpeg_tables_t *a, const jpeg_tables_t *b) {
+  if (a->run_count != b->run_count || a->len != b->len) return false;
+  for (int i = 0; i < a->run_count; i++) {
+    if (a->runs[i].at != b->runs[i].at || a->runs[i].len != b->runs[i].len) {
+      return false;
+    }
+  }
+  return memcmp(a->data, b->data, a->len) == 0;
+}
+
+static uint8_t find_or_register(const jpeg_tables_t *t) {
+  for (int i = 0; i < set_count; i++) {
+    if (same_tables(sets[i], t)) return i + 1;
+  }
+
+  if (set_count == JPEG_TABLES_MAX_SETS) return reuse(t);
+
+  jpeg_tables_t *copy = (jpeg_tables_t *)ps_malloc(sizeof(jpeg_tables_t));
+  if (!copy) copy = (jpeg_tables_t *)malloc(sizeof(jpeg_tables_t));
+  if (!copy) return 0;
+  memcpy(copy, t, sizeof(jpeg_tables_t));
+  sets[set_count] = copy;
+  set_count = set_count + 1;
+
+  LOG_I("New JPEG table set %u (%u bytes)", set_count, t->len);
+  return set_count;
+}
+
+static uint8_t reuse(const jpeg_tables_t *t) {
+  uint32_t now = millis();
+  if (last_reuse_ms != 0 && now - last_reuse_ms < JPEG_REUSE_INTERVAL_MS) {
+    return 0;
+  }
+  last_reuse_ms = now;
+
+  const uint32_t used = frame_index_tables_used();
+  for (int i = 0; i < set_count; i++) {
+    if (used & (1u << (i + 1))) continue;
+    memcpy(sets[i], t, sizeof(jpeg_tables_t));
+    full_reported = false;
+    LOG_I("Replaced JPEG table set %u (%u bytes)", i + 1, t->len);
+    return i + 1;
+  }
+
+  if (!full_reported) {
+    LOG_W("All %d JPEG table sets are in use, storing frames in full",
+          JPEG_TABLES_MAX_SETS);
+    full_reported = true;
+  }
+  return 0;
+}
+
+static void print_stats() {
+  LOG_I("JPEG tables: %lu frames (%lu in full), saved %llu of %llu bytes "
+        "(%u%%)",
+        stat_frames, stat_full, stat_saved, stat_bytes,
+        stat_bytes ? (unsigned)(stat_saved * 100 / stat_bytes) : 0);
+  stat_frames = 0;
+  stat_full = 0;
+  stat_bytes = 0;
+  stat_saved = 0;
+}
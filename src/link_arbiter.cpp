@@ -0,0 +1,182 @@
+#include "link_arbiter.h"
+
+#include <Arduino.h>
+
+#include "log_ring.h"
+#include "perf_config.h"
+
+// === Local Defines ===
+
+#define LINK_STATS_INTERVAL_MS (30000)
+// The bucket holds at most one second worth of budget
+#define LINK_BUCKET_MS (1000)
+
+// === Types ===
+
+typedef struct {
+  // Bytes which can be sent right away. Goes negative when a
+  // transfer is larger than what was available
+  int64_t tokens;
+  uint32_t last_ms;
+} link_bucket_t;
+
+typedef struct {
+  uint32_t frames;
+  uint32_t skipped;
+  uint64_t bytes;
+  uint32_t busy_ms;
+} link_stats_t;
+
+// === Variables ===
+
+static portMUX_TYPE link_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Shared by both classes, refilled at "LinkBudgetKBps"
+static link_bucket_t link_bucket = {0, 0};
+// Uploads only, refilled at the rate asked for by the coordinator
+static link_bucket_t upload_bucket = {0, 0};
+static volatile uint32_t upload_rate_kbps = 0;
+
+static volatile bool upload_active = false;
+// An upload is blocked on the bucket, the stream has to back off
+static volatile bool upload_waiting = false;
+static uint32_t last_stream_ms = 0;
+
+static link_stats_t stats[2];
+static uint32_t stats_start_ms = 0;
+
+// === Local Functions ===
+
+static void refill(link_bucket_t *b, int64_t rate, uint32_t now);
+static uint32_t bucket_wait_ms(const link_bucket_t *b, int64_t rate);
+static bool min_rate_due(uint32_t now);
+static void print_stats(uint32_t now);
+
+bool link_acquire(LINK_CLASS cls, size_t bytes) {
+  const int64_t link_rate = perfConfig.link_budget_kbps;
+
+  if (cls == LINK_CLASS::UPLOAD) {
+    for (;;) {
+      uint32_t now = millis();
+      uint32_t wait_ms;
+
+      portENTER_CRITICAL(&link_mux);
+      refill(&link_bucket, link_rate, now);
+      refill(&upload_bucket, upload_rate_kbps, now);
+      wait_ms = max(bucket_wait_ms(&link_bucket, link_rate),
+                    bucket_wait_ms(&upload_bucket, upload_rate_kbps));
+      if (wait_ms == 0) {
+        link_bucket.tokens -= bytes;
+        upload_bucket.tokens -= bytes;
+        upload_waiting = false;
+      } else {
+        upload_waiting = true;
+      }
+      portEXIT_CRITICAL(&link_mux);
+
+      if (wait_ms == 0) return true;
+      vTaskDelay(pdMS_TO_TICKS(min<uint32_t>(wait_ms, LINK_BUCKET_MS)));
+    }
+  }
+
+  bool allowed;
+  uint32_t now = millis();
+
+  portENTER_CRITICAL(&link_mux);
+  refill(&link_bucket, link_rate, now);
+  if (upload_active && perfConfig.stream_policy == LINK_POLICY_PAUSE) {
+    allowed = false;
+  } else if (min_rate_due(now)) {
+    // Guaranteed preview rate, borrows from the bucket if needed
+    allowed = true;
+  } else if (upload_active && perfConfig.stream_policy == LINK_POLICY_THIN) {
+    allowed = false;
+  } else {
+    allowed = !upload_waiting && bucket_wait_ms(&link_bucket, link_rate) == 0;
+  }
+
+  if (allowed) {
+    link_bucket.tokens -= bytes;
+    last_stream_ms = now;
+  } else {
+    stats[(int)LINK_CLASS::STREAM].skipped++;
+  }
+  portEXIT_CRITICAL(&link_mux);
+  return allowed;
+}
+
+void link_report(LINK_CLASS cls, size_t bytes, uint32_t elapsed_ms) {
+  uint32_t now = millis();
+  bool print = false;
+
+  portENTER_CRITICAL(&link_mux);
+  link_stats_t *s = &stats[(int)cls];
+  s->frames++;
+  s->bytes += bytes;
+  s->busy_ms += elapsed_ms;
+  if (now - stats_start_ms >= LINK_STATS_INTERVAL_MS) {
+    print = true;
+  }
+  portEXIT_CRITICAL(&link_mux);
+
+  if (print) print_stats(now);
+}
+
+void link_set_upload_rate(uint32_t kbps) { upload_rate_kbps = kbps; }
+
+void link_upload_begin() { upload_active = true; }
+
+void link_upload_end() {
+  upload_active = false;
+  upload_waiting = false;
+}
+
+// Must be called with `link_mux` held. `rate` is in KB/s, which is
+// close enough to bytes per ms
+static void refill(link_bucket_t *b, int64_t rate, uint32_t now) {
+  uint32_t elapsed = now - b->last_ms;
+
+  b->last_ms = now;
+  if (rate == 0) {
+    b->tokens = 0;
+    return;
+  }
+  b->tokens = min<int64_t>(b->tokens + elapsed * rate, rate * LINK_BUCKET_MS);
+}
+
+// Time until the bucket is positive again, 0 if it already is
+static uint32_t bucket_wait_ms(const link_bucket_t *b, int64_t rate) {
+  if (rate == 0 || b->tokens > 0) return 0;
+  return (uint32_t)(-b->tokens / rate) + 1;
+}
+
+static bool min_rate_due(uint32_t now) {
+  if (perfConfig.stream_min_fps <= 0) return false;
+  return now - last_stream_ms >= (uint32_t)(1000 / perfConfig.stream_min_fps);
+}
+
+static void print_stats(uint32_t now) {
+  link_stats_t snap[2];
+  uint32_t interval_ms;
+
+  portENTER_CRITICAL(&link_mux);
+  memcpy(snap, stats, sizeof(snap));
+  memset(stats, 0, sizeof(stats));
+  interval_ms = max<uint32_t>(now - stats_start_ms, 1);
+  stats_start_ms = now;
+  portEXIT_CRITICAL(&link_mux);
+
+  // Average over the interval, and while actually sending
+  for (int i = 0; i < 2; i++) {
+    char skipped[24] = "";
+    if (snap[i].skipped) {
+      snprintf(skipped, sizeof(skipped), ", %lu skipped",
+               (unsigned long)snap[i].skipped);
+    }
+    LOG_I("Link %s: %lu frames, %lu KB/s (%lu KB/s while busy)%s",
+          i == (int)LINK_CLASS::STREAM ? "stream" : "upload", snap[i].frames,
+          (uint32_t)(snap[i].bytes / interval_ms),
+          snap[i].busy_ms ? (uint32_t)(snap[i].bytes / snap[i].busy_ms) : 0,
+          skipped);
+  }
+}
@@ -0,0 +1,120 @@
+#include "log_ring.h"
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#include <atomic>
+
+#include "app_config.h"
+
+// === Local Defines ===
+
+#define LOG_RING_MASK (CONFIG_LOG_RING_SLOTS - 1)
+#define LOG_IDLE_MS (20)
+
+static_assert((CONFIG_LOG_RING_SLOTS & LOG_RING_MASK) == 0,
+              "CONFIG_LOG_RING_SLOTS must be a power of two");
+
+// === Types ===
+
+/**
+ * @brief A queued message
+ * @note `seq` tells who owns the slot: it equals the write position
+ * when the slot is free for it, and the write position + 1 once
+ * the message is ready to be printed. It is stored minus the slot
+ * number, so the zeroed ring starts out free
+ *
+ */
+typedef struct {
+  std::atomic<uint32_t> seq;
+  uint32_t ms;
+  uint8_t level;
+  char line[CONFIG_LOG_LINE_SZ];
+} log_slot_t;
+
+// === Variables ===
+
+static log_slot_t slots[CONFIG_LOG_RING_SLOTS];
+static std::atomic<uint32_t> write_pos(0);
+static uint32_t read_pos = 0;  // Only used by the log task
+static std::atomic<uint32_t> dropped(0);
+
+static TaskHandle_t LogTask = NULL;
+
+// === Local Functions ===
+
+static void log_ring_task(void *pvParameters);
+static uint32_t slot_seq(uint32_t pos);
+static void set_slot_seq(uint32_t pos, uint32_t seq);
+
+void log_ring_start() {
+  xTaskCreate(log_ring_task, "LogTask", 3072, NULL, 1, &LogTask);
+}
+
+void log_ring_printf(int level, const char *fmt, ...) {
+  uint32_t pos = write_pos.load(std::memory_order_relaxed);
+  log_slot_t *slot;
+  va_list args;
+
+  // Claim the next slot, or give up if the printer is behind
+  for (;;) {
+    slot = &slots[pos & LOG_RING_MASK];
+    int32_t diff = (int32_t)(slot_seq(pos) - pos);
+    if (diff == 0) {
+      if (write_pos.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = write_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->ms = millis();
+  slot->level = level;
+  va_start(args, fmt);
+  vsnprintf(slot->line, sizeof(slot->line), fmt, args);
+  va_end(args);
+  set_slot_seq(pos, pos + 1);
+}
+
+static void log_ring_task(void *pvParameters) {
+  static const char level_tag[] = "?EWID";
+  uint32_t reported = 0;
+
+  while (true) {
+    log_slot_t *slot = &slots[read_pos & LOG_RING_MASK];
+    if (slot_seq(read_pos) != read_pos + 1) {
+      uint32_t lost = dropped.load(std::memory_order_relaxed);
+      if (lost != reported) {
+        Serial.printf("(%lu log messages dropped)\n",
+                      (unsigned long)(lost - reported));
+        reported = lost;
+      }
+      vTaskDelay(pdMS_TO_TICKS(LOG_IDLE_MS));
+      continue;
+    }
+
+    // Only this task is held up if the UART is slow
+    Serial.printf("%lu.%03lu %c %s\n", (unsigned long)(slot->ms / 1000),
+                  (unsigned long)(slot->ms % 1000),
+                  level_tag[slot->level <= LOG_LEVEL_DEBUG ? slot->level : 0],
+                  slot->line);
+    set_slot_seq(read_pos, read_pos + CONFIG_LOG_RING_SLOTS);
+    read_pos++;
+  }
+}
+
+// Sequence of the slot used by write position `pos`
+static uint32_t slot_seq(uint32_t pos) {
+  return slots[pos & LOG_RING_MASK].seq.load(std::memory_order_acquire) +
+         (pos & LOG_RING_MASK);
+}
+
+static void set_slot_seq(uint32_t pos, uint32_t seq) {
+  slots[pos & LOG_RING_MASK].seq.store(seq - (pos & LOG_RING_MASK),
+                                       std::memory_order_release);
+}
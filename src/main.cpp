@@ -6,8 +6,12 @@
 #include <algorithm>
 #include <vector>
 
+#include "archive.h"
 #include "esp_attr.h"
+#include "footage_server.h"
 #include "freertos/FreeRTOS.h"
+#include "log_ring.h"
+#include "perf_config.h"
 #include "time.h"
 
 // Network interfaces
@@ -21,10 +25,14 @@ HTTPClient http;
 const char* sensor_topic_prefix = "sensor/";
 String sensor_topic = sensor_topic_prefix + String("+");
 String mapping_topic;  // = "mapping/" + deviceName
+String config_topic;   // = "config/" + deviceName
+String archive_topic;  // = "archive/" + deviceName
 std::vector<String> mapped_sensors;
 
+volatile bool networkOnline = false;
+
 // Functions
-void coordinator_register_device();
+bool coordinator_register_device();
 void mqtt_broker_sub_cb(char* topic, uint8_t* payload, unsigned int len);
 
 // === Macros ===
@@ -36,17 +44,51 @@ void mqtt_broker_sub_cb(char* topic, uint8_t* payload, unsigned int len);
     vTaskSuspend(NULL);                \
   } while (0)
 
+// === Enum Classes ===
+
+enum class WIFI_STATE {
+  IDLE,        // Not connected, waiting for the next attempt
+  CONNECTING,  // WiFi.begin() issued, waiting to associate
+  CONNECTED,
+};
+
 // === Static / Local Variables ===
 
+typedef struct {
+  uint32_t next_attempt_ms;
+  uint32_t delay_ms;
+} backoff_t;
+
+static WIFI_STATE wifi_state = WIFI_STATE::IDLE;
+static uint32_t wifi_attempt_start_ms;
+static bool wifi_connected_once = false;
+static bool ntp_started = false;
+static bool device_registered = false;
+static uint32_t online_ms = 0;
+
+static backoff_t wifi_backoff;
+static backoff_t mqtt_backoff;
+static backoff_t register_backoff;
+
 // === Function Declarations ===
 
-void coordinator_register_device();
+bool coordinator_register_device();
 extern bool load_device_configs(fs::FS& fs);
 extern void camera_svc_start();
 
 static void delete_dir_recursive(fs::FS &fs, const char* path);
 static void _delete_dir_r(fs::FS &fs, const char* path, fs::File dir);
 
+static void net_svc_step();
+static void net_wifi_step();
+static void net_mqtt_step();
+static void net_register_step();
+static bool mqtt_connect_and_subscribe();
+
+static void backoff_reset(backoff_t& b);
+static void backoff_fail(backoff_t& b);
+static bool backoff_ready(const backoff_t& b);
+
 void IRAM_ATTR mqtt_svc_signal_event();
 void mqtt_notif_loop(void* args);
 
@@ -54,6 +96,7 @@ void mqtt_notif_loop(void* args);
 
 void setup() {
   Serial.begin(CONFIG_BAUD_RATE);
+  log_ring_start();
 
   if (!LittleFS.begin()) {
     panic("Failed to init Flash FS");
@@ -87,64 +130,200 @@ void setup() {
   Serial.println(coordinatorIP);
   Serial.print("Coordinator Port: ");
   Serial.println(coordinatorPort);
+  Serial.print("Frame Rate:       ");
+  Serial.println(perfConfig.frame_rate);
+  Serial.print("Event Window:     ");
+  Serial.printf("-%ds/+%ds", perfConfig.pre_event_seconds,
+                perfConfig.post_event_seconds);
   Serial.println();
+  Serial.println();
+
+  // Start recording straight away, the network is brought up
+  // in the background by loop()
+  camera_svc_start();
+
+  mqttClient.setServer(brokerIP, brokerPort);
+  // Default buffer is too small for performance profiles. Larger
+  // messages are dropped without a word, so leave room for a full
+  // profile on top of the topic and header
+  mqttClient.setBufferSize(CONFIG_JSON_MAX_SIZE + 128);
+  mqttClient.setCallback(mqtt_broker_sub_cb);
+
+  mapping_topic = "mapping/" + deviceName;
+  config_topic = "config/" + deviceName;
+  archive_topic = "archive/" + deviceName;
+
+  backoff_reset(wifi_backoff);
+  backoff_reset(mqtt_backoff);
+  backoff_reset(register_backoff);
+}
+
+void loop() {
+  net_svc_step();
 
-  Serial.print("Connecting to network over Wi-Fi");
-  WiFi.begin(wifiSSID, wifiPass);
-  while (!WiFi.isConnected()) {
-    Serial.print('.');
-    delay(1000);
+  if (mqttClient.connected()) {
+    mqttClient.loop();
+  }
+  if (ntp_started) {
+    timeClient.update();
   }
-  Serial.println();
 
-  Serial.println("Connected!");
+  delay(10);
+}
 
-  // Clear from memory
-  wifiPass.clear();
+/**
+ * @brief Advance the network bring up. Never blocks for longer
+ * than a single connection attempt
+ * @note Once Wi-Fi is up, MQTT and coordinator registration
+ * are brought up independently of each other
+ */
+static void net_svc_step() {
+  net_wifi_step();
+
+  if (wifi_state != WIFI_STATE::CONNECTED) {
+    networkOnline = false;
+    return;
+  }
 
-  Serial.println("Configuring mqtt...");
-  mqttClient.setServer(brokerIP, brokerPort);
-  mqttClient.connect(deviceName.c_str());
-  Serial.println("Connected to broker!");
+  net_mqtt_step();
+  net_register_step();
 
-  timeClient.begin();
+  networkOnline = device_registered;
+  if (online_ms == 0 && device_registered && mqttClient.connected()) {
+    online_ms = millis();
+    Serial.printf("Time to online: %lu ms", online_ms);
+    Serial.println();
+  }
+}
+
+static void net_wifi_step() {
+  switch (wifi_state) {
+    case WIFI_STATE::IDLE:
+      if (!backoff_ready(wifi_backoff)) break;
+      Serial.println("Connecting to network over Wi-Fi...");
+      if (wifi_connected_once) {
+        WiFi.reconnect();
+      } else {
+        WiFi.begin(wifiSSID, wifiPass);
+      }
+      wifi_attempt_start_ms = millis();
+      wifi_state = WIFI_STATE::CONNECTING;
+      break;
+
+    case WIFI_STATE::CONNECTING:
+      if (WiFi.isConnected()) {
+        Serial.println("Connected to Wi-Fi!");
+        wifi_state = WIFI_STATE::CONNECTED;
+        backoff_reset(wifi_backoff);
+        if (!wifi_connected_once) {
+          wifi_connected_once = true;
+          // Clear from memory, reconnects reuse the stored config
+          wifiPass.clear();
+          footage_server_start();
+        }
+        if (!ntp_started) {
+          timeClient.begin();
+          ntp_started = true;
+        }
+      } else if (millis() - wifi_attempt_start_ms >
+                 CONFIG_WIFI_CONNECT_TIMEOUT_MS) {
+        Serial.println("Timed out connecting to Wi-Fi");
+        WiFi.disconnect();
+        backoff_fail(wifi_backoff);
+        wifi_state = WIFI_STATE::IDLE;
+      }
+      break;
+
+    case WIFI_STATE::CONNECTED:
+      if (!WiFi.isConnected()) {
+        Serial.println("Lost connection to Wi-Fi");
+        wifi_attempt_start_ms = millis();
+        wifi_state = WIFI_STATE::CONNECTING;
+      }
+      break;
+  }
+}
+
+static void net_mqtt_step() {
+  if (mqttClient.connected() || !backoff_ready(mqtt_backoff)) {
+    return;
+  }
+
+  Serial.println("Connecting to broker...");
+  if (mqtt_connect_and_subscribe()) {
+    Serial.println("Connected to broker!");
+    backoff_reset(mqtt_backoff);
+  } else {
+    Serial.printf("Failed to connect to broker (state %d)",
+                  mqttClient.state());
+    Serial.println();
+    mqttClient.disconnect();
+    backoff_fail(mqtt_backoff);
+  }
+}
+
+static void net_register_step() {
+  if (device_registered || !backoff_ready(register_backoff)) {
+    return;
+  }
+
+  if (coordinator_register_device()) {
+    device_registered = true;
+    backoff_reset(register_backoff);
+  } else {
+    backoff_fail(register_backoff);
+  }
+}
+
+// Subscriptions do not survive a reconnect, so they are
+// made again every time
+static bool mqtt_connect_and_subscribe() {
+  if (!mqttClient.connect(deviceName.c_str())) {
+    return false;
+  }
 
   // Topics to listen to
-  mapping_topic = "mapping/" + deviceName;
   Serial.printf("Subscribing to topic %s...", sensor_topic.c_str());
   Serial.println();
   Serial.printf("Subscribing to topic %s...", mapping_topic.c_str());
   Serial.println();
+  Serial.printf("Subscribing to topic %s...", config_topic.c_str());
+  Serial.println();
+  Serial.printf("Subscribing to topic %s...", archive_topic.c_str());
+  Serial.println();
 
   if (!mqttClient.subscribe(sensor_topic.c_str()) ||
-      !mqttClient.subscribe(mapping_topic.c_str())) {
+      !mqttClient.subscribe(mapping_topic.c_str()) ||
+      !mqttClient.subscribe(config_topic.c_str()) ||
+      !mqttClient.subscribe(archive_topic.c_str())) {
     Serial.println("Failed to set subscribe");
-    vTaskSuspend(NULL);
+    return false;
   }
-  mqttClient.setCallback(mqtt_broker_sub_cb);
-
-  coordinator_register_device();
-
-  camera_svc_start();
+  return true;
 }
 
-void loop() {
-  mqttClient.loop();
-  timeClient.update();
+static void backoff_reset(backoff_t& b) {
+  b.delay_ms = CONFIG_NET_BACKOFF_MIN_MS;
+  b.next_attempt_ms = millis();
+}
 
-  if (!mqttClient.connected()) {
-    Serial.println("Lost connection to broker");
-    if (mqttClient.connect(deviceName.c_str())) {
-      Serial.println("Reconnected to broker!");
-    } else {
-      Serial.println("Failed to reconnect...");
-    }
-  }
+// Double the delay and add up to 25% of jitter so devices which
+// lost power together do not retry in lockstep
+static void backoff_fail(backoff_t& b) {
+  uint32_t jitter = esp_random() % (b.delay_ms / 4 + 1);
+  b.next_attempt_ms = millis() + b.delay_ms + jitter;
+  b.delay_ms = min<uint32_t>(b.delay_ms * 2, CONFIG_NET_BACKOFF_MAX_MS);
+}
 
-  delay(10);
+static bool backoff_ready(const backoff_t& b) {
+  return (int32_t)(millis() - b.next_attempt_ms) >= 0;
 }
 
-void coordinator_register_device() {
+/**
+ * @brief Make a single attempt at registering with the coordinator
+ * @note Retries are paced by the caller
+ */
+bool coordinator_register_device() {
   ArduinoJson::JsonDocument json;
   int resp_code = 0;
   static char buf[256];
@@ -154,16 +333,16 @@ void coordinator_register_device() {
   json["type"] = DEVICE_TYPE;
 
   Serial.println("Registering devivce...");
-  while (resp_code != HTTP_CODE_NO_CONTENT) {
-    http.begin(coordinatorIP.toString(), coordinatorPort,
-               "/api/device/register");
-    http.addHeader("Content-Type", "application/json");
-    serializeJson(json, buf);
-    resp_code = http.PUT(buf);
-
-    Serial.printf("HTTP Response: %d", resp_code);
-    Serial.println();
-  }
+  http.begin(coordinatorIP.toString(), coordinatorPort,
+             "/api/device/register");
+  http.addHeader("Content-Type", "application/json");
+  serializeJson(json, buf);
+  resp_code = http.PUT(buf);
+  http.end();
+
+  Serial.printf("HTTP Response: %d", resp_code);
+  Serial.println();
+  return resp_code == HTTP_CODE_NO_CONTENT;
 }
 
 void mqtt_broker_sub_cb(char* topic, uint8_t* payload, unsigned int len) {
@@ -185,6 +364,25 @@ void mqtt_broker_sub_cb(char* topic, uint8_t* payload, unsigned int len) {
     Serial.printf("\b\b ");
     Serial.println();
   }
+  // Expect data such as { "FrameRate": 4, "PreEventSeconds": 10, ... }
+  else if (strcmp(topic, config_topic.c_str()) == 0) {
+    ArduinoJson::JsonDocument json;
+    if (deserializeJson(json, (char*)payload, len) !=
+            DeserializationError::Ok ||
+        !camera_svc_merge_perf_config(json.as<JsonVariantConst>())) {
+      Serial.println("Ignoring malformed performance profile");
+    }
+  }
+  // Expect data such as { "From": 1700000000, "To": 1700000600 }
+  else if (strcmp(topic, archive_topic.c_str()) == 0) {
+    ArduinoJson::JsonDocument json;
+    if (deserializeJson(json, (char*)payload, len) !=
+            DeserializationError::Ok ||
+        !json["From"].is<uint32_t>() || !json["To"].is<uint32_t>() ||
+        !archive_request_upload(json["From"], json["To"])) {
+      Serial.println("Ignoring archive upload request");
+    }
+  }
   // Matches "sensor/+"
   else if (strncmp(topic, sensor_topic_prefix, strlen(sensor_topic_prefix)) ==
            0) {
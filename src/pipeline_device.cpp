@@ -0,0 +1,157 @@
+#include "pipeline_device.h"
+
+#include <Arduino.h>
+
+#include "app_config.h"
+#include "log_ring.h"
+#include "main.h"
+#include "perf_config.h"
+#include "udp_stream.h"
+
+void SdFrameSink::begin_slot(int slot) {
+  char path[64];
+  snprintf(path, sizeof(path), "%s/%d", CAMERA_FB_ROOT, slot);
+
+  if (!SD_MMC.exists(path)) {
+    SD_MMC.mkdir(path);
+    return;
+  }
+
+  File dir = SD_MMC.open(path);
+  if (!dir || !dir.isDirectory()) {
+    LOG_E("Failed to open existing directory: %s", path);
+    return;
+  }
+
+  File entry;
+  while ((entry = dir.openNextFile())) {
+    String entryPath = String(path) + "/" + entry.name();
+    if (entry.isDirectory()) {
+      SD_MMC.rmdir(entryPath.c_str());
+    } else {
+      SD_MMC.remove(entryPath.c_str());
+    }
+    entry.close();
+  }
+  dir.close();
+}
+
+size_t SdFrameSink::write(int slot, int frame, const uint8_t *buf,
+                          size_t len, const jpeg_strip_t &strip) {
+  char path[96];
+  snprintf(path, sizeof(path), "%s/%d/%d.jpg", CAMERA_FB_ROOT, slot, frame);
+
+  File file = SD_MMC.open(path, FILE_WRITE);
+  if (!file) {
+    LOG_E("Failed to open file for writing: %s", path);
+    return 0;
+  }
+
+  size_t written = strip.tables ? jpeg_tables_write(file, buf, &strip)
+                                : file.write(buf, len);
+  file.close();
+  return written;
+}
+
+bool HttpStreamTransport::send(const uint8_t *buf, size_t len, uint32_t epoch,
+                               int frame, uint32_t deadline_ms, bool *kept) {
+  jpeg_strip_t strip;
+  uint8_t id = 0;
+  int resp;
+
+  if (!refused_ && jpeg_tables_split(buf, len, &strip, &tables_)) {
+    id = tables_id();
+  }
+
+  http.begin(url_);
+  http.addHeader("Content-Type", "image/jpeg");
+  // Full frames carry their capture second and number, so that
+  // event uploads can refer to them instead of sending them again
+  if (frame >= 0) {
+    http.addHeader("Frame-Epoch", String(epoch));
+    http.addHeader("Frame-Number", String(frame));
+  }
+  if (id) {
+    http.addHeader("Frame-Tables", String(id));
+  }
+
+  http.setTimeout(perfConfig.upload_timeout_ms);
+
+  if (id) {
+    JpegStripStream abbreviated(buf, strip);
+    resp = http.sendRequest("PUT", &abbreviated, strip.len);
+  } else {
+    resp = http.PUT((uint8_t *)buf, len);
+  }
+  *kept = resp == HTTP_CODE_NO_CONTENT && frame >= 0;
+
+  // Dont bother printing timeout errors
+  if ((resp != HTTP_CODE_NO_CONTENT) && (resp != HTTPC_ERROR_READ_TIMEOUT)) {
+    String err = http.errorToString(resp);
+    LOG_W("HTTP error: %s (%d)", err.c_str(), resp);
+  }
+  // The coordinator lost its sets (e.g. it restarted)
+  if (resp == HTTP_CODE_CONFLICT) {
+    memset(sent_, 0, sizeof(sent_));
+  }
+
+  http.end();
+  return resp > 0;
+}
+
+/**
+ * @brief Id the coordinator holds the tables of the frame under,
+ * sending them first if it does not have them yet
+ * @return 0 if the frame has to go out in full
+ */
+uint8_t HttpStreamTransport::tables_id() {
+  static const char *response_headers[] = {"Table-Set"};
+  char runs[64];
+
+  // FNV-1a, never 0 so that 0 can mean no set
+  uint32_t h = 2166136261u;
+  for (int i = 0; i < tables_.run_count; i++) {
+    h = (h ^ tables_.runs[i].at) * 16777619u;
+  }
+  for (int i = 0; i < tables_.len; i++) {
+    h = (h ^ tables_.data[i]) * 16777619u;
+  }
+  h |= 1;
+
+  for (uint8_t id = 1; id <= JPEG_TABLES_MAX_SETS; id++) {
+    if (sent_[id] == h) return id;
+  }
+
+  // Ids are reused oldest first
+  uint8_t id = last_id_ % JPEG_TABLES_MAX_SETS + 1;
+  last_id_ = id;
+  sent_[id] = 0;
+
+  jpeg_tables_format_runs(&tables_, runs, sizeof(runs));
+  http.begin(url_);
+  http.collectHeaders(response_headers, 1);
+  http.addHeader("Content-Type", "application/octet-stream");
+  http.addHeader("Table-Set", String(id));
+  http.addHeader("Table-Runs", runs);
+  http.setTimeout(perfConfig.upload_timeout_ms);
+
+  int resp = http.PUT(tables_.data, tables_.len);
+  if (resp == HTTP_CODE_NO_CONTENT) {
+    if (http.header("Table-Set").toInt() == id) {
+      sent_[id] = h;
+    } else {
+      LOG_W("Coordinator does not take JPEG table sets, streaming full "
+            "frames");
+      refused_ = true;
+    }
+  }
+  http.end();
+  return sent_[id] ? id : 0;
+}
+
+bool UdpStreamTransport::send(const uint8_t *buf, size_t len, uint32_t epoch,
+                              int frame, uint32_t deadline_ms, bool *kept) {
+  // Datagrams may be lost, the coordinator never has a copy to refer to
+  *kept = false;
+  return udp_stream_send(buf, len, epoch, deadline_ms);
+}
@@ -0,0 +1,144 @@
+#include "static_scene.h"
+
+#include <Arduino.h>
+
+#include "app_config.h"
+#include "esp_timer.h"
+#include "img_converters.h"
+#include "log_ring.h"
+
+// === Local Defines ===
+
+#define SIGNATURE_GRID (8)
+#define SIGNATURE_SZ (SIGNATURE_GRID * SIGNATURE_GRID)
+#define STATIC_STATS_INTERVAL (200)
+
+// === Variables ===
+
+// Signature of the last frame stored in full
+static uint8_t ref_signature[SIGNATURE_SZ];
+static size_t ref_len = 0;
+static size_t ref_width = 0;
+
+static uint8_t *rgb_buf = NULL;
+static size_t rgb_buf_sz = 0;
+
+static uint32_t stat_frames = 0;
+static uint32_t stat_repeats = 0;
+static uint32_t stat_decodes = 0;
+static uint64_t stat_us_total = 0;
+
+// === Local Functions ===
+
+static bool compute_signature(const camera_fb_t *fb, uint8_t *sig);
+static void print_stats();
+
+bool static_scene_is_repeat(const camera_fb_t *fb, bool keyframe,
+                            int threshold) {
+  uint8_t sig[SIGNATURE_SZ];
+  bool repeat = false;
+
+  if (!fb || fb->format != PIXFORMAT_JPEG) return false;
+
+  stat_frames++;
+  int64_t t_start = esp_timer_get_time();
+
+  // Frames of different sizes cannot stand in for each other
+  if (fb->width != ref_width) {
+    keyframe = true;
+    ref_width = fb->width;
+  }
+
+  if (threshold <= 0) {
+    ref_len = 0;
+  } else if (keyframe || ref_len == 0) {
+    if (compute_signature(fb, ref_signature)) {
+      ref_len = fb->len;
+    }
+  } else {
+    // Cheap check first, a real change almost always changes
+    // how well the frame compresses
+    size_t delta = fb->len > ref_len ? fb->len - ref_len : ref_len - fb->len;
+    if (delta * 100 <= ref_len * CONFIG_STATIC_SCENE_SIZE_PCT &&
+        compute_signature(fb, sig)) {
+      uint32_t diff = 0;
+      for (int i = 0; i < SIGNATURE_SZ; i++) {
+        diff += abs((int)sig[i] - (int)ref_signature[i]);
+      }
+      repeat = diff < (uint32_t)threshold * SIGNATURE_SZ;
+
+      // Compare later frames against this one, so slow
+      // changes are not missed
+      if (!repeat) {
+        memcpy(ref_signature, sig, SIGNATURE_SZ);
+        ref_len = fb->len;
+      }
+    } else {
+      ref_len = 0;
+    }
+  }
+
+  if (repeat) stat_repeats++;
+  stat_us_total += esp_timer_get_time() - t_start;
+  if (stat_frames >= STATIC_STATS_INTERVAL) {
+    print_stats();
+  }
+  return repeat;
+}
+
+// Decode at 1/8 scale and average luma over an 8x8 grid
+static bool compute_signature(const camera_fb_t *fb, uint8_t *sig) {
+  uint32_t sums[SIGNATURE_SZ] = {0};
+  uint32_t counts[SIGNATURE_SZ] = {0};
+
+  uint16_t width = fb->width / 8;
+  uint16_t height = fb->height / 8;
+  size_t rgb_len = (size_t)width * height * 2;
+  if (width < SIGNATURE_GRID || height < SIGNATURE_GRID) return false;
+
+  if (rgb_len > rgb_buf_sz) {
+    free(rgb_buf);
+    rgb_buf = (uint8_t *)ps_malloc(rgb_len);
+    if (!rgb_buf) rgb_buf = (uint8_t *)malloc(rgb_len);
+    rgb_buf_sz = rgb_buf ? rgb_len : 0;
+    if (!rgb_buf) return false;
+  }
+
+  stat_decodes++;
+  if (!jpg2rgb565(fb->buf, fb->len, rgb_buf, JPG_SCALE_8X)) {
+    return false;
+  }
+
+  for (int y = 0; y < height; y++) {
+    int gy = y * SIGNATURE_GRID / height;
+    for (int x = 0; x < width; x++) {
+      const uint8_t *px = &rgb_buf[(y * width + x) * 2];
+      // Big endian RGB565
+      uint16_t c = (px[0] << 8) | px[1];
+      uint32_t r = (c >> 8) & 0xF8;
+      uint32_t g = (c >> 3) & 0xFC;
+      uint32_t b = (c << 3) & 0xF8;
+
+      int cell = gy * SIGNATURE_GRID + x * SIGNATURE_GRID / width;
+      sums[cell] += (r * 77 + g * 150 + b * 29) >> 8;
+      counts[cell]++;
+    }
+  }
+
+  for (int i = 0; i < SIGNATURE_SZ; i++) {
+    sig[i] = counts[i] ? sums[i] / counts[i] : 0;
+  }
+  return true;
+}
+
+static void print_stats() {
+  LOG_I(
+      "Static scene: %lu/%lu frames repeated (%u%%), %lu decoded, "
+      "avg %lu us",
+      stat_repeats, stat_frames, (unsigned)(stat_repeats * 100 / stat_frames),
+      stat_decodes, (uint32_t)(stat_us_total / stat_frames));
+  stat_frames = 0;
+  stat_repeats = 0;
+  stat_decodes = 0;
+  stat_us_total = 0;
+}
@@ -0,0 +1,100 @@
+#include "udp_stream.h"
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+
+#include "app_config.h"
+#include "log_ring.h"
+#include "main.h"
+
+// === Local Defines ===
+
+#define UDP_STATS_INTERVAL (100)
+
+// === Variables ===
+
+static WiFiUDP stream_udp;
+static uint8_t datagram[UDP_STREAM_HEADER_SIZE + CONFIG_STREAM_UDP_PAYLOAD];
+
+static uint32_t next_seq = 0;
+static uint32_t next_frame_id = 0;
+
+static uint32_t stat_frames = 0;
+static uint32_t stat_aborted = 0;
+static uint32_t stat_datagrams = 0;
+
+// === Local Functions ===
+
+static void put_u16(uint8_t *p, uint16_t v);
+static void put_u32(uint8_t *p, uint32_t v);
+static void print_stats();
+
+bool udp_stream_send(const uint8_t *buf, size_t len, uint32_t epoch,
+                     uint32_t deadline_ms) {
+  const uint32_t start_ms = millis();
+  const uint32_t frame_id = next_frame_id++;
+  const uint16_t frag_count =
+      (len + CONFIG_STREAM_UDP_PAYLOAD - 1) / CONFIG_STREAM_UDP_PAYLOAD;
+  bool complete = true;
+
+  for (uint16_t frag = 0; frag < frag_count; frag++) {
+    size_t offset = (size_t)frag * CONFIG_STREAM_UDP_PAYLOAD;
+    size_t chunk = min<size_t>(len - offset, CONFIG_STREAM_UDP_PAYLOAD);
+
+    // Whatever is left is stale by now, the next frame takes over
+    if (millis() - start_ms > deadline_ms) {
+      complete = false;
+      break;
+    }
+
+    datagram[0] = 'H';
+    datagram[1] = 'S';
+    datagram[2] = UDP_STREAM_VERSION;
+    datagram[3] = 0;
+    put_u32(&datagram[4], next_seq++);
+    put_u32(&datagram[8], frame_id);
+    put_u32(&datagram[12], epoch);
+    put_u32(&datagram[16], len);
+    put_u16(&datagram[20], frag);
+    put_u16(&datagram[22], frag_count);
+    memcpy(&datagram[UDP_STREAM_HEADER_SIZE], buf + offset, chunk);
+
+    // Fails when the network stack is out of buffers, nothing
+    // would be gained by waiting for it
+    if (!stream_udp.beginPacket(coordinatorIP, CONFIG_STREAM_UDP_PORT) ||
+        stream_udp.write(datagram, UDP_STREAM_HEADER_SIZE + chunk) == 0 ||
+        !stream_udp.endPacket()) {
+      complete = false;
+      break;
+    }
+    stat_datagrams++;
+  }
+
+  stat_frames++;
+  if (!complete) stat_aborted++;
+  if (stat_frames >= UDP_STATS_INTERVAL) {
+    print_stats();
+  }
+  return complete;
+}
+
+static void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static void print_stats() {
+  LOG_I("UDP stream: %lu frames (%lu abandoned), %lu datagrams",
+        stat_frames, stat_aborted, stat_datagrams);
+  stat_frames = 0;
+  stat_aborted = 0;
+  stat_datagrams = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef __HOST_CONFIG_H
+#define __HOST_CONFIG_H
+
+#include "esp_camera.h"
+#include "perf_config.h"
+
+/**
+ * @brief Default profile, as set up by `config_loader.cpp` which is
+ * not part of the native build. Tests change it as they need
+ *
+ */
+perf_config_t perfConfig = {
+    CONFIG_CAMERA_FRAME_RATE,
+    CONFIG_CAMERA_STREAM_FRAME_DOWNSCALE,
+    CONFIG_CAMERA_STREAM_PREVIEW_SCALE,
+    CONFIG_HTTP_UPLOAD_TIMEOUT_MS,
+    CONFIG_EVENT_PRE_SECONDS,
+    CONFIG_EVENT_POST_SECONDS,
+    CONFIG_CAMERA_SAVE_QUEUE_DEPTH,
+    CONFIG_STATIC_SCENE_THRESHOLD,
+    CONFIG_LINK_STREAM_POLICY,
+    CONFIG_LINK_STREAM_MIN_FPS,
+    CONFIG_LINK_BUDGET_KBPS,
+    CONFIG_STREAM_TRANSPORT,
+    CONFIG_CAMERA_IDLE_FRAMESIZE,
+    CONFIG_CAMERA_IDLE_QUALITY,
+    CONFIG_CAMERA_EVENT_FRAMESIZE,
+    CONFIG_CAMERA_EVENT_QUALITY,
+    CONFIG_ROI_LEFT,
+    CONFIG_ROI_TOP,
+    CONFIG_ROI_WIDTH,
+    CONFIG_ROI_HEIGHT,
+    CONFIG_ROI_STAGES,
+};
+
+#endif  // __HOST_CONFIG_H
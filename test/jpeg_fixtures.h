@@ -0,0 +1,1155 @@
+// Generated by make_fixtures.py, do not edit
+#ifndef __JPEG_FIXTURES_H
+#define __JPEG_FIXTURES_H
+
+#include <stdint.h>
+
+// 4:2:0, 64x48
+static const uint8_t jpeg_420[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x30, 0x00, 0x40, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1,
+    0x18, 0xAD, 0x09, 0x60, 0x30, 0x78, 0xAB, 0x91, 0x5A, 0x71, 0x9C, 0x12,
+    0x73, 0x9C, 0x0A, 0xD1, 0x8A, 0xD7, 0xB8, 0xEA, 0x3A, 0x55, 0xB8, 0xAD,
+    0x4F, 0x71, 0xDF, 0xD3, 0x3D, 0x2B, 0xAE, 0x9C, 0x0C, 0x68, 0x62, 0x8C,
+    0xF8, 0xED, 0x0E, 0x41, 0x20, 0xF4, 0xAB, 0x91, 0xDA, 0xB0, 0x60, 0x08,
+    0xCF, 0xBE, 0x2B, 0x4A, 0x1B, 0x5C, 0xF1, 0x82, 0x3E, 0xA2, 0xAD, 0xC3,
+    0x6B, 0xC7, 0x2B, 0x8C, 0xFB, 0x7D, 0x6B, 0xB2, 0x10, 0x3D, 0x8A, 0x18,
+    0xB3, 0x3E, 0x2B, 0x56, 0xC8, 0x18, 0xE8, 0x3D, 0x2A, 0xEC, 0x76, 0xBD,
+    0x00, 0x27, 0xD0, 0x8C, 0x77, 0xAD, 0x08, 0xAD, 0x3E, 0x5C, 0xED, 0xE7,
+    0xBD, 0x5D, 0x8A, 0xD3, 0x01, 0x47, 0x00, 0x57, 0x5C, 0x20, 0x7B, 0x54,
+    0x31, 0x46, 0x6C, 0x76, 0xC7, 0x23, 0x8A, 0xBB, 0x1D, 0xAF, 0x3C, 0x8F,
+    0xA5, 0x68, 0xC5, 0x68, 0x02, 0x8D, 0xAB, 0xDF, 0xA5, 0x5A, 0xF2, 0x23,
+    0x89, 0x0B, 0x49, 0x85, 0x03, 0xDB, 0xAD, 0x75, 0x2E, 0x48, 0x45, 0xCE,
+    0x6E, 0xC9, 0x75, 0x67, 0xB3, 0x43, 0x15, 0x7B, 0x1C, 0x44, 0x36, 0xA0,
+    0x36, 0x71, 0xC9, 0xAB, 0xB1, 0x5A, 0xF2, 0x3E, 0x50, 0x3D, 0x87, 0x7A,
+    0xD1, 0x8A, 0xCC, 0x16, 0xCF, 0x50, 0x79, 0xAB, 0x90, 0x5A, 0xE0, 0x7D,
+    0xDC, 0x57, 0x91, 0x08, 0x1F, 0x87, 0x50, 0xC5, 0x99, 0xC9, 0x6A, 0x78,
+    0xF9, 0x4F, 0xFF, 0x00, 0x5A, 0xAE, 0x45, 0x68, 0x49, 0x18, 0xC9, 0xF5,
+    0xC8, 0xAD, 0x08, 0xAD, 0x71, 0xCE, 0xDE, 0xBE, 0xD5, 0x76, 0x2B, 0x33,
+    0xB7, 0x91, 0xEF, 0xFE, 0x45, 0x76, 0x53, 0x81, 0xEC, 0xD0, 0xC5, 0x19,
+    0xD1, 0x5A, 0x10, 0x06, 0x41, 0xCF, 0x6C, 0x8A, 0xB9, 0x1D, 0xA0, 0x51,
+    0x9C, 0x63, 0x23, 0x93, 0xD2, 0xAD, 0xB2, 0xC7, 0x0E, 0x72, 0x32, 0xC7,
+    0x9C, 0x2F, 0x5A, 0x88, 0xC7, 0x24, 0xE7, 0x3C, 0x85, 0xC8, 0xF9, 0x7D,
+    0x2B, 0xCE, 0xCC, 0x33, 0xDC, 0x2E, 0x06, 0xF0, 0x4F, 0x9A, 0x7D, 0x97,
+    0x4F, 0x57, 0xD3, 0xF3, 0xF2, 0x3D, 0xFC, 0x25, 0x67, 0x2D, 0x48, 0x9D,
+    0xD5, 0x41, 0x48, 0x54, 0x31, 0xFE, 0xF1, 0xE0, 0x7F, 0xF5, 0xE9, 0xA9,
+    0x01, 0x73, 0x97, 0x2C, 0x4F, 0xD7, 0xA5, 0x5F, 0x8E, 0xD7, 0x9C, 0x95,
+    0xC7, 0xAD, 0x5C, 0x8A, 0xD3, 0x03, 0x38, 0xC0, 0x1E, 0xD5, 0xF1, 0x18,
+    0xEC, 0xCF, 0x15, 0x8F, 0x95, 0xEA, 0xBD, 0x3A, 0x25, 0xB2, 0xFF, 0x00,
+    0x3F, 0x9D, 0xCF, 0xA2, 0xC2, 0xD7, 0x51, 0xD8, 0xC4, 0x86, 0xD0, 0xE7,
+    0x81, 0x83, 0xEB, 0x57, 0x22, 0xB4, 0xC1, 0xC8, 0x19, 0xC5, 0x68, 0x45,
+    0x68, 0x10, 0x6E, 0x3D, 0x3D, 0x4F, 0x6A, 0x71, 0x91, 0x57, 0x02, 0x25,
+    0xDE, 0x47, 0x39, 0x3D, 0x2B, 0xEE, 0xF1, 0x38, 0xDC, 0x3E, 0x0A, 0x1C,
+    0xF5, 0xE5, 0x6F, 0xCD, 0xFA, 0x23, 0xF0, 0x2C, 0x36, 0x21, 0xC9, 0xE8,
+    0x56, 0x5B, 0x78, 0xE3, 0x50, 0x58, 0xF1, 0xC0, 0xE9, 0xFC, 0xA9, 0xA5,
+    0xD9, 0xC0, 0x58, 0xB2, 0x89, 0x8E, 0xB8, 0xE7, 0xFF, 0x00, 0xAD, 0x56,
+    0x05, 0xB3, 0xC8, 0xDB, 0x98, 0xEE, 0x27, 0x9C, 0x9A, 0xB5, 0x0D, 0xA0,
+    0xC6, 0x30, 0x09, 0xCD, 0x7C, 0x66, 0x61, 0xC4, 0x98, 0x8C, 0x57, 0xB9,
+    0x43, 0xDC, 0x8F, 0xE2, 0xFE, 0x7D, 0x3E, 0x5F, 0x79, 0xF4, 0x78, 0x5A,
+    0xAA, 0x36, 0x6F, 0x56, 0x66, 0x25, 0x98, 0xC7, 0xB8, 0xEB, 0x57, 0x62,
+    0xB4, 0x03, 0x07, 0x18, 0xAD, 0x28, 0xAC, 0xFD, 0x47, 0xD7, 0x8A, 0xBB,
+    0x15, 0xA0, 0xE3, 0x70, 0x1D, 0x73, 0x5E, 0x1C, 0x20, 0x7D, 0x06, 0x1F,
+    0x16, 0x66, 0xC7, 0x68, 0x79, 0xC0, 0xCE, 0x3A, 0x55, 0xC8, 0xEC, 0xD7,
+    0xA8, 0x18, 0xE7, 0xBD, 0x69, 0x47, 0x68, 0x40, 0xE9, 0xCF, 0x6A, 0xB7,
+    0x15, 0xA9, 0x38, 0x1B, 0x7B, 0x57, 0x6C, 0x20, 0x7B, 0x38, 0x7C, 0x57,
+    0x99, 0xFF, 0xD9,
+};
+
+// 4:2:2, 64x48
+static const uint8_t jpeg_422[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x30, 0x00, 0x40, 0x03,
+    0x01, 0x21, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1,
+    0x18, 0xAD, 0x09, 0x60, 0x30, 0x78, 0xAB, 0x91, 0x5A, 0x71, 0x9C, 0x12,
+    0x73, 0x9C, 0x0A, 0xE8, 0xA7, 0x12, 0xE8, 0x55, 0x2E, 0x47, 0x68, 0x72,
+    0x09, 0x07, 0xA5, 0x5C, 0x8E, 0xD5, 0x83, 0x00, 0x46, 0x7D, 0xF1, 0x5D,
+    0x90, 0x47, 0xB3, 0x42, 0xA9, 0x76, 0x2B, 0x56, 0xC8, 0x18, 0xE8, 0x3D,
+    0x2A, 0xEC, 0x76, 0xBD, 0x00, 0x27, 0xD0, 0x8C, 0x77, 0xAE, 0xB8, 0x44,
+    0xF6, 0x68, 0x55, 0x2D, 0xC7, 0x6C, 0x72, 0x38, 0xAB, 0xB1, 0xDA, 0xF3,
+    0xC8, 0xFA, 0x57, 0x65, 0x38, 0xEA, 0x7B, 0x54, 0x6A, 0x6C, 0x70, 0xD1,
+    0x5A, 0xF7, 0x1D, 0x47, 0x4A, 0xB7, 0x15, 0xA9, 0xEE, 0x3B, 0xFA, 0x67,
+    0xA5, 0x78, 0x34, 0xE3, 0xD0, 0xFC, 0x86, 0x85, 0x5D, 0x4B, 0xD0, 0xDA,
+    0xE7, 0x8C, 0x11, 0xF5, 0x15, 0x6E, 0x1B, 0x5E, 0x39, 0x5C, 0x67, 0xDB,
+    0xEB, 0x5D, 0x90, 0x89, 0xEC, 0x50, 0xAC, 0x5D, 0x8A, 0xD3, 0xE5, 0xCE,
+    0xDE, 0x7B, 0xD5, 0xD8, 0xAD, 0x30, 0x14, 0x70, 0x05, 0x75, 0xC2, 0x27,
+    0xB3, 0x42, 0xA9, 0x72, 0x2B, 0x40, 0x14, 0x6D, 0x5E, 0xFD, 0x2A, 0xD7,
+    0x91, 0x1C, 0x48, 0x5A, 0x4C, 0x28, 0x1E, 0xDD, 0x6B, 0xA2, 0x55, 0x69,
+    0xD1, 0xA7, 0x2A, 0xB5, 0x1D, 0x92, 0xD5, 0x9E, 0xD6, 0x1E, 0xA3, 0x6E,
+    0xC8, 0xE2, 0x21, 0xB5, 0x01, 0xB3, 0x8E, 0x4D, 0x5D, 0x8A, 0xD7, 0x91,
+    0xF2, 0x81, 0xEC, 0x3B, 0xD7, 0x8D, 0x08, 0x9F, 0x90, 0xD0, 0xAB, 0xA9,
+    0x71, 0x2D, 0x4F, 0x1F, 0x29, 0xFF, 0x00, 0xEB, 0x55, 0xC8, 0xAD, 0x09,
+    0x23, 0x19, 0x3E, 0xB9, 0x15, 0xD7, 0x4D, 0x1E, 0xC5, 0x0A, 0xA5, 0xC8,
+    0xAD, 0x08, 0x03, 0x20, 0xE7, 0xB6, 0x45, 0x5C, 0x8E, 0xD0, 0x28, 0xCE,
+    0x31, 0x91, 0xC9, 0xE9, 0x5D, 0x71, 0xF7, 0x55, 0xDE, 0x88, 0xF6, 0xF0,
+    0xF5, 0x2E, 0x2B, 0xBA, 0xA8, 0x29, 0x0A, 0x86, 0x3F, 0xDE, 0x3C, 0x0F,
+    0xFE, 0xBD, 0x35, 0x20, 0x2E, 0x72, 0xE5, 0x89, 0xFA, 0xF4, 0xAF, 0xCF,
+    0xF3, 0xEC, 0xE1, 0xE3, 0x6A, 0x7B, 0x1A, 0x2F, 0xF7, 0x71, 0xFF, 0x00,
+    0xC9, 0x9F, 0xF9, 0x2E, 0x9F, 0x7F, 0xA7, 0xD2, 0x60, 0xDF, 0x2A, 0xBB,
+    0xDC, 0xC1, 0x8A, 0xCC, 0x16, 0xCF, 0x50, 0x79, 0xAB, 0x90, 0x5A, 0xE0,
+    0x7D, 0xDC, 0x57, 0xD7, 0xC2, 0x27, 0xE2, 0xB4, 0x2B, 0x16, 0xE2, 0xB5,
+    0xC7, 0x3B, 0x7A, 0xFB, 0x55, 0xD8, 0xAC, 0xCE, 0xDE, 0x47, 0xBF, 0xF9,
+    0x15, 0xD9, 0x08, 0x9E, 0xCD, 0x1A, 0xAC, 0x99, 0x96, 0x38, 0x73, 0x91,
+    0x96, 0x3C, 0xE1, 0x7A, 0xD4, 0x46, 0x39, 0x27, 0x39, 0xE4, 0x2E, 0x47,
+    0xCB, 0xE9, 0x5F, 0x23, 0xC4, 0x59, 0xD3, 0x77, 0xC1, 0x50, 0x7F, 0xE2,
+    0x7F, 0xFB, 0x6F, 0xF9, 0xFD, 0xDD, 0xCF, 0xA2, 0xC0, 0xDE, 0xCA, 0x4C,
+    0xB1, 0x1D, 0xAF, 0x39, 0x2B, 0x8F, 0x5A, 0xB9, 0x15, 0xA6, 0x06, 0x71,
+    0x80, 0x3D, 0xAB, 0xE4, 0xA1, 0x1E, 0xC7, 0xD1, 0x61, 0xEA, 0x98, 0x90,
+    0xDA, 0x1C, 0xF0, 0x30, 0x7D, 0x6A, 0xE4, 0x56, 0x98, 0x39, 0x03, 0x38,
+    0xAF, 0xD5, 0x20, 0x8F, 0xC4, 0x28, 0x55, 0x2C, 0xAD, 0xBC, 0x71, 0xA8,
+    0x2C, 0x78, 0xE0, 0x74, 0xFE, 0x54, 0xD2, 0xEC, 0xE0, 0x2C, 0x59, 0x44,
+    0xC7, 0x5C, 0x73, 0xFF, 0x00, 0xD6, 0xAF, 0x13, 0x3E, 0xCE, 0xBE, 0xA5,
+    0x0F, 0x61, 0x45, 0xFE, 0xF1, 0xFE, 0x0B, 0xFC, 0xFB, 0x7D, 0xFD, 0xAF,
+    0xEF, 0xE0, 0x9F, 0x37, 0xBC, 0xF6, 0x11, 0x2C, 0xC6, 0x3D, 0xC7, 0x5A,
+    0xBB, 0x15, 0xA0, 0x18, 0x38, 0xC5, 0x7C, 0x04, 0x16, 0x87, 0xD3, 0x61,
+    0xEB, 0x69, 0xA9, 0x76, 0x3B, 0x43, 0xCE, 0x06, 0x71, 0xD2, 0xAE, 0x47,
+    0x66, 0xBD, 0x40, 0xC7, 0x3D, 0xEB, 0xB2, 0x9C, 0x7B, 0x1E, 0xBD, 0x0A,
+    0xA6, 0x1C, 0x56, 0x81, 0x06, 0xE3, 0xD3, 0xD4, 0xF6, 0xA7, 0x19, 0x15,
+    0x70, 0x22, 0x5D, 0xE4, 0x73, 0x93, 0xD2, 0xBE, 0xEF, 0x36, 0xCD, 0x61,
+    0x97, 0xD1, 0xBE, 0x8E, 0x6F, 0x65, 0xFA, 0xBF, 0x25, 0xF8, 0xEC, 0x7E,
+    0x29, 0x85, 0x6E, 0x6F, 0xC8, 0x60, 0xB6, 0x79, 0x1B, 0x73, 0x1D, 0xC4,
+    0xF3, 0x93, 0x56, 0xA1, 0xB4, 0x18, 0xC6, 0x01, 0x39, 0xAF, 0xCD, 0x5D,
+    0x49, 0xD5, 0x9B, 0xA9, 0x37, 0x76, 0xF7, 0x67, 0xD3, 0x61, 0xEA, 0xD9,
+    0x24, 0x5C, 0x8A, 0xCF, 0xD4, 0x7D, 0x78, 0xAB, 0xB1, 0x5A, 0x0E, 0x37,
+    0x01, 0xD7, 0x35, 0xD1, 0x4D, 0x1E, 0xD6, 0x1E, 0xB1, 0x72, 0x3B, 0x42,
+    0x07, 0x4E, 0x7B, 0x55, 0xB8, 0xAD, 0x49, 0xC0, 0xDB, 0xDA, 0xBB, 0x20,
+    0x8F, 0x6B, 0x0F, 0x57, 0xA9, 0xFF, 0xD9,
+};
+
+// 4:4:4, 64x48
+static const uint8_t jpeg_444[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x30, 0x00, 0x40, 0x03,
+    0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1,
+    0x18, 0xAD, 0x09, 0x60, 0x30, 0x78, 0xAD, 0x63, 0x12, 0x21, 0x54, 0xB9,
+    0x15, 0xA7, 0x19, 0xC1, 0x27, 0x39, 0xC0, 0xAD, 0xA2, 0x8E, 0xC8, 0x55,
+    0xB9, 0x72, 0x3B, 0x43, 0x90, 0x48, 0x3D, 0x2B, 0x68, 0xC7, 0xA2, 0x3B,
+    0x69, 0xD5, 0x4C, 0xB9, 0x1D, 0xAB, 0x06, 0x00, 0x8C, 0xFB, 0xE2, 0xB6,
+    0x48, 0xEC, 0xA7, 0x50, 0xBB, 0x15, 0xAB, 0x64, 0x0C, 0x74, 0x1E, 0x95,
+    0xB2, 0x89, 0xD9, 0x0A, 0xBD, 0x4B, 0xB1, 0xDA, 0xF4, 0x00, 0x9F, 0x42,
+    0x31, 0xDE, 0xB5, 0x8C, 0x5B, 0x3B, 0x69, 0xD4, 0x2D, 0xC7, 0x6C, 0x72,
+    0x38, 0xAD, 0x94, 0x7B, 0x9D, 0xD4, 0xEA, 0xF4, 0x2E, 0xC7, 0x6B, 0xCF,
+    0x23, 0xE9, 0x5B, 0x46, 0x27, 0x5D, 0x3A, 0x9D, 0x4E, 0x1A, 0x2B, 0x5E,
+    0xE3, 0xA8, 0xE9, 0x5F, 0x37, 0x18, 0xD8, 0xFC, 0x5A, 0x15, 0x7A, 0x32,
+    0xDC, 0x56, 0xA7, 0xB8, 0xEF, 0xE9, 0x9E, 0x95, 0xBC, 0x57, 0x63, 0xB2,
+    0x9D, 0x52, 0xF4, 0x36, 0xB9, 0xE3, 0x04, 0x7D, 0x45, 0x6A, 0xA2, 0xEC,
+    0x76, 0x42, 0xB5, 0x8B, 0x70, 0xDA, 0xF1, 0xCA, 0xE3, 0x3E, 0xDF, 0x5A,
+    0xDA, 0x31, 0x3B, 0x29, 0xD6, 0xEC, 0x5D, 0x8A, 0xD3, 0xE5, 0xCE, 0xDE,
+    0x7B, 0xD6, 0xD1, 0x89, 0xDB, 0x0A, 0xBA, 0x97, 0x62, 0xB4, 0xC0, 0x51,
+    0xC0, 0x15, 0xAC, 0x62, 0x76, 0xD3, 0xAC, 0x5C, 0x8A, 0xD0, 0x05, 0x1B,
+    0x57, 0xBF, 0x4A, 0xD9, 0x23, 0xB6, 0x15, 0x6C, 0x5A, 0xF2, 0x23, 0x89,
+    0x0B, 0x49, 0x85, 0x03, 0xDB, 0xAD, 0x4E, 0x27, 0x15, 0x43, 0x09, 0x4F,
+    0xDA, 0xD7, 0x95, 0x97, 0xEB, 0xF9, 0xBF, 0x92, 0xF3, 0x3B, 0x69, 0x4D,
+    0xCB, 0x63, 0x88, 0x86, 0xD4, 0x06, 0xCE, 0x39, 0x35, 0xE2, 0x28, 0xBE,
+    0xA7, 0xE2, 0x91, 0xAB, 0x72, 0xEC, 0x56, 0xBC, 0x8F, 0x94, 0x0F, 0x61,
+    0xDE, 0xB5, 0x8C, 0x6C, 0x76, 0x53, 0xAB, 0xA5, 0x8B, 0x89, 0x6A, 0x78,
+    0xF9, 0x4F, 0xFF, 0x00, 0x5A, 0xB5, 0x8A, 0xB2, 0x3B, 0x29, 0xD5, 0xD0,
+    0xB9, 0x15, 0xA1, 0x24, 0x63, 0x27, 0xD7, 0x22, 0xB7, 0x8A, 0x3B, 0x21,
+    0x57, 0x4D, 0x4B, 0x91, 0x5A, 0x10, 0x06, 0x41, 0xCF, 0x6C, 0x8A, 0xDE,
+    0x2B, 0xB1, 0xDD, 0x4E, 0xAD, 0xCB, 0x91, 0xDA, 0x05, 0x19, 0xC6, 0x32,
+    0x39, 0x3D, 0x2A, 0xDC, 0x94, 0x63, 0xCF, 0x37, 0x64, 0xB5, 0xB9, 0xDD,
+    0x4E, 0xA5, 0xC5, 0x77, 0x55, 0x05, 0x21, 0x50, 0xC7, 0xFB, 0xC7, 0x81,
+    0xFF, 0x00, 0xD7, 0xAF, 0x99, 0xCC, 0xB8, 0xA2, 0x95, 0x07, 0xC9, 0x84,
+    0x4A, 0x72, 0xEE, 0xF6, 0x5A, 0xFC, 0xAF, 0xD7, 0x54, 0xD2, 0xD9, 0xAB,
+    0x9E, 0x95, 0x14, 0xFE, 0xD0, 0xD4, 0x80, 0xB9, 0xCB, 0x96, 0x27, 0xEB,
+    0xD2, 0xBE, 0x22, 0xBE, 0x22, 0xB6, 0x26, 0x7E, 0xD2, 0xB4, 0xB9, 0xA5,
+    0xE7, 0xF7, 0xFC, 0x97, 0xA6, 0x87, 0xAD, 0x4E, 0xA2, 0x8A, 0xB2, 0x30,
+    0x62, 0xB3, 0x05, 0xB3, 0xD4, 0x1E, 0x6B, 0xF4, 0x75, 0x1D, 0x36, 0x3F,
+    0x03, 0x85, 0x52, 0xE4, 0x16, 0xB8, 0x1F, 0x77, 0x15, 0xB2, 0x81, 0xDB,
+    0x0A, 0xDA, 0x5E, 0xE5, 0xB8, 0xAD, 0x71, 0xCE, 0xDE, 0xBE, 0xD5, 0xB2,
+    0x8F, 0x43, 0xBA, 0x15, 0x5E, 0xC5, 0xD8, 0xAC, 0xCE, 0xDE, 0x47, 0xBF,
+    0xF9, 0x15, 0xB2, 0x8F, 0x43, 0xAE, 0x9D, 0x57, 0x7D, 0x09, 0x99, 0x63,
+    0x87, 0x39, 0x19, 0x63, 0xCE, 0x17, 0xAD, 0x79, 0x79, 0x96, 0x77, 0x86,
+    0xCB, 0xD5, 0xA4, 0xF9, 0xA7, 0xFC, 0xAB, 0x7D, 0xBA, 0xF6, 0x5B, 0x79,
+    0xF6, 0x4C, 0xF4, 0x68, 0x73, 0x4F, 0x44, 0x44, 0x63, 0x92, 0x73, 0x9E,
+    0x42, 0xE4, 0x7C, 0xBE, 0x95, 0xF0, 0xB9, 0x8E, 0x73, 0x8A, 0xC7, 0x49,
+    0xA9, 0xBB, 0x41, 0xED, 0x15, 0xB7, 0x4D, 0xFB, 0xFC, 0xFA, 0xEC, 0x96,
+    0xC7, 0xAF, 0x46, 0xD1, 0xD8, 0xB1, 0x1D, 0xAF, 0x39, 0x2B, 0x8F, 0x5A,
+    0xF3, 0x52, 0x47, 0x7D, 0x3A, 0xA5, 0xC8, 0xAD, 0x30, 0x33, 0x8C, 0x01,
+    0xED, 0x5A, 0x28, 0x9D, 0xD4, 0xEA, 0x98, 0x90, 0xDA, 0x1C, 0xF0, 0x30,
+    0x7D, 0x6B, 0xF4, 0xF8, 0xA3, 0xF0, 0x28, 0x55, 0x2E, 0x45, 0x69, 0x83,
+    0x90, 0x33, 0x8A, 0xDA, 0x31, 0x5B, 0x33, 0xB6, 0x9D, 0x52, 0xCA, 0xDB,
+    0xC7, 0x1A, 0x82, 0xC7, 0x8E, 0x07, 0x4F, 0xE5, 0x51, 0x89, 0xC5, 0x50,
+    0xC2, 0x53, 0xF6, 0xB5, 0xE5, 0xCB, 0x1F, 0xEB, 0xA6, 0xEC, 0xEE, 0xA3,
+    0x51, 0xC9, 0xD9, 0x0D, 0x2E, 0xCE, 0x02, 0xC5, 0x94, 0x4C, 0x75, 0xC7,
+    0x3F, 0xFD, 0x6A, 0xF8, 0x8C, 0xCB, 0x8A, 0x6B, 0xD6, 0x6E, 0x9E, 0x17,
+    0xDC, 0x8F, 0x7F, 0xB4, 0xF4, 0xD7, 0xC9, 0x7C, 0xB5, 0xD2, 0xF7, 0xE8,
+    0x7A, 0xD4, 0x22, 0xA2, 0xAF, 0x2D, 0x44, 0x4B, 0x31, 0x8F, 0x71, 0xD6,
+    0xBE, 0x66, 0x0B, 0xA1, 0xE9, 0xD3, 0xAC, 0xD9, 0x76, 0x2B, 0x40, 0x30,
+    0x71, 0x8A, 0xD5, 0x46, 0xE7, 0x7C, 0x2B, 0x17, 0x63, 0xB4, 0x3C, 0xE0,
+    0x67, 0x1D, 0x2B, 0x75, 0x14, 0x75, 0x42, 0xAA, 0xD3, 0xB1, 0x72, 0x3B,
+    0x35, 0xEA, 0x06, 0x39, 0xEF, 0x5B, 0x46, 0x2C, 0xED, 0xA7, 0x58, 0xC3,
+    0x8A, 0xD0, 0x20, 0xDC, 0x7A, 0x7A, 0x9E, 0xD5, 0xFA, 0x63, 0x71, 0x8C,
+    0x5C, 0xA4, 0xEC, 0x97, 0xF5, 0xB9, 0xF8, 0x24, 0x2A, 0xB9, 0x3D, 0x07,
+    0x19, 0x15, 0x70, 0x22, 0x5D, 0xE4, 0x73, 0x93, 0xD2, 0xBE, 0x63, 0x32,
+    0xE2, 0x8A, 0x54, 0x5F, 0xB3, 0xC2, 0x25, 0x39, 0x75, 0x7A, 0xF2, 0xAD,
+    0x7F, 0x1F, 0x54, 0xED, 0xB3, 0xBB, 0xD8, 0xF4, 0xE8, 0xC5, 0xBD, 0x64,
+    0x30, 0x5B, 0x3C, 0x8D, 0xB9, 0x8E, 0xE2, 0x79, 0xC9, 0xAF, 0x88, 0xC4,
+    0x62, 0x6B, 0x62, 0xA7, 0xED, 0x2B, 0x49, 0xC9, 0xFF, 0x00, 0x4F, 0x4E,
+    0xCB, 0xC9, 0x68, 0x7A, 0xB4, 0xAA, 0x59, 0x59, 0x16, 0xA1, 0xB4, 0x18,
+    0xC6, 0x01, 0x39, 0xA1, 0x26, 0x8E, 0xE8, 0x55, 0x2E, 0x45, 0x67, 0xEA,
+    0x3E, 0xBC, 0x56, 0xA9, 0x1D, 0x90, 0xAC, 0x5D, 0x8A, 0xD0, 0x71, 0xB8,
+    0x0E, 0xB9, 0xAD, 0xA3, 0x1D, 0x8E, 0xDA, 0x75, 0xAD, 0xB1, 0x72, 0x3B,
+    0x42, 0x07, 0x4E, 0x7B, 0x56, 0xF1, 0x5A, 0x9D, 0xB4, 0xAA, 0xA6, 0x8B,
+    0x71, 0x5A, 0x93, 0x81, 0xB7, 0xB5, 0x6A, 0xA3, 0x73, 0xBA, 0x9D, 0x6B,
+    0x23, 0xFF, 0xD9,
+};
+
+// Grayscale, 64x48
+static const uint8_t jpeg_gray[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xC0, 0x00, 0x0B, 0x08, 0x00, 0x30,
+    0x00, 0x40, 0x01, 0x01, 0x11, 0x00, 0xFF, 0xC4, 0x00, 0x1F, 0x00, 0x00,
+    0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00, 0x02, 0x01, 0x03,
+    0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7D,
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06,
+    0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08,
+    0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24, 0x33, 0x62, 0x72,
+    0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45,
+    0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75,
+    0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3,
+    0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6,
+    0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9,
+    0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4,
+    0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01,
+    0x00, 0x00, 0x3F, 0x00, 0xF1, 0x18, 0xAD, 0x09, 0x60, 0x30, 0x78, 0xAB,
+    0x91, 0x5A, 0x71, 0x9C, 0x12, 0x73, 0x9C, 0x0A, 0xB9, 0x1D, 0xA1, 0xC8,
+    0x24, 0x1E, 0x95, 0x72, 0x3B, 0x56, 0x0C, 0x01, 0x19, 0xF7, 0xC5, 0x5D,
+    0x8A, 0xD5, 0xB2, 0x06, 0x3A, 0x0F, 0x4A, 0xBB, 0x1D, 0xAF, 0x40, 0x09,
+    0xF4, 0x23, 0x1D, 0xEA, 0xDC, 0x76, 0xC7, 0x23, 0x8A, 0xBB, 0x1D, 0xAF,
+    0x3C, 0x8F, 0xA5, 0x70, 0xD1, 0x5A, 0xF7, 0x1D, 0x47, 0x4A, 0xB7, 0x15,
+    0xA9, 0xEE, 0x3B, 0xFA, 0x67, 0xA5, 0x5E, 0x86, 0xD7, 0x3C, 0x60, 0x8F,
+    0xA8, 0xAB, 0x70, 0xDA, 0xF1, 0xCA, 0xE3, 0x3E, 0xDF, 0x5A, 0xBB, 0x15,
+    0xA7, 0xCB, 0x9D, 0xBC, 0xF7, 0xAB, 0xB1, 0x5A, 0x60, 0x28, 0xE0, 0x0A,
+    0xB9, 0x15, 0xA0, 0x0A, 0x36, 0xAF, 0x7E, 0x95, 0x6B, 0xC8, 0x8E, 0x24,
+    0x2D, 0x26, 0x14, 0x0F, 0x6E, 0xB5, 0xC4, 0x43, 0x6A, 0x03, 0x67, 0x1C,
+    0x9A, 0xBB, 0x15, 0xAF, 0x23, 0xE5, 0x03, 0xD8, 0x77, 0xAB, 0x89, 0x6A,
+    0x78, 0xF9, 0x4F, 0xFF, 0x00, 0x5A, 0xAE, 0x45, 0x68, 0x49, 0x18, 0xC9,
+    0xF5, 0xC8, 0xAB, 0x91, 0x5A, 0x10, 0x06, 0x41, 0xCF, 0x6C, 0x8A, 0xB9,
+    0x1D, 0xA0, 0x51, 0x9C, 0x63, 0x23, 0x93, 0xD2, 0x95, 0xDD, 0x54, 0x14,
+    0x85, 0x43, 0x1F, 0xEF, 0x1E, 0x07, 0xFF, 0x00, 0x5E, 0x9A, 0x90, 0x17,
+    0x39, 0x72, 0xC4, 0xFD, 0x7A, 0x56, 0x0C, 0x56, 0x60, 0xB6, 0x7A, 0x83,
+    0xCD, 0x5C, 0x82, 0xD7, 0x03, 0xEE, 0xE2, 0xAD, 0xC5, 0x6B, 0x8E, 0x76,
+    0xF5, 0xF6, 0xAB, 0xB1, 0x59, 0x9D, 0xBC, 0x8F, 0x7F, 0xF2, 0x2A, 0x66,
+    0x58, 0xE1, 0xCE, 0x46, 0x58, 0xF3, 0x85, 0xEB, 0x51, 0x18, 0xE4, 0x9C,
+    0xE7, 0x90, 0xB9, 0x1F, 0x2F, 0xA5, 0x58, 0x8E, 0xD7, 0x9C, 0x95, 0xC7,
+    0xAD, 0x5C, 0x8A, 0xD3, 0x03, 0x38, 0xC0, 0x1E, 0xD5, 0x89, 0x0D, 0xA1,
+    0xCF, 0x03, 0x07, 0xD6, 0xAE, 0x45, 0x69, 0x83, 0x90, 0x33, 0x8A, 0xB2,
+    0xB6, 0xF1, 0xC6, 0xA0, 0xB1, 0xE3, 0x81, 0xD3, 0xF9, 0x53, 0x4B, 0xB3,
+    0x80, 0xB1, 0x65, 0x13, 0x1D, 0x71, 0xCF, 0xFF, 0x00, 0x5A, 0x91, 0x2C,
+    0xC6, 0x3D, 0xC7, 0x5A, 0xBB, 0x15, 0xA0, 0x18, 0x38, 0xC5, 0x5D, 0x8E,
+    0xD0, 0xF3, 0x81, 0x9C, 0x74, 0xAB, 0x91, 0xD9, 0xAF, 0x50, 0x31, 0xCF,
+    0x7A, 0xC3, 0x8A, 0xD0, 0x20, 0xDC, 0x7A, 0x7A, 0x9E, 0xD4, 0xE3, 0x22,
+    0xAE, 0x04, 0x4B, 0xBC, 0x8E, 0x72, 0x7A, 0x53, 0x05, 0xB3, 0xC8, 0xDB,
+    0x98, 0xEE, 0x27, 0x9C, 0x9A, 0xB5, 0x0D, 0xA0, 0xC6, 0x30, 0x09, 0xCD,
+    0x5C, 0x8A, 0xCF, 0xD4, 0x7D, 0x78, 0xAB, 0xB1, 0x5A, 0x0E, 0x37, 0x01,
+    0xD7, 0x35, 0x72, 0x3B, 0x42, 0x07, 0x4E, 0x7B, 0x55, 0xB8, 0xAD, 0x49,
+    0xC0, 0xDB, 0xDA, 0xBF, 0xFF, 0xD9,
+};
+
+// 4:2:0, 64x48, restart every 3 MCUs
+static const uint8_t jpeg_420_rst[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x30, 0x00, 0x40, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDD, 0x00,
+    0x04, 0x00, 0x03, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11,
+    0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1, 0x18, 0xAD, 0x09, 0x60, 0x30, 0x78,
+    0xAB, 0x91, 0x5A, 0x71, 0x9C, 0x12, 0x73, 0x9C, 0x0A, 0xD1, 0x8A, 0xD7,
+    0xB8, 0xEA, 0x3A, 0x55, 0xB8, 0xAD, 0x4F, 0x71, 0xDF, 0xD3, 0x3D, 0x2B,
+    0xAE, 0x9C, 0x0C, 0x68, 0x62, 0x8C, 0xF8, 0xED, 0x0E, 0x41, 0x20, 0xF4,
+    0xAB, 0x91, 0xDA, 0xB0, 0x60, 0x08, 0xCF, 0xBE, 0x2B, 0x4A, 0x1B, 0x5C,
+    0xF1, 0x82, 0x3E, 0xA2, 0xAD, 0xC3, 0x6B, 0xC7, 0x2B, 0x8C, 0xFB, 0x7D,
+    0x6B, 0xB2, 0x10, 0x3D, 0x8A, 0x18, 0xB3, 0x3E, 0x2B, 0x56, 0xC8, 0x18,
+    0xE8, 0x3D, 0x2A, 0xEC, 0x76, 0xBD, 0x00, 0x27, 0xD0, 0x8C, 0x77, 0xAD,
+    0x08, 0xAD, 0x3E, 0x5C, 0xED, 0xE7, 0xBD, 0x5D, 0x8A, 0xD3, 0x01, 0x47,
+    0x00, 0x57, 0x5C, 0x20, 0x7B, 0x54, 0x31, 0x47, 0xFF, 0xD0, 0xE6, 0xA3,
+    0xB6, 0x39, 0x1C, 0x55, 0xD8, 0xED, 0x79, 0xE4, 0x7D, 0x2B, 0x46, 0x2B,
+    0x40, 0x14, 0x6D, 0x5E, 0xFD, 0x2A, 0xD7, 0x91, 0x1C, 0x48, 0x5A, 0x4C,
+    0x28, 0x1E, 0xDD, 0x6B, 0xEB, 0x17, 0x24, 0x22, 0xE7, 0x37, 0x64, 0xBA,
+    0xB3, 0xF4, 0x5A, 0x18, 0xAB, 0xD8, 0xE2, 0x21, 0xB5, 0x01, 0xB3, 0x8E,
+    0x4D, 0x5D, 0x8A, 0xD7, 0x91, 0xF2, 0x81, 0xEC, 0x3B, 0xD6, 0x8C, 0x56,
+    0x60, 0xB6, 0x7A, 0x83, 0xCD, 0x5C, 0x82, 0xD7, 0x03, 0xEE, 0xE2, 0xBC,
+    0x88, 0x40, 0xFC, 0x3A, 0x86, 0x2C, 0xCE, 0x4B, 0x53, 0xC7, 0xCA, 0x7F,
+    0xFA, 0xD5, 0x72, 0x2B, 0x42, 0x48, 0xC6, 0x4F, 0xAE, 0x45, 0x68, 0x45,
+    0x6B, 0x8E, 0x76, 0xF5, 0xF6, 0xAB, 0xB1, 0x59, 0x9D, 0xBC, 0x8F, 0x7F,
+    0xF2, 0x2B, 0xB2, 0x9C, 0x0F, 0x66, 0x86, 0x28, 0xFF, 0xD1, 0x64, 0x56,
+    0x84, 0x01, 0x90, 0x73, 0xDB, 0x22, 0xAE, 0x47, 0x68, 0x14, 0x67, 0x18,
+    0xC8, 0xE4, 0xF4, 0xAB, 0x6C, 0xB1, 0xC3, 0x9C, 0x8C, 0xB1, 0xE7, 0x0B,
+    0xD6, 0xA2, 0x31, 0xC9, 0x39, 0xCF, 0x21, 0x72, 0x3E, 0x5F, 0x4A, 0xF4,
+    0x33, 0x0C, 0xF7, 0x0B, 0x81, 0xBC, 0x13, 0xE6, 0x9F, 0x65, 0xD3, 0xD5,
+    0xF4, 0xFC, 0xFC, 0x8E, 0xCC, 0x25, 0x67, 0x2D, 0x48, 0x9D, 0xD5, 0x41,
+    0x48, 0x54, 0x31, 0xFE, 0xF1, 0xE0, 0x7F, 0xF5, 0xE9, 0xA9, 0x01, 0x73,
+    0x97, 0x2C, 0x4F, 0xD7, 0xA5, 0x5F, 0x8E, 0xD7, 0x9C, 0x95, 0xC7, 0xAD,
+    0x5C, 0x8A, 0xD3, 0x03, 0x38, 0xC0, 0x1E, 0xD5, 0xF1, 0x18, 0xEC, 0xCF,
+    0x15, 0x8F, 0x95, 0xEA, 0xBD, 0x3A, 0x25, 0xB2, 0xFF, 0x00, 0x3F, 0x9D,
+    0xCF, 0xA2, 0xC2, 0xD7, 0x51, 0xD8, 0xC4, 0x86, 0xD0, 0xE7, 0x81, 0x83,
+    0xEB, 0x57, 0x22, 0xB4, 0xC1, 0xC8, 0x19, 0xC5, 0x68, 0x45, 0x68, 0x10,
+    0x6E, 0x3D, 0x3D, 0x4F, 0x6A, 0x71, 0x91, 0x57, 0x02, 0x25, 0xDE, 0x47,
+    0x39, 0x3D, 0x2B, 0xEE, 0xF1, 0x38, 0xDC, 0x3E, 0x0A, 0x1C, 0xF5, 0xE5,
+    0x6F, 0xCD, 0xFA, 0x23, 0xF0, 0x2C, 0x36, 0x21, 0xC9, 0xE8, 0x7F, 0xFF,
+    0xD2, 0xDD, 0x5B, 0x78, 0xE3, 0x50, 0x58, 0xF1, 0xC0, 0xE9, 0xFC, 0xA9,
+    0xA5, 0xD9, 0xC0, 0x58, 0xB2, 0x89, 0x8E, 0xB8, 0xE7, 0xFF, 0x00, 0xAD,
+    0x56, 0x05, 0xB3, 0xC8, 0xDB, 0x98, 0xEE, 0x27, 0x9C, 0x9A, 0xB5, 0x0D,
+    0xA0, 0xC6, 0x30, 0x09, 0xCD, 0x78, 0x19, 0x87, 0x12, 0x62, 0x31, 0x5E,
+    0xE5, 0x0F, 0x72, 0x3F, 0x8B, 0xF9, 0xF4, 0xF9, 0x7D, 0xE7, 0xC9, 0xE1,
+    0x6A, 0xA8, 0xD9, 0xBD, 0x59, 0x98, 0x96, 0x63, 0x1E, 0xE3, 0xAD, 0x5D,
+    0x8A, 0xD0, 0x0C, 0x1C, 0x62, 0xB4, 0xA2, 0xB3, 0xF5, 0x1F, 0x5E, 0x2A,
+    0xEC, 0x56, 0x83, 0x8D, 0xC0, 0x75, 0xCD, 0x78, 0x70, 0x81, 0xF4, 0x18,
+    0x7C, 0x59, 0x9B, 0x1D, 0xA1, 0xE7, 0x03, 0x38, 0xE9, 0x57, 0x23, 0xB3,
+    0x5E, 0xA0, 0x63, 0x9E, 0xF5, 0xA5, 0x1D, 0xA1, 0x03, 0xA7, 0x3D, 0xAA,
+    0xDC, 0x56, 0xA4, 0xE0, 0x6D, 0xED, 0x5D, 0xB0, 0x81, 0xEC, 0xE1, 0xF1,
+    0x5E, 0x67, 0xFF, 0xD9,
+};
+
+// 4:4:4, 64x48, restart every MCU row
+static const uint8_t jpeg_444_rst[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x30, 0x00, 0x40, 0x03,
+    0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDD, 0x00,
+    0x04, 0x00, 0x08, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11,
+    0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1, 0x18, 0xAD, 0x09, 0x60, 0x30, 0x78,
+    0xAD, 0x63, 0x12, 0x21, 0x54, 0xB9, 0x15, 0xA7, 0x19, 0xC1, 0x27, 0x39,
+    0xC0, 0xAD, 0xA2, 0x8E, 0xC8, 0x55, 0xB9, 0x72, 0x3B, 0x43, 0x90, 0x48,
+    0x3D, 0x2B, 0x68, 0xC7, 0xA2, 0x3B, 0x69, 0xD5, 0x4C, 0xB9, 0x1D, 0xAB,
+    0x06, 0x00, 0x8C, 0xFB, 0xE2, 0xB6, 0x48, 0xEC, 0xA7, 0x50, 0xBB, 0x15,
+    0xAB, 0x64, 0x0C, 0x74, 0x1E, 0x95, 0xB2, 0x89, 0xD9, 0x0A, 0xBD, 0x4B,
+    0xB1, 0xDA, 0xF4, 0x00, 0x9F, 0x42, 0x31, 0xDE, 0xB5, 0x8C, 0x5B, 0x3B,
+    0x69, 0xD4, 0x2D, 0xC7, 0x6C, 0x72, 0x38, 0xAD, 0x94, 0x7B, 0x9D, 0xD4,
+    0xEA, 0xF4, 0x2E, 0xC7, 0x6B, 0xCF, 0x23, 0xE9, 0x5B, 0x46, 0x27, 0x5D,
+    0x3A, 0x9D, 0x4F, 0xFF, 0xD0, 0xF2, 0xE8, 0xAD, 0x7B, 0x8E, 0xA3, 0xA5,
+    0x75, 0x46, 0x36, 0x3C, 0xA8, 0x55, 0xE8, 0xCB, 0x71, 0x5A, 0x9E, 0xE3,
+    0xBF, 0xA6, 0x7A, 0x56, 0xF1, 0x5D, 0x8E, 0xCA, 0x75, 0x4B, 0xD0, 0xDA,
+    0xE7, 0x8C, 0x11, 0xF5, 0x15, 0xAA, 0x8B, 0xB1, 0xD9, 0x0A, 0xD6, 0x2D,
+    0xC3, 0x6B, 0xC7, 0x2B, 0x8C, 0xFB, 0x7D, 0x6B, 0x68, 0xC4, 0xEC, 0xA7,
+    0x5B, 0xB1, 0x76, 0x2B, 0x4F, 0x97, 0x3B, 0x79, 0xEF, 0x5B, 0x46, 0x27,
+    0x6C, 0x2A, 0xEA, 0x5D, 0x8A, 0xD3, 0x01, 0x47, 0x00, 0x56, 0xB1, 0x89,
+    0xDB, 0x4E, 0xB1, 0x72, 0x2B, 0x40, 0x14, 0x6D, 0x5E, 0xFD, 0x2B, 0x64,
+    0x8E, 0xD8, 0x55, 0xB1, 0x6B, 0xC8, 0x8E, 0x24, 0x2D, 0x26, 0x14, 0x0F,
+    0x6E, 0xB5, 0x38, 0x9C, 0x55, 0x0C, 0x25, 0x3F, 0x6B, 0x5E, 0x56, 0x5F,
+    0xAF, 0xE6, 0xFE, 0x4B, 0xCC, 0xED, 0xA5, 0x37, 0x2D, 0x8F, 0xFF, 0xD1,
+    0xE2, 0xE1, 0xB5, 0x01, 0xB3, 0x8E, 0x4D, 0x7A, 0x0A, 0x2F, 0xA9, 0xF2,
+    0xF1, 0xAB, 0x72, 0xEC, 0x56, 0xBC, 0x8F, 0x94, 0x0F, 0x61, 0xDE, 0xB5,
+    0x8C, 0x6C, 0x76, 0x53, 0xAB, 0xA5, 0x8B, 0x89, 0x6A, 0x78, 0xF9, 0x4F,
+    0xFF, 0x00, 0x5A, 0xB5, 0x8A, 0xB2, 0x3B, 0x29, 0xD5, 0xD0, 0xB9, 0x15,
+    0xA1, 0x24, 0x63, 0x27, 0xD7, 0x22, 0xB7, 0x8A, 0x3B, 0x21, 0x57, 0x4D,
+    0x4B, 0x91, 0x5A, 0x10, 0x06, 0x41, 0xCF, 0x6C, 0x8A, 0xDE, 0x2B, 0xB1,
+    0xDD, 0x4E, 0xAD, 0xCB, 0x91, 0xDA, 0x05, 0x19, 0xC6, 0x32, 0x39, 0x3D,
+    0x2A, 0xDC, 0x94, 0x63, 0xCF, 0x37, 0x64, 0xB5, 0xB9, 0xDD, 0x4E, 0xA5,
+    0xC5, 0x77, 0x55, 0x05, 0x21, 0x50, 0xC7, 0xFB, 0xC7, 0x81, 0xFF, 0x00,
+    0xD7, 0xAF, 0x99, 0xCC, 0xB8, 0xA2, 0x95, 0x07, 0xC9, 0x84, 0x4A, 0x72,
+    0xEE, 0xF6, 0x5A, 0xFC, 0xAF, 0xD7, 0x54, 0xD2, 0xD9, 0xAB, 0x9E, 0x95,
+    0x14, 0xFE, 0xD0, 0xD4, 0x80, 0xB9, 0xCB, 0x96, 0x27, 0xEB, 0xD2, 0xBE,
+    0x22, 0xBE, 0x22, 0xB6, 0x26, 0x7E, 0xD2, 0xB4, 0xB9, 0xA5, 0xE7, 0xF7,
+    0xFC, 0x97, 0xA6, 0x87, 0xAD, 0x4E, 0xA2, 0x8A, 0xB2, 0x3F, 0xFF, 0xD2,
+    0xC9, 0x8A, 0xCC, 0x16, 0xCF, 0x50, 0x79, 0xAF, 0x55, 0x47, 0x4D, 0x8F,
+    0x83, 0x85, 0x52, 0xE4, 0x16, 0xB8, 0x1F, 0x77, 0x15, 0xB2, 0x81, 0xDB,
+    0x0A, 0xDA, 0x5E, 0xE5, 0xB8, 0xAD, 0x71, 0xCE, 0xDE, 0xBE, 0xD5, 0xB2,
+    0x8F, 0x43, 0xBA, 0x15, 0x5E, 0xC5, 0xD8, 0xAC, 0xCE, 0xDE, 0x47, 0xBF,
+    0xF9, 0x15, 0xB2, 0x8F, 0x43, 0xAE, 0x9D, 0x57, 0x7D, 0x09, 0x99, 0x63,
+    0x87, 0x39, 0x19, 0x63, 0xCE, 0x17, 0xAD, 0x79, 0x79, 0x96, 0x77, 0x86,
+    0xCB, 0xD5, 0xA4, 0xF9, 0xA7, 0xFC, 0xAB, 0x7D, 0xBA, 0xF6, 0x5B, 0x79,
+    0xF6, 0x4C, 0xF4, 0x68, 0x73, 0x4F, 0x44, 0x44, 0x63, 0x92, 0x73, 0x9E,
+    0x42, 0xE4, 0x7C, 0xBE, 0x95, 0xF0, 0xB9, 0x8E, 0x73, 0x8A, 0xC7, 0x49,
+    0xA9, 0xBB, 0x41, 0xED, 0x15, 0xB7, 0x4D, 0xFB, 0xFC, 0xFA, 0xEC, 0x96,
+    0xC7, 0xAF, 0x46, 0xD1, 0xD8, 0xB1, 0x1D, 0xAF, 0x39, 0x2B, 0x8F, 0x5A,
+    0xF3, 0x52, 0x47, 0x7D, 0x3A, 0xA5, 0xC8, 0xAD, 0x30, 0x33, 0x8C, 0x01,
+    0xED, 0x5A, 0x28, 0x9D, 0xD4, 0xEA, 0x9F, 0xFF, 0xD3, 0xB1, 0x0D, 0xA1,
+    0xCF, 0x03, 0x07, 0xD6, 0xBD, 0xA8, 0xA3, 0xF3, 0x18, 0x55, 0x2E, 0x45,
+    0x69, 0x83, 0x90, 0x33, 0x8A, 0xDA, 0x31, 0x5B, 0x33, 0xB6, 0x9D, 0x52,
+    0xCA, 0xDB, 0xC7, 0x1A, 0x82, 0xC7, 0x8E, 0x07, 0x4F, 0xE5, 0x51, 0x89,
+    0xC5, 0x50, 0xC2, 0x53, 0xF6, 0xB5, 0xE5, 0xCB, 0x1F, 0xEB, 0xA6, 0xEC,
+    0xEE, 0xA3, 0x51, 0xC9, 0xD9, 0x0D, 0x2E, 0xCE, 0x02, 0xC5, 0x94, 0x4C,
+    0x75, 0xC7, 0x3F, 0xFD, 0x6A, 0xF8, 0x8C, 0xCB, 0x8A, 0x6B, 0xD6, 0x6E,
+    0x9E, 0x17, 0xDC, 0x8F, 0x7F, 0xB4, 0xF4, 0xD7, 0xC9, 0x7C, 0xB5, 0xD2,
+    0xF7, 0xE8, 0x7A, 0xD4, 0x22, 0xA2, 0xAF, 0x2D, 0x44, 0x4B, 0x31, 0x8F,
+    0x71, 0xD6, 0xBE, 0x66, 0x0B, 0xA1, 0xE9, 0xD3, 0xAC, 0xD9, 0x76, 0x2B,
+    0x40, 0x30, 0x71, 0x8A, 0xD5, 0x46, 0xE7, 0x7C, 0x2B, 0x17, 0x63, 0xB4,
+    0x3C, 0xE0, 0x67, 0x1D, 0x2B, 0x75, 0x14, 0x75, 0x42, 0xAA, 0xD3, 0xB1,
+    0x72, 0x3B, 0x35, 0xEA, 0x06, 0x39, 0xEF, 0x5B, 0x46, 0x2C, 0xED, 0xA7,
+    0x58, 0xFF, 0xD4, 0xE9, 0x22, 0xB4, 0x08, 0x37, 0x1E, 0x9E, 0xA7, 0xB5,
+    0x7B, 0xCD, 0xC6, 0x31, 0x72, 0x93, 0xB2, 0x5F, 0xD6, 0xE7, 0xE4, 0x10,
+    0xAA, 0xE4, 0xF4, 0x1C, 0x64, 0x55, 0xC0, 0x89, 0x77, 0x91, 0xCE, 0x4F,
+    0x4A, 0xF9, 0x8C, 0xCB, 0x8A, 0x29, 0x51, 0x7E, 0xCF, 0x08, 0x94, 0xE5,
+    0xD5, 0xEB, 0xCA, 0xB5, 0xFC, 0x7D, 0x53, 0xB6, 0xCE, 0xEF, 0x63, 0xD3,
+    0xA3, 0x16, 0xF5, 0x90, 0xC1, 0x6C, 0xF2, 0x36, 0xE6, 0x3B, 0x89, 0xE7,
+    0x26, 0xBE, 0x23, 0x11, 0x89, 0xAD, 0x8A, 0x9F, 0xB4, 0xAD, 0x27, 0x27,
+    0xFD, 0x3D, 0x3B, 0x2F, 0x25, 0xA1, 0xEA, 0xD2, 0xA9, 0x65, 0x64, 0x5A,
+    0x86, 0xD0, 0x63, 0x18, 0x04, 0xE6, 0x84, 0x9A, 0x3B, 0xA1, 0x54, 0xB9,
+    0x15, 0x9F, 0xA8, 0xFA, 0xF1, 0x5A, 0xA4, 0x76, 0x42, 0xB1, 0x76, 0x2B,
+    0x41, 0xC6, 0xE0, 0x3A, 0xE6, 0xB6, 0x8C, 0x76, 0x3B, 0x69, 0xD6, 0xB6,
+    0xC5, 0xC8, 0xED, 0x08, 0x1D, 0x39, 0xED, 0x5B, 0xC5, 0x6A, 0x76, 0xD2,
+    0xAA, 0x9A, 0x2D, 0xC5, 0x6A, 0x4E, 0x06, 0xDE, 0xD5, 0xAA, 0x8D, 0xCE,
+    0xEA, 0x75, 0xAC, 0x8F, 0xFF, 0xD9,
+};
+
+// 4:2:0, 61x45, partial MCUs on the edges
+static const uint8_t jpeg_420_odd[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x2D, 0x00, 0x3D, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1,
+    0x28, 0xED, 0x7B, 0xE3, 0xA6, 0x2A, 0xE4, 0x56, 0x99, 0xC1, 0x03, 0x8F,
+    0xA5, 0x69, 0xC7, 0x66, 0x37, 0x74, 0xC7, 0x7C, 0xD5, 0xC8, 0xED, 0x06,
+    0x4E, 0x17, 0x90, 0x2B, 0xAA, 0x9C, 0x0C, 0x68, 0x62, 0xCC, 0xD8, 0xAC,
+    0xF8, 0xC1, 0x07, 0x3F, 0x5E, 0x95, 0x76, 0x3B, 0x32, 0xA0, 0x60, 0x77,
+    0xAD, 0x28, 0xAC, 0xBA, 0x0D, 0xB9, 0xAB, 0xD1, 0xD9, 0xE0, 0x82, 0x07,
+    0xE3, 0xE9, 0x5D, 0x74, 0xE2, 0x7B, 0x54, 0x31, 0x66, 0x64, 0x56, 0x6D,
+    0xC6, 0x07, 0x5E, 0x33, 0x8E, 0x95, 0x71, 0x2D, 0x58, 0x60, 0x01, 0x8A,
+    0xD3, 0x8A, 0xCF, 0x24, 0x0C, 0x1F, 0xCA, 0xAE, 0x45, 0x6A, 0xDC, 0x01,
+    0x8C, 0xFD, 0x3A, 0xD7, 0x5D, 0x38, 0x1E, 0xD6, 0x1F, 0x16, 0x66, 0xC3,
+    0x69, 0xC7, 0x39, 0xF5, 0x35, 0x71, 0x2D, 0x3E, 0x5E, 0x40, 0xFC, 0xAB,
+    0x4E, 0x2B, 0x41, 0xB7, 0x38, 0xFC, 0xB1, 0x56, 0xD2, 0xD7, 0x00, 0xE1,
+    0x71, 0x9F, 0xF6, 0x73, 0x5D, 0x50, 0x86, 0x87, 0xB5, 0x47, 0x17, 0xA1,
+    0xC4, 0x47, 0x68, 0x00, 0xFB, 0xB8, 0x3E, 0xC2, 0xAE, 0x45, 0x67, 0x92,
+    0x06, 0x39, 0xFA, 0x56, 0x92, 0x59, 0xE3, 0x19, 0x1D, 0x6A, 0xEC, 0x36,
+    0x6A, 0x0E, 0x31, 0x9A, 0xF1, 0xE1, 0x03, 0xF0, 0x9A, 0x18, 0xB3, 0x32,
+    0x2B, 0x43, 0xD7, 0x18, 0xCF, 0x51, 0x56, 0xE3, 0xB3, 0x1C, 0x13, 0x83,
+    0x81, 0xEB, 0xD2, 0xB5, 0x21, 0xB2, 0xF9, 0x97, 0x03, 0xF1, 0xAB, 0xD1,
+    0xD9, 0xE5, 0x7A, 0x74, 0x1C, 0x63, 0xFA, 0x57, 0x64, 0x22, 0x7B, 0x54,
+    0x31, 0x7E, 0x66, 0x5C, 0x36, 0x98, 0xC3, 0x1E, 0x7F, 0x0A, 0xB8, 0x96,
+    0x81, 0x46, 0xE3, 0xF9, 0xD5, 0xE6, 0x11, 0xC0, 0x40, 0xC6, 0x4F, 0xA0,
+    0xA8, 0x99, 0x25, 0x9B, 0xEF, 0x92, 0x17, 0x27, 0x0A, 0x0F, 0x4F, 0xF1,
+    0xAF, 0x37, 0x30, 0xCF, 0x70, 0xD8, 0x1B, 0xC3, 0xE2, 0x9F, 0x65, 0xD3,
+    0xD5, 0xF4, 0xFC, 0xFC, 0x8F, 0xA0, 0xC2, 0x56, 0x94, 0xAC, 0x40, 0xCE,
+    0xB1, 0xB6, 0x23, 0x50, 0xC7, 0xA6, 0xEE, 0xC2, 0x91, 0x6D, 0x8C, 0x9F,
+    0x33, 0x0D, 0xD9, 0xE9, 0x91, 0x57, 0xA2, 0xB4, 0x04, 0x80, 0x07, 0x35,
+    0x6D, 0x6D, 0x36, 0x8C, 0x1E, 0x07, 0x6C, 0xD7, 0xC4, 0x63, 0xB3, 0x3C,
+    0x4E, 0x61, 0x2B, 0xD6, 0x7A, 0x74, 0x4B, 0x65, 0xFD, 0x79, 0x9F, 0x47,
+    0x86, 0xC4, 0x46, 0x0B, 0x43, 0x1A, 0x2B, 0x3C, 0x9C, 0xED, 0xCF, 0x1D,
+    0xEA, 0xDC, 0x56, 0x67, 0x81, 0xD7, 0xA6, 0x31, 0x57, 0xD2, 0x25, 0x04,
+    0x64, 0x64, 0x75, 0xA9, 0xA6, 0x2B, 0x6D, 0x82, 0xA8, 0x09, 0x3D, 0x33,
+    0xDA, 0xBE, 0xFA, 0xBE, 0x22, 0x96, 0x12, 0x8B, 0xAF, 0x55, 0xDA, 0x2B,
+    0xFE, 0x18, 0xFE, 0x7D, 0xC3, 0x62, 0x64, 0xDA, 0x48, 0xAA, 0xB6, 0xC2,
+    0x31, 0xB9, 0xC2, 0x8F, 0x7C, 0x75, 0x34, 0xC6, 0x66, 0x6C, 0x2C, 0x43,
+    0x62, 0x11, 0xD4, 0x8E, 0x6A, 0x74, 0x8C, 0x49, 0xB6, 0x47, 0x24, 0x9E,
+    0xD9, 0xED, 0x56, 0xA2, 0xB7, 0x4C, 0x8F, 0x73, 0x8A, 0xF8, 0x8C, 0xC3,
+    0x89, 0x31, 0x18, 0x9F, 0x72, 0x87, 0xB9, 0x1F, 0xC5, 0xFC, 0xFA, 0x7C,
+    0xBE, 0xF3, 0xE9, 0x70, 0x95, 0x14, 0x6C, 0xDE, 0xA5, 0x08, 0xAC, 0xB0,
+    0x47, 0xD6, 0xAE, 0x47, 0x69, 0xEA, 0x05, 0x68, 0x47, 0x6E, 0xAA, 0x00,
+    0xEB, 0xDA, 0xAE, 0xC5, 0x6E, 0xA4, 0x7D, 0x4E, 0x2B, 0xC3, 0x84, 0x4F,
+    0xA0, 0xA1, 0x8A, 0x66, 0x7C, 0x76, 0x67, 0x03, 0x23, 0x8E, 0xD5, 0x76,
+    0x3B, 0x2F, 0x97, 0xA6, 0x6B, 0x46, 0x3B, 0x74, 0xC8, 0xFF, 0x00, 0x3E,
+    0x95, 0x60, 0x42, 0x80, 0x0E, 0xBE, 0xB5, 0xD9, 0x08, 0xF4, 0x47, 0xB5,
+    0x47, 0x14, 0xDA, 0x3F, 0xFF, 0xD9,
+};
+
+// 4:2:0, 64x64, big enough for a static scene signature
+static const uint8_t jpeg_420_sq[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08, 0x07, 0x07, 0x07, 0x09,
+    0x09, 0x08, 0x0A, 0x0C, 0x14, 0x0D, 0x0C, 0x0B, 0x0B, 0x0C, 0x19, 0x12,
+    0x13, 0x0F, 0x14, 0x1D, 0x1A, 0x1F, 0x1E, 0x1D, 0x1A, 0x1C, 0x1C, 0x20,
+    0x24, 0x2E, 0x27, 0x20, 0x22, 0x2C, 0x23, 0x1C, 0x1C, 0x28, 0x37, 0x29,
+    0x2C, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1F, 0x27, 0x39, 0x3D, 0x38, 0x32,
+    0x3C, 0x2E, 0x33, 0x34, 0x32, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x09, 0x09,
+    0x09, 0x0C, 0x0B, 0x0C, 0x18, 0x0D, 0x0D, 0x18, 0x32, 0x21, 0x1C, 0x21,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+    0x32, 0x32, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x40, 0x00, 0x40, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF0,
+    0xE8, 0xAD, 0x89, 0x6C, 0x60, 0xE0, 0x55, 0xC8, 0xAD, 0xB8, 0xCE, 0x09,
+    0x39, 0xED, 0x56, 0xE2, 0xB7, 0xEE, 0x3A, 0x8E, 0x95, 0x6E, 0x2B, 0x73,
+    0xDC, 0x73, 0x9F, 0x4C, 0xD7, 0x75, 0x3A, 0x44, 0xD0, 0xC4, 0x15, 0x63,
+    0xB7, 0x39, 0x04, 0xE7, 0xA7, 0x5A, 0xB9, 0x1C, 0x0C, 0x18, 0x03, 0xCF,
+    0x3D, 0x71, 0x57, 0x21, 0x83, 0x3C, 0x60, 0x8F, 0xA8, 0xAB, 0x70, 0xDB,
+    0xF1, 0xC8, 0xC6, 0x7D, 0xBE, 0xB5, 0xD9, 0x0A, 0x47, 0xB1, 0x43, 0x10,
+    0x55, 0x8A, 0xDD, 0xB2, 0x06, 0x31, 0x81, 0x57, 0x63, 0xB7, 0xE8, 0x01,
+    0x3E, 0x84, 0x7B, 0xD5, 0xA8, 0xAD, 0xBE, 0x5C, 0xED, 0xE7, 0xBD, 0x5D,
+    0x8A, 0xDB, 0x1B, 0x47, 0x02, 0xBA, 0xE1, 0x48, 0xF6, 0x68, 0x62, 0x0A,
+    0x71, 0xC0, 0x72, 0x38, 0xAB, 0xB1, 0xDB, 0xF3, 0xC8, 0xFA, 0x55, 0xA8,
+    0xAD, 0xB0, 0xA3, 0x68, 0xEF, 0xE9, 0x56, 0xBC, 0xB4, 0x89, 0x0B, 0x49,
+    0x80, 0x07, 0xB7, 0x5A, 0xE9, 0x51, 0x84, 0x22, 0xE7, 0x37, 0x64, 0xBA,
+    0xB3, 0xDA, 0xA1, 0x88, 0xBD, 0x8E, 0x0E, 0x1B, 0x70, 0x1B, 0x38, 0xEB,
+    0x9A, 0xBB, 0x15, 0xB8, 0xC8, 0xF9, 0x40, 0xF6, 0x1D, 0xEA, 0xDC, 0x56,
+    0xA0, 0xB0, 0x27, 0x24, 0x1E, 0x6A, 0xE4, 0x16, 0xF8, 0x1F, 0x77, 0x15,
+    0xE7, 0xC2, 0x91, 0xF8, 0xB5, 0x0C, 0x49, 0x51, 0x2D, 0xCF, 0x1F, 0x2E,
+    0x7F, 0xC2, 0xAE, 0x45, 0x6D, 0x92, 0x31, 0x93, 0x9E, 0xB9, 0x15, 0x6A,
+    0x2B, 0x7C, 0x73, 0xB7, 0xAF, 0xB5, 0x5D, 0x8A, 0xD8, 0xED, 0xE7, 0xEB,
+    0x5D, 0x94, 0xE9, 0x1E, 0xCD, 0x0C, 0x41, 0x52, 0x2B, 0x62, 0x00, 0xC8,
+    0x39, 0xED, 0x91, 0x56, 0xE3, 0xB6, 0x0A, 0x33, 0xD3, 0x23, 0xAE, 0x71,
+    0x52, 0xB7, 0x97, 0x0E, 0x72, 0x32, 0xC7, 0x9C, 0x2F, 0x5A, 0x8C, 0x89,
+    0x27, 0x39, 0x39, 0x0B, 0x91, 0xF2, 0xFA, 0x57, 0x9D, 0x98, 0x67, 0x78,
+    0x5C, 0x0D, 0xE0, 0x9F, 0x34, 0xFB, 0x2E, 0x9E, 0xAF, 0xA7, 0xE7, 0xE4,
+    0x7B, 0xD8, 0x49, 0xCA, 0x5A, 0x83, 0xCA, 0xAA, 0x0A, 0x42, 0xA1, 0x8F,
+    0xF7, 0x8F, 0x00, 0x7F, 0x8D, 0x22, 0x44, 0x5C, 0xE5, 0xC9, 0x27, 0xEB,
+    0xD2, 0xAC, 0x47, 0x6F, 0x83, 0x92, 0xB8, 0xF5, 0xAB, 0xB1, 0x5B, 0xE0,
+    0x67, 0x04, 0x01, 0xC9, 0xE2, 0xBE, 0x23, 0x1D, 0x98, 0xE2, 0xB1, 0xF2,
+    0xBD, 0x57, 0xA7, 0x44, 0xB6, 0x5F, 0xE7, 0xF3, 0xB9, 0xF4, 0x78, 0x5A,
+    0xAA, 0x2B, 0x43, 0x9D, 0x86, 0xD8, 0xE7, 0x81, 0x83, 0xEB, 0x57, 0x62,
+    0xB6, 0xC1, 0xC8, 0x19, 0xC5, 0x5A, 0x8A, 0xDB, 0xCB, 0x1B, 0x9B, 0x81,
+    0xEA, 0x7B, 0x52, 0x99, 0x95, 0x30, 0x22, 0x5D, 0xE4, 0x0C, 0xE4, 0xF4,
+    0xAF, 0xD0, 0x71, 0x38, 0xBC, 0x3E, 0x0A, 0x1C, 0xF5, 0xE5, 0x6F, 0xCD,
+    0xFA, 0x23, 0xF0, 0xAC, 0x35, 0x67, 0x27, 0xA0, 0xC5, 0x8A, 0x38, 0xD7,
+    0x2C, 0x78, 0xE0, 0x74, 0xFE, 0x54, 0xD3, 0x2B, 0x38, 0x0B, 0x16, 0x51,
+    0x08, 0xEB, 0x8E, 0x7F, 0xFA, 0xD4, 0xE1, 0x03, 0xC8, 0xDB, 0x98, 0x96,
+    0x27, 0x9C, 0x9A, 0xB5, 0x0D, 0xB8, 0xC0, 0x18, 0x04, 0xE6, 0xBE, 0x33,
+    0x30, 0xE2, 0x2C, 0x46, 0x2B, 0xDC, 0xA1, 0xEE, 0x43, 0xF1, 0x7F, 0x3E,
+    0x9F, 0x2F, 0xBC, 0xFA, 0x3C, 0x2C, 0xD4, 0x75, 0x7A, 0xB2, 0x9A, 0x5A,
+    0x8C, 0x7B, 0x8E, 0xB5, 0x76, 0x2B, 0x60, 0x30, 0x71, 0x8A, 0xB9, 0x0D,
+    0xAF, 0xA8, 0x3C, 0x75, 0xE2, 0xAE, 0x45, 0x6D, 0xD0, 0x30, 0x1D, 0x73,
+    0x5E, 0x24, 0x29, 0x1E, 0xFE, 0x1F, 0x12, 0x53, 0x8E, 0xD8, 0xF3, 0x81,
+    0x9C, 0x74, 0xAB, 0x91, 0xDB, 0x29, 0xE4, 0x00, 0x30, 0x7B, 0xD5, 0xC8,
+    0xED, 0x88, 0x1D, 0x3E, 0x95, 0x6E, 0x1B, 0x72, 0x48, 0x00, 0x57, 0x64,
+    0x29, 0x1E, 0xCE, 0x1F, 0x10, 0x70, 0xEF, 0xE6, 0x4F, 0x90, 0x78, 0x43,
+    0xD1, 0x07, 0xF9, 0xE6, 0xA7, 0x8A, 0xD7, 0xA0, 0xC5, 0x5A, 0x8E, 0xDF,
+    0xD4, 0x73, 0xEA, 0x6A, 0xF4, 0x76, 0xBF, 0x28, 0x6F, 0xCE, 0xB8, 0xAA,
+    0x4E, 0xAD, 0x7A, 0x8E, 0xA5, 0x59, 0x39, 0x37, 0xD5, 0x9F, 0x8B, 0x61,
+    0xEB, 0xA5, 0xA2, 0x29, 0xC5, 0x6B, 0x93, 0xD2, 0xAE, 0x47, 0x6F, 0x9E,
+    0xBF, 0x85, 0x5B, 0x8A, 0xDF, 0x27, 0x24, 0x70, 0x78, 0xAB, 0x91, 0xDB,
+    0x00, 0x79, 0x03, 0xF1, 0xED, 0x5B, 0x53, 0xA4, 0x7B, 0x34, 0x31, 0x05,
+    0x48, 0xED, 0x41, 0xE0, 0x8C, 0xE3, 0xDA, 0xAE, 0xC5, 0x6A, 0x7A, 0x9F,
+    0xAE, 0x6A, 0xDC, 0x56, 0xD9, 0x1D, 0x8F, 0xA6, 0x2A, 0xE4, 0x56, 0xC3,
+    0x8F, 0x97, 0x1D, 0xAB, 0xB2, 0x9D, 0x23, 0xD9, 0xA1, 0x88, 0x2A, 0x45,
+    0x6C, 0x41, 0xC6, 0x39, 0x3D, 0x3D, 0x6A, 0xE4, 0x76, 0xD9, 0xC7, 0x15,
+    0x72, 0x3B, 0x6E, 0x87, 0x1F, 0xFD, 0x6A, 0xB6, 0x96, 0xA0, 0xE0, 0x11,
+    0xCF, 0xB9, 0xAE, 0xB8, 0x52, 0x3D, 0x9A, 0x18, 0x93, 0xFF, 0xD9,
+};
+
+// 4:2:0, 16x16, quality 50
+static const uint8_t jpeg_q50[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x10, 0x0B, 0x0C, 0x0E, 0x0C, 0x0A, 0x10, 0x0E, 0x0D, 0x0E, 0x12,
+    0x11, 0x10, 0x13, 0x18, 0x28, 0x1A, 0x18, 0x16, 0x16, 0x18, 0x31, 0x23,
+    0x25, 0x1D, 0x28, 0x3A, 0x33, 0x3D, 0x3C, 0x39, 0x33, 0x38, 0x37, 0x40,
+    0x48, 0x5C, 0x4E, 0x40, 0x44, 0x57, 0x45, 0x37, 0x38, 0x50, 0x6D, 0x51,
+    0x57, 0x5F, 0x62, 0x67, 0x68, 0x67, 0x3E, 0x4D, 0x71, 0x79, 0x70, 0x64,
+    0x78, 0x5C, 0x65, 0x67, 0x63, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x11, 0x12,
+    0x12, 0x18, 0x15, 0x18, 0x2F, 0x1A, 0x1A, 0x2F, 0x63, 0x42, 0x38, 0x42,
+    0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+    0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+    0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+    0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+    0x63, 0x63, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xE6,
+    0x6D, 0xAC, 0x3D, 0xAB, 0x56, 0xDE, 0xC0, 0xF1, 0xC5, 0x69, 0xDB, 0xD8,
+    0x74, 0xF9, 0x6B, 0x52, 0xDB, 0x4F, 0xE9, 0xC5, 0x70, 0xCA, 0xB1, 0x59,
+    0x7E, 0x3B, 0x6D, 0x4F, 0xFF, 0xD9,
+};
+
+// 4:2:0, 16x16, quality 60
+static const uint8_t jpeg_q60[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x0D, 0x09, 0x0A, 0x0B, 0x0A, 0x08, 0x0D, 0x0B, 0x0A, 0x0B, 0x0E,
+    0x0E, 0x0D, 0x0F, 0x13, 0x20, 0x15, 0x13, 0x12, 0x12, 0x13, 0x27, 0x1C,
+    0x1E, 0x17, 0x20, 0x2E, 0x29, 0x31, 0x30, 0x2E, 0x29, 0x2D, 0x2C, 0x33,
+    0x3A, 0x4A, 0x3E, 0x33, 0x36, 0x46, 0x37, 0x2C, 0x2D, 0x40, 0x57, 0x41,
+    0x46, 0x4C, 0x4E, 0x52, 0x53, 0x52, 0x32, 0x3E, 0x5A, 0x61, 0x5A, 0x50,
+    0x60, 0x4A, 0x51, 0x52, 0x4F, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x0E, 0x0E,
+    0x0E, 0x13, 0x11, 0x13, 0x26, 0x15, 0x15, 0x26, 0x4F, 0x35, 0x2D, 0x35,
+    0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F,
+    0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F,
+    0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F,
+    0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F, 0x4F,
+    0x4F, 0x4F, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xE4,
+    0x2D, 0x34, 0xDE, 0x9F, 0x2F, 0xE7, 0x5B, 0x56, 0xBA, 0x69, 0xE3, 0x83,
+    0xD6, 0xB5, 0xED, 0x74, 0xDE, 0x9F, 0x2F, 0xE9, 0x5B, 0x36, 0x9A, 0x67,
+    0x0B, 0xC7, 0xE1, 0x5E, 0x74, 0xEB, 0x97, 0x95, 0xE6, 0x5B, 0x6A, 0x7F,
+    0xFF, 0xD9,
+};
+
+// 4:2:0, 16x16, quality 70
+static const uint8_t jpeg_q70[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x0A, 0x07, 0x07, 0x08, 0x07, 0x06, 0x0A, 0x08, 0x08, 0x08, 0x0B,
+    0x0A, 0x0A, 0x0B, 0x0E, 0x18, 0x10, 0x0E, 0x0D, 0x0D, 0x0E, 0x1D, 0x15,
+    0x16, 0x11, 0x18, 0x23, 0x1F, 0x25, 0x24, 0x22, 0x1F, 0x22, 0x21, 0x26,
+    0x2B, 0x37, 0x2F, 0x26, 0x29, 0x34, 0x29, 0x21, 0x22, 0x30, 0x41, 0x31,
+    0x34, 0x39, 0x3B, 0x3E, 0x3E, 0x3E, 0x25, 0x2E, 0x44, 0x49, 0x43, 0x3C,
+    0x48, 0x37, 0x3D, 0x3E, 0x3B, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x0A, 0x0B,
+    0x0B, 0x0E, 0x0D, 0x0E, 0x1C, 0x10, 0x10, 0x1C, 0x3B, 0x28, 0x22, 0x28,
+    0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B,
+    0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B,
+    0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B,
+    0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B,
+    0x3B, 0x3B, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xE0,
+    0xAC, 0x74, 0x6C, 0xE3, 0xE5, 0xFC, 0xC5, 0x74, 0x36, 0x5A, 0x29, 0xF9,
+    0x7E, 0x52, 0x79, 0xAD, 0xFB, 0x2D, 0x14, 0xF1, 0xF2, 0x0E, 0x7D, 0xAB,
+    0xA0, 0xB1, 0xD1, 0x38, 0x53, 0x8F, 0xC3, 0xB5, 0x78, 0xF5, 0x31, 0x26,
+    0x99, 0x36, 0x71, 0xB6, 0xA7, 0xFF, 0xD9,
+};
+
+// 4:2:0, 16x16, quality 80
+static const uint8_t jpeg_q80[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x06, 0x04, 0x05, 0x06, 0x05, 0x04, 0x06, 0x06, 0x05, 0x06, 0x07,
+    0x07, 0x06, 0x08, 0x0A, 0x10, 0x0A, 0x0A, 0x09, 0x09, 0x0A, 0x14, 0x0E,
+    0x0F, 0x0C, 0x10, 0x17, 0x14, 0x18, 0x18, 0x17, 0x14, 0x16, 0x16, 0x1A,
+    0x1D, 0x25, 0x1F, 0x1A, 0x1B, 0x23, 0x1C, 0x16, 0x16, 0x20, 0x2C, 0x20,
+    0x23, 0x26, 0x27, 0x29, 0x2A, 0x29, 0x19, 0x1F, 0x2D, 0x30, 0x2D, 0x28,
+    0x30, 0x25, 0x28, 0x29, 0x28, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x07, 0x07,
+    0x07, 0x0A, 0x08, 0x0A, 0x13, 0x0A, 0x0A, 0x13, 0x28, 0x1A, 0x16, 0x1A,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF1,
+    0xAD, 0x1F, 0xC3, 0x79, 0x03, 0xE4, 0x3D, 0x71, 0xC8, 0xAE, 0xDF, 0x48,
+    0xF0, 0xD1, 0x25, 0x3E, 0x52, 0x4E, 0x47, 0x41, 0x5D, 0x9E, 0x93, 0xE1,
+    0xA2, 0x31, 0xFB, 0xB0, 0x73, 0xD4, 0x63, 0xA7, 0xF8, 0x57, 0x6B, 0xA3,
+    0xF8, 0x67, 0x22, 0x33, 0xB7, 0xF0, 0xED, 0x5F, 0x3B, 0x5B, 0x1F, 0xE6,
+    0x6B, 0xC2, 0xFC, 0x4B, 0xB6, 0xA7, 0xFF, 0xD9,
+};
+
+// 4:2:0, 16x16, quality 90
+static const uint8_t jpeg_q90[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0A, 0x07,
+    0x07, 0x06, 0x08, 0x0C, 0x0A, 0x0C, 0x0C, 0x0B, 0x0A, 0x0B, 0x0B, 0x0D,
+    0x0E, 0x12, 0x10, 0x0D, 0x0E, 0x11, 0x0E, 0x0B, 0x0B, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0C, 0x0F, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0D, 0x0B, 0x0D,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF8,
+    0xD3, 0xC1, 0xFF, 0x00, 0x09, 0xB7, 0x05, 0xFD, 0xC9, 0x1C, 0xE3, 0x0E,
+    0xBC, 0xE7, 0xFC, 0x78, 0x35, 0xED, 0xDE, 0x11, 0xF8, 0x46, 0xEC, 0x62,
+    0xCC, 0x6C, 0xC4, 0x30, 0x1C, 0x0F, 0x6E, 0x4F, 0xB7, 0x1D, 0x2B, 0xD9,
+    0xBC, 0x27, 0xF0, 0x91, 0x94, 0xA1, 0xF2, 0x14, 0xE4, 0x82, 0x46, 0xD2,
+    0x48, 0xE7, 0xB7, 0x1C, 0x7D, 0x2B, 0xDB, 0x3C, 0x1D, 0xF0, 0x7C, 0xB2,
+    0xDB, 0xB7, 0x96, 0x70, 0x71, 0xF2, 0x9F, 0xBA, 0x3D, 0x7A, 0xE7, 0xD4,
+    0x8A, 0xFC, 0xC3, 0x17, 0x9C, 0xF5, 0xB9, 0xDB, 0xE1, 0xCF, 0x88, 0x3F,
+    0x05, 0xE6, 0x7F, 0xFF, 0xD9,
+};
+
+#endif  // __JPEG_FIXTURES_H
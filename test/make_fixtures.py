@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Writes the JPEG frames used by the native tests to jpeg_fixtures.h.
+
+Small, but with the layouts the camera and the crop have to deal
+with: every chroma subsampling, grayscale, restart intervals, a
+frame size which is not a whole number of MCUs, a frame the static
+scene check can compare, and frames of the same scene at several
+qualities, each with its own tables.
+
+    python3 test/make_fixtures.py
+"""
+
+import io
+import os
+
+import numpy as np
+from PIL import Image
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def scene(width, height, seed=1):
+    rng = np.random.default_rng(seed)
+    y, x = np.mgrid[0:height, 0:width]
+    rgb = np.stack([x * 255 // width, y * 255 // height,
+                    (x * 3 + y * 5) % 256], -1).astype(np.int16)
+    rgb += rng.integers(-12, 12, (height, width, 3))
+    return Image.fromarray(np.clip(rgb, 0, 255).astype(np.uint8))
+
+
+def encode(image, mode="RGB", quality=75, **options):
+    buf = io.BytesIO()
+    image.convert(mode).save(buf, "JPEG", quality=quality, **options)
+    return buf.getvalue()
+
+
+def main():
+    frame = scene(64, 48)
+    fixtures = [
+        ("jpeg_420", "4:2:0, 64x48", encode(frame, subsampling=2)),
+        ("jpeg_422", "4:2:2, 64x48", encode(frame, subsampling=1)),
+        ("jpeg_444", "4:4:4, 64x48", encode(frame, subsampling=0)),
+        ("jpeg_gray", "Grayscale, 64x48", encode(frame, "L")),
+        ("jpeg_420_rst", "4:2:0, 64x48, restart every 3 MCUs",
+         encode(frame, subsampling=2, restart_marker_blocks=3)),
+        ("jpeg_444_rst", "4:4:4, 64x48, restart every MCU row",
+         encode(frame, subsampling=0, restart_marker_rows=1)),
+        ("jpeg_420_odd", "4:2:0, 61x45, partial MCUs on the edges",
+         encode(scene(61, 45), subsampling=2)),
+        ("jpeg_420_sq", "4:2:0, 64x64, big enough for a static scene signature",
+         encode(scene(64, 64), subsampling=2)),
+    ]
+    small = scene(16, 16, seed=2)
+    for quality in (50, 60, 70, 80, 90):
+        fixtures.append((f"jpeg_q{quality}", f"4:2:0, 16x16, quality {quality}",
+                         encode(small, subsampling=2, quality=quality)))
+
+    lines = [
+        "// Generated by make_fixtures.py, do not edit",
+        "#ifndef __JPEG_FIXTURES_H",
+        "#define __JPEG_FIXTURES_H",
+        "",
+        "#include <stdint.h>",
+        "",
+    ]
+    for name, what, data in fixtures:
+        lines.append(f"// {what}")
+        lines.append(f"static const uint8_t {name}[] = {{")
+        for i in range(0, len(data), 12):
+            row = ", ".join(f"0x{b:02X}" for b in data[i:i + 12])
+            lines.append(f"    {row},")
+        lines.append("};")
+        lines.append("")
+    lines.append("#endif  // __JPEG_FIXTURES_H")
+
+    with open(os.path.join(HERE, "jpeg_fixtures.h"), "w") as out:
+        out.write("\n".join(lines) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+#ifndef __SHIM_ARDUINO_H
+#define __SHIM_ARDUINO_H
+
+/**
+ * Host stand-in for the parts of the Arduino core used by the modules
+ * built for the native tests. Time is the host clock, PSRAM is the
+ * heap and the serial port is stdout
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "freertos/FreeRTOS.h"
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+inline void *ps_malloc(size_t size) { return malloc(size); }
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len) {
+    size_t n = 0;
+    while (n < len && write(buf[n])) n++;
+    return n;
+  }
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t println(const char *s = "") { return print(s) + print('\n'); }
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual size_t readBytes(char *buf, size_t len) {
+    size_t n = 0;
+    int c;
+    while (n < len && (c = read()) >= 0) buf[n++] = (char)c;
+    return n;
+  }
+  virtual size_t readBytes(uint8_t *buf, size_t len) {
+    return readBytes((char *)buf, len);
+  }
+};
+
+class HostSerial : public Stream {
+ public:
+  void begin(unsigned long baud) {}
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  using Print::write;
+};
+
+extern HostSerial Serial;
+
+#endif  // __SHIM_ARDUINO_H
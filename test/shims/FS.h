@@ -0,0 +1,86 @@
+#ifndef __SHIM_FS_H
+#define __SHIM_FS_H
+
+#include <Arduino.h>
+
+#include <memory>
+#include <vector>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+typedef std::vector<uint8_t> FileData;
+
+/**
+ * @brief An open file of a `FS`, kept in memory
+ * @note Writes go to the same data as other handles of the file
+ */
+class File : public Stream {
+ public:
+  File() {}
+  File(std::shared_ptr<FileData> data, bool writable)
+      : data_(data), writable_(writable) {}
+
+  explicit operator bool() const { return data_ != nullptr; }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t len) override {
+    if (!data_ || !writable_) return 0;
+    data_->insert(data_->end(), buf, buf + len);
+    return len;
+  }
+
+  int available() override {
+    return data_ ? (int)(data_->size() - pos_) : 0;
+  }
+  int read() override { return available() > 0 ? (*data_)[pos_++] : -1; }
+  int peek() override { return available() > 0 ? (*data_)[pos_] : -1; }
+  size_t read(uint8_t *buf, size_t len) {
+    len = min<size_t>(len, available());
+    if (len) memcpy(buf, data_->data() + pos_, len);
+    pos_ += len;
+    return len;
+  }
+  size_t readBytes(char *buf, size_t len) override {
+    return read((uint8_t *)buf, len);
+  }
+  using Stream::readBytes;
+
+  bool seek(uint32_t pos) {
+    if (!data_ || pos > data_->size()) return false;
+    pos_ = pos;
+    return true;
+  }
+  size_t position() const { return pos_; }
+  size_t size() const { return data_ ? data_->size() : 0; }
+  void flush() {}
+  void close() { data_.reset(); }
+
+ private:
+  std::shared_ptr<FileData> data_;
+  bool writable_ = false;
+  size_t pos_ = 0;
+};
+
+/**
+ * @brief A file system held in memory, flat apart from the directory
+ * names it was told about
+ */
+class FS {
+ public:
+  File open(const char *path, const char *mode = FILE_READ);
+  bool exists(const char *path);
+  bool mkdir(const char *path);
+  bool rmdir(const char *path);
+  bool remove(const char *path);
+  bool rename(const char *from, const char *to);
+};
+
+}  // namespace fs
+
+using fs::File;
+
+#endif  // __SHIM_FS_H
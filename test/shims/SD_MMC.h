@@ -0,0 +1,10 @@
+#ifndef __SHIM_SD_MMC_H
+#define __SHIM_SD_MMC_H
+
+#include <FS.h>
+
+class SDMMCFS : public fs::FS {};
+
+extern SDMMCFS SD_MMC;
+
+#endif  // __SHIM_SD_MMC_H
@@ -0,0 +1,8 @@
+#ifndef __SHIM_ESP_TIMER_H
+#define __SHIM_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time();
+
+#endif  // __SHIM_ESP_TIMER_H
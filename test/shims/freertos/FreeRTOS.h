@@ -0,0 +1,36 @@
+#ifndef __SHIM_FREERTOS_H
+#define __SHIM_FREERTOS_H
+
+/**
+ * Tests run on a single thread, critical sections do nothing and
+ * tasks are never started
+ */
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void *TaskHandle_t;
+
+typedef struct {
+  int unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+#define pdPASS (1)
+#define pdFAIL (0)
+#define pdTRUE (1)
+#define pdFALSE (0)
+#define portMAX_DELAY (0xFFFFFFFFu)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+BaseType_t xTaskCreate(void (*task)(void *), const char *name,
+                       uint32_t stack, void *param, UBaseType_t priority,
+                       TaskHandle_t *handle);
+void vTaskDelay(TickType_t ticks);
+
+#endif  // __SHIM_FREERTOS_H
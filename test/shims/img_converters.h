@@ -0,0 +1,21 @@
+#ifndef __SHIM_IMG_CONVERTERS_H
+#define __SHIM_IMG_CONVERTERS_H
+
+#include "esp_camera.h"
+
+typedef enum {
+  JPG_SCALE_NONE,
+  JPG_SCALE_2X,
+  JPG_SCALE_4X,
+  JPG_SCALE_8X,
+} jpg_scale_t;
+
+/**
+ * @note There is no decoder on the host. Every frame decodes to the
+ * same flat gray at the size given by its SOF, so frames big enough
+ * for a static scene signature are all repeats of each other
+ */
+bool jpg2rgb565(const uint8_t *src, size_t src_len, uint8_t *out,
+                jpg_scale_t scale);
+
+#endif  // __SHIM_IMG_CONVERTERS_H
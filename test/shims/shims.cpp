@@ -0,0 +1,109 @@
+#include <Arduino.h>
+#include <FS.h>
+#include <SD_MMC.h>
+#include <esp_timer.h>
+#include <img_converters.h>
+#include <stdarg.h>
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+
+// === Arduino ===
+
+HostSerial Serial;
+
+static const auto start = std::chrono::steady_clock::now();
+
+static uint64_t elapsed_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+uint32_t millis() { return elapsed_us() / 1000; }
+uint32_t micros() { return elapsed_us(); }
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+size_t Print::printf(const char *fmt, ...) {
+  char buf[256];
+  va_list args;
+
+  va_start(args, fmt);
+  int len = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t *)buf, min<size_t>(len, sizeof(buf) - 1));
+}
+
+// === FreeRTOS ===
+
+BaseType_t xTaskCreate(void (*task)(void *), const char *name,
+                       uint32_t stack, void *param, UBaseType_t priority,
+                       TaskHandle_t *handle) {
+  if (handle) *handle = NULL;
+  return pdFAIL;
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks); }
+
+// === ESP-IDF ===
+
+int64_t esp_timer_get_time() { return elapsed_us(); }
+
+bool jpg2rgb565(const uint8_t *src, size_t src_len, uint8_t *out,
+                jpg_scale_t scale) {
+  for (size_t i = 2; i + 9 < src_len; i++) {
+    if (src[i] != 0xFF || src[i + 1] != 0xC0) continue;
+    size_t height = ((src[i + 5] << 8) | src[i + 6]) >> scale;
+    size_t width = ((src[i + 7] << 8) | src[i + 8]) >> scale;
+    // Big endian RGB565
+    for (size_t p = 0; p < width * height; p++) {
+      out[p * 2] = 0x84;
+      out[p * 2 + 1] = 0x10;
+    }
+    return true;
+  }
+  return false;
+}
+
+// === File systems ===
+
+SDMMCFS SD_MMC;
+
+// Shared by every `FS`, tests only use one
+static std::map<std::string, std::shared_ptr<fs::FileData>> files;
+static std::set<std::string> dirs;
+
+fs::File fs::FS::open(const char *path, const char *mode) {
+  auto it = files.find(path);
+  if (mode[0] == 'r') {
+    return it == files.end() ? File() : File(it->second, false);
+  }
+  if (it == files.end() || mode[0] == 'w') {
+    files[path] = std::make_shared<FileData>();
+  }
+  return File(files[path], true);
+}
+
+bool fs::FS::exists(const char *path) {
+  return files.count(path) || dirs.count(path);
+}
+
+bool fs::FS::mkdir(const char *path) { return dirs.insert(path).second; }
+
+bool fs::FS::rmdir(const char *path) { return dirs.erase(path) > 0; }
+
+bool fs::FS::remove(const char *path) { return files.erase(path) > 0; }
+
+bool fs::FS::rename(const char *from, const char *to) {
+  auto it = files.find(from);
+  if (it == files.end()) return false;
+  files[to] = it->second;
+  files.erase(it);
+  return true;
+}
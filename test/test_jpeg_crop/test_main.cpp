@@ -0,0 +1,449 @@
+#include <Arduino.h>
+#include <unity.h>
+
+#include <array>
+#include <vector>
+
+#include "../host_config.h"
+#include "../jpeg_fixtures.h"
+#include "jpeg_crop.h"
+
+// === Decoder ===
+
+// Just enough of a baseline decoder to get the quantized coefficients
+// of every block back, written apart from jpeg_crop.cpp so a crop can
+// be checked block by block against the frame it came from
+
+typedef std::array<int16_t, 64> block_t;
+
+typedef struct {
+  bool defined;
+  int mincode[17];
+  int maxcode[17];
+  int valptr[17];
+  uint8_t vals[256];
+} huff_t;
+
+typedef struct {
+  int id, h, v, dc, ac;
+  int pred;
+  int blocks_w, blocks_h;
+  std::vector<block_t> blocks;
+} comp_t;
+
+typedef struct {
+  int width, height;
+  int restart;    // From DRI, in MCUs
+  int intervals;  // Separated by RST markers
+  std::vector<comp_t> comps;
+} decoded_t;
+
+typedef struct {
+  const std::vector<uint8_t> *data;
+  size_t pos;
+  int bit;
+  bool overrun;
+} bits_t;
+
+static int get_bit(bits_t *b) {
+  if (b->pos >= b->data->size()) {
+    b->overrun = true;
+    return 1;
+  }
+  int v = ((*b->data)[b->pos] >> (7 - b->bit)) & 1;
+  if (++b->bit == 8) {
+    b->bit = 0;
+    b->pos++;
+  }
+  return v;
+}
+
+static int get_bits(bits_t *b, int n) {
+  int v = 0;
+  while (n--) v = (v << 1) | get_bit(b);
+  return v;
+}
+
+// Only padding (ones) may be left once an interval is decoded
+static bool used_up(bits_t *b) {
+  if (b->bit == 0) return b->pos == b->data->size();
+  if (b->pos + 1 != b->data->size()) return false;
+  const int n = 8 - b->bit;
+  return get_bits(b, n) == (1 << n) - 1;
+}
+
+static int huff_decode(bits_t *b, const huff_t &h) {
+  int code = 0;
+  for (int l = 1; l <= 16; l++) {
+    code = (code << 1) | get_bit(b);
+    if (h.maxcode[l] >= 0 && code <= h.maxcode[l]) {
+      return h.vals[h.valptr[l] + code - h.mincode[l]];
+    }
+  }
+  return -1;
+}
+
+static int extend(int v, int s) {
+  return v < (1 << (s - 1)) ? v - (1 << s) + 1 : v;
+}
+
+static bool decode_block(bits_t *b, const huff_t &dc, const huff_t &ac,
+                         int *pred, block_t *out) {
+  out->fill(0);
+  int s = huff_decode(b, dc);
+  if (s < 0 || s > 11) return false;
+  *pred += s ? extend(get_bits(b, s), s) : 0;
+  (*out)[0] = *pred;
+  for (int k = 1; k < 64;) {
+    int rs = huff_decode(b, ac);
+    if (rs < 0) return false;
+    int r = rs >> 4;
+    s = rs & 0x0F;
+    if (s == 0) {
+      if (r != 15) break;
+      k += 16;
+      continue;
+    }
+    k += r;
+    if (k > 63) return false;
+    (*out)[k++] = extend(get_bits(b, s), s);
+  }
+  return !b->overrun;
+}
+
+static bool decode(const uint8_t *buf, size_t len, decoded_t *out) {
+  huff_t huff[2][4] = {};
+  std::vector<std::vector<uint8_t>> intervals;
+  size_t pos = 2;
+
+  *out = {};
+  if (len < 4 || buf[0] != 0xFF || buf[1] != 0xD8) return false;
+  for (;;) {
+    if (pos + 4 > len || buf[pos] != 0xFF) return false;
+    const uint8_t marker = buf[pos + 1];
+    const size_t seg = 2 + ((buf[pos + 2] << 8) | buf[pos + 3]);
+    const uint8_t *d = buf + pos + 4;
+    if (pos + seg > len) return false;
+
+    if (marker == 0xC0) {
+      out->height = (d[1] << 8) | d[2];
+      out->width = (d[3] << 8) | d[4];
+      for (int i = 0; i < d[5]; i++) {
+        comp_t c = {};
+        c.id = d[6 + 3 * i];
+        c.h = d[7 + 3 * i] >> 4;
+        c.v = d[7 + 3 * i] & 0x0F;
+        out->comps.push_back(c);
+      }
+    } else if ((marker & 0xF0) == 0xC0 && marker != 0xC4 && marker != 0xC8 &&
+               marker != 0xCC) {
+      return false;
+    } else if (marker == 0xC4) {
+      for (size_t i = 4; i < seg;) {
+        huff_t &h = huff[buf[pos + i] >> 4][buf[pos + i] & 0x0F];
+        const uint8_t *counts = buf + pos + i;
+        int code = 0, k = 0;
+        for (int l = 1; l <= 16; l++) {
+          h.valptr[l] = k;
+          h.mincode[l] = code;
+          code += counts[l];
+          k += counts[l];
+          h.maxcode[l] = counts[l] ? code - 1 : -1;
+          code <<= 1;
+        }
+        memcpy(h.vals, counts + 17, k);
+        h.defined = true;
+        i += 17 + k;
+      }
+    } else if (marker == 0xDD) {
+      out->restart = (d[0] << 8) | d[1];
+    } else if (marker == 0xDA) {
+      for (int i = 0; i < d[0]; i++) {
+        for (comp_t &c : out->comps) {
+          if (c.id != d[1 + 2 * i]) continue;
+          c.dc = d[2 + 2 * i] >> 4;
+          c.ac = d[2 + 2 * i] & 0x0F;
+        }
+      }
+      pos += seg;
+      break;
+    }
+    pos += seg;
+  }
+
+  // Unstuff the scan, one interval between each restart marker
+  intervals.emplace_back();
+  for (;;) {
+    if (pos + 1 >= len) return false;
+    if (buf[pos] != 0xFF) {
+      intervals.back().push_back(buf[pos++]);
+    } else if (buf[pos + 1] == 0x00) {
+      intervals.back().push_back(0xFF);
+      pos += 2;
+    } else if (buf[pos + 1] >= 0xD0 && buf[pos + 1] <= 0xD7) {
+      intervals.emplace_back();
+      pos += 2;
+    } else if (buf[pos + 1] == 0xD9 && pos + 2 == len) {
+      break;
+    } else {
+      return false;
+    }
+  }
+  out->intervals = intervals.size();
+
+  int hmax = 1, vmax = 1;
+  if (out->comps.size() == 1) out->comps[0].h = out->comps[0].v = 1;
+  for (comp_t &c : out->comps) {
+    if (!huff[0][c.dc].defined || !huff[1][c.ac].defined) return false;
+    hmax = max(hmax, c.h);
+    vmax = max(vmax, c.v);
+  }
+  const int cols = (out->width + 8 * hmax - 1) / (8 * hmax);
+  const int rows = (out->height + 8 * vmax - 1) / (8 * vmax);
+  for (comp_t &c : out->comps) {
+    c.blocks_w = cols * c.h;
+    c.blocks_h = rows * c.v;
+    c.blocks.resize(c.blocks_w * c.blocks_h);
+  }
+
+  bits_t b = {&intervals[0], 0, 0, false};
+  size_t interval = 0;
+  for (int m = 0; m < cols * rows; m++) {
+    if (out->restart && m && m % out->restart == 0) {
+      if (!used_up(&b) || ++interval == intervals.size()) return false;
+      b = {&intervals[interval], 0, 0, false};
+      for (comp_t &c : out->comps) c.pred = 0;
+    }
+    const int mx = m % cols;
+    const int my = m / cols;
+    for (comp_t &c : out->comps) {
+      for (int by = 0; by < c.v; by++) {
+        for (int bx = 0; bx < c.h; bx++) {
+          block_t *block =
+              &c.blocks[(my * c.v + by) * c.blocks_w + mx * c.h + bx];
+          if (!decode_block(&b, huff[0][c.dc], huff[1][c.ac], &c.pred,
+                            block)) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return used_up(&b) && interval + 1 == intervals.size();
+}
+
+// === Helpers ===
+
+typedef struct {
+  jpeg_roi_t roi;
+  uint16_t x, y, width, height;  // Expected region, in pixels
+} crop_case_t;
+
+#define CASE_ORIGIN (0)
+#define CASE_EDGE (1)
+#define CASE_PAST_EDGE (2)
+#define CASE_OFF_FRAME (3)
+#define CASE_UNALIGNED (4)
+#define CASE_COUNT (5)
+
+// 64x48 frames, in MCUs of 16x16 (4:2:0)
+static const crop_case_t mcu_16x16[CASE_COUNT] = {
+    {{0, 0, 30, 30}, 0, 0, 32, 16},
+    {{80, 80, 20, 20}, 48, 32, 16, 16},
+    {{90, 90, 50, 50}, 48, 32, 16, 16},
+    {{100, 100, 10, 10}, 48, 32, 16, 16},
+    {{30, 40, 25, 20}, 16, 16, 32, 16},
+};
+
+// 64x48 frames, in MCUs of 16x8 (4:2:2)
+static const crop_case_t mcu_16x8[CASE_COUNT] = {
+    {{0, 0, 30, 30}, 0, 0, 32, 16},
+    {{80, 80, 20, 20}, 48, 32, 16, 16},
+    {{90, 90, 50, 50}, 48, 40, 16, 8},
+    {{100, 100, 10, 10}, 48, 40, 16, 8},
+    {{30, 40, 25, 20}, 16, 16, 32, 16},
+};
+
+// 64x48 frames, in MCUs of 8x8 (4:4:4 and grayscale)
+static const crop_case_t mcu_8x8[CASE_COUNT] = {
+    {{0, 0, 30, 30}, 0, 0, 24, 16},
+    {{80, 80, 20, 20}, 48, 32, 16, 16},
+    {{90, 90, 50, 50}, 56, 40, 8, 8},
+    {{100, 100, 10, 10}, 56, 40, 8, 8},
+    {{30, 40, 25, 20}, 16, 16, 24, 16},
+};
+
+// 61x45 frames, in MCUs of 16x16 which the right and bottom edges
+// end partway through
+static const crop_case_t odd_16x16[CASE_COUNT] = {
+    {{0, 0, 30, 30}, 0, 0, 32, 16},
+    {{80, 80, 20, 20}, 48, 32, 13, 13},
+    {{90, 90, 50, 50}, 48, 32, 13, 13},
+    {{100, 100, 10, 10}, 48, 32, 13, 13},
+    {{30, 40, 25, 20}, 16, 16, 32, 16},
+};
+
+typedef struct {
+  const char *name;
+  const uint8_t *jpeg;
+  size_t len;
+  const crop_case_t *cases;
+  bool restart;
+} fixture_t;
+
+#define FIXTURE(name, jpeg, cases, restart) \
+  {name, jpeg, sizeof(jpeg), cases, restart}
+
+static const fixture_t fixtures[] = {
+    FIXTURE("4:2:0", jpeg_420, mcu_16x16, false),
+    FIXTURE("4:2:2", jpeg_422, mcu_16x8, false),
+    FIXTURE("4:4:4", jpeg_444, mcu_8x8, false),
+    FIXTURE("gray", jpeg_gray, mcu_8x8, false),
+    FIXTURE("4:2:0 restart", jpeg_420_rst, mcu_16x16, true),
+    FIXTURE("4:4:4 restart", jpeg_444_rst, mcu_8x8, true),
+    FIXTURE("4:2:0 61x45", jpeg_420_odd, odd_16x16, false),
+};
+
+static jpeg_crop_t *crop = NULL;
+
+void setUp() {
+  if (!crop) crop = jpeg_crop_new();
+}
+
+void tearDown() {}
+
+// Crop `f` and check the result decodes to the very blocks of the
+// expected region of the original
+static void assert_crop(const fixture_t &f, const crop_case_t &t) {
+  char name[64];
+  decoded_t orig, cut;
+  jpeg_crop_out_t out;
+
+  snprintf(name, sizeof(name), "%s at %u,%u %ux%u%%", f.name, t.roi.left,
+           t.roi.top, t.roi.width, t.roi.height);
+  TEST_ASSERT_TRUE_MESSAGE(decode(f.jpeg, f.len, &orig), name);
+  TEST_ASSERT_TRUE_MESSAGE(jpeg_crop(crop, f.jpeg, f.len, t.roi, &out), name);
+  TEST_ASSERT_EQUAL_MESSAGE(t.width, out.width, name);
+  TEST_ASSERT_EQUAL_MESSAGE(t.height, out.height, name);
+  TEST_ASSERT_LESS_THAN(f.len, out.len);
+
+  // Decodable, with the size it claims and a single interval
+  TEST_ASSERT_TRUE_MESSAGE(decode(out.buf, out.len, &cut), name);
+  TEST_ASSERT_EQUAL_MESSAGE(out.width, cut.width, name);
+  TEST_ASSERT_EQUAL_MESSAGE(out.height, cut.height, name);
+  TEST_ASSERT_EQUAL_MESSAGE(orig.comps.size(), cut.comps.size(), name);
+  TEST_ASSERT_EQUAL_MESSAGE(0, cut.restart, name);
+  TEST_ASSERT_EQUAL_MESSAGE(1, cut.intervals, name);
+
+  int hmax = 1, vmax = 1;
+  for (const comp_t &c : orig.comps) {
+    hmax = max(hmax, c.h);
+    vmax = max(vmax, c.v);
+  }
+  for (size_t i = 0; i < orig.comps.size(); i++) {
+    const comp_t &a = orig.comps[i];
+    const comp_t &b = cut.comps[i];
+    const int x0 = t.x / (8 * hmax) * a.h;
+    const int y0 = t.y / (8 * vmax) * a.v;
+    TEST_ASSERT_LESS_OR_EQUAL(a.blocks_w, x0 + b.blocks_w);
+    TEST_ASSERT_LESS_OR_EQUAL(a.blocks_h, y0 + b.blocks_h);
+    for (int by = 0; by < b.blocks_h; by++) {
+      for (int bx = 0; bx < b.blocks_w; bx++) {
+        TEST_ASSERT_TRUE_MESSAGE(
+            b.blocks[by * b.blocks_w + bx] ==
+                a.blocks[(y0 + by) * a.blocks_w + x0 + bx],
+            name);
+      }
+    }
+  }
+}
+
+// === Tests ===
+
+static void test_fixtures_decode() {
+  decoded_t d;
+  for (const fixture_t &f : fixtures) {
+    TEST_ASSERT_TRUE_MESSAGE(decode(f.jpeg, f.len, &d), f.name);
+    TEST_ASSERT_EQUAL_MESSAGE(f.restart, d.intervals > 1, f.name);
+  }
+}
+
+static void test_roi_at_the_origin() {
+  for (const fixture_t &f : fixtures) assert_crop(f, f.cases[CASE_ORIGIN]);
+}
+
+static void test_roi_at_the_edges_is_clamped() {
+  for (const fixture_t &f : fixtures) {
+    assert_crop(f, f.cases[CASE_EDGE]);
+    assert_crop(f, f.cases[CASE_PAST_EDGE]);
+    assert_crop(f, f.cases[CASE_OFF_FRAME]);
+  }
+}
+
+static void test_roi_off_the_mcu_grid() {
+  for (const fixture_t &f : fixtures) {
+    assert_crop(f, f.cases[CASE_UNALIGNED]);
+  }
+}
+
+static void test_restart_markers_are_dropped() {
+  jpeg_crop_out_t out;
+
+  for (const fixture_t &f : fixtures) {
+    if (!f.restart) continue;
+    for (int i = 0; i < CASE_COUNT; i++) assert_crop(f, f.cases[i]);
+
+    TEST_ASSERT_TRUE(
+        jpeg_crop(crop, f.jpeg, f.len, f.cases[CASE_UNALIGNED].roi, &out));
+    for (size_t i = 0; i + 1 < out.len; i++) {
+      TEST_ASSERT_FALSE_MESSAGE(out.buf[i] == 0xFF && out.buf[i + 1] == 0xDD,
+                                f.name);
+      TEST_ASSERT_FALSE_MESSAGE(out.buf[i] == 0xFF &&
+                                    (out.buf[i + 1] & 0xF8) == 0xD0,
+                                f.name);
+    }
+  }
+}
+
+static void test_whole_frame_is_not_cropped() {
+  static const jpeg_roi_t whole = {0, 0, 100, 100};
+  static const jpeg_roi_t widened = {1, 1, 98, 98};
+  static const jpeg_roi_t empty = {10, 10, 0, 50};
+  jpeg_crop_out_t out;
+
+  TEST_ASSERT_FALSE(jpeg_roi_crops(whole));
+  TEST_ASSERT_FALSE(jpeg_roi_crops(empty));
+  TEST_ASSERT_TRUE(jpeg_roi_crops(widened));
+  for (const fixture_t &f : fixtures) {
+    TEST_ASSERT_FALSE_MESSAGE(jpeg_crop(crop, f.jpeg, f.len, whole, &out),
+                              f.name);
+    // Every MCU is kept once widened
+    TEST_ASSERT_FALSE_MESSAGE(jpeg_crop(crop, f.jpeg, f.len, widened, &out),
+                              f.name);
+    TEST_ASSERT_FALSE_MESSAGE(jpeg_crop(crop, f.jpeg, f.len, empty, &out),
+                              f.name);
+  }
+}
+
+static void test_broken_frames_are_refused() {
+  static const jpeg_roi_t roi = {25, 25, 50, 50};
+  jpeg_crop_out_t out;
+
+  TEST_ASSERT_FALSE(jpeg_crop(crop, jpeg_420 + 2, sizeof(jpeg_420) - 2, roi,
+                              &out));
+  // Cut off in the header, then in the scan
+  TEST_ASSERT_FALSE(jpeg_crop(crop, jpeg_420, 100, roi, &out));
+  TEST_ASSERT_FALSE(jpeg_crop(crop, jpeg_420, sizeof(jpeg_420) / 2, roi, &out));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fixtures_decode);
+  RUN_TEST(test_roi_at_the_origin);
+  RUN_TEST(test_roi_at_the_edges_is_clamped);
+  RUN_TEST(test_roi_off_the_mcu_grid);
+  RUN_TEST(test_restart_markers_are_dropped);
+  RUN_TEST(test_whole_frame_is_not_cropped);
+  RUN_TEST(test_broken_frames_are_refused);
+  return UNITY_END();
+}
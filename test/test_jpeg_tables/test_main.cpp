@@ -0,0 +1,274 @@
+#include <Arduino.h>
+#include <SD_MMC.h>
+#include <unity.h>
+
+#include <vector>
+
+#include "../host_config.h"
+#include "../jpeg_fixtures.h"
+#include "frame_index.h"
+#include "jpeg_tables.h"
+
+// === Helpers ===
+
+typedef std::vector<uint8_t> bytes_t;
+
+void setUp() {}
+void tearDown() {}
+
+// Abbreviate a frame to a file, like the save task does
+static bool abbreviate(const uint8_t *jpeg, size_t len, const char *path,
+                       jpeg_strip_t *strip) {
+  if (!jpeg_tables_strip(jpeg, len, strip)) return false;
+  File file = SD_MMC.open(path, FILE_WRITE);
+  size_t written = jpeg_tables_write(file, jpeg, strip);
+  file.close();
+  return written == strip->len;
+}
+
+// Read an abbreviated frame back, `chunk` bytes at a time
+static bytes_t expand(const char *path, const jpeg_tables_t &tables,
+                      size_t chunk) {
+  File file = SD_MMC.open(path, FILE_READ);
+  JpegExpandStream src(file, tables);
+  bytes_t out(JpegExpandStream::expanded_len(file.size(), tables));
+  size_t pos = 0;
+  size_t got;
+
+  TEST_ASSERT_EQUAL(out.size(), src.available());
+  while (pos < out.size() &&
+         (got = src.readBytes((char *)out.data() + pos,
+                              min(chunk, out.size() - pos))) > 0) {
+    pos += got;
+  }
+  out.resize(pos);
+  TEST_ASSERT_EQUAL(-1, src.read());
+  file.close();
+  return out;
+}
+
+static bool has_marker(const uint8_t *buf, size_t len, uint8_t marker) {
+  for (size_t i = 0; i + 1 < len; i++) {
+    if (buf[i] == 0xFF && buf[i + 1] == marker) return true;
+  }
+  return false;
+}
+
+static void assert_round_trip(const uint8_t *jpeg, size_t len,
+                              const char *name) {
+  static const size_t chunks[] = {1, 7, 64, 4096};
+  jpeg_strip_t strip;
+
+  TEST_ASSERT_TRUE_MESSAGE(abbreviate(jpeg, len, "/frame.jpg", &strip), name);
+  TEST_ASSERT_NOT_EQUAL(0, strip.tables);
+  const jpeg_tables_t *tables = jpeg_tables_get(strip.tables);
+  TEST_ASSERT_NOT_NULL(tables);
+  TEST_ASSERT_EQUAL_MESSAGE(len, strip.len + tables->len, name);
+
+  // No tables left before the scan
+  File file = SD_MMC.open("/frame.jpg", FILE_READ);
+  bytes_t abbreviated(file.size());
+  file.read(abbreviated.data(), abbreviated.size());
+  file.close();
+  TEST_ASSERT_FALSE(has_marker(abbreviated.data(), abbreviated.size(), 0xDB));
+  TEST_ASSERT_FALSE(has_marker(abbreviated.data(), abbreviated.size(), 0xC4));
+
+  for (size_t chunk : chunks) {
+    bytes_t out = expand("/frame.jpg", *tables, chunk);
+    TEST_ASSERT_EQUAL_MESSAGE(len, out.size(), name);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(jpeg, out.data(), len, name);
+  }
+}
+
+#define ASSERT_ROUND_TRIP(fixture) \
+  assert_round_trip(fixture, sizeof(fixture), #fixture)
+
+// Frame of the ring buffer using a table set
+static void add_frame(int slot, uint8_t tables) {
+  frame_index_begin_slot(slot, 1700000000 + slot);
+  frame_index_add(slot, 0, 1000, 0, true, false, tables);
+}
+
+// === Tests ===
+
+static void test_round_trip_is_byte_exact() {
+  ASSERT_ROUND_TRIP(jpeg_420);
+  ASSERT_ROUND_TRIP(jpeg_422);
+  ASSERT_ROUND_TRIP(jpeg_444);
+  ASSERT_ROUND_TRIP(jpeg_gray);
+  ASSERT_ROUND_TRIP(jpeg_420_rst);
+  ASSERT_ROUND_TRIP(jpeg_444_rst);
+  ASSERT_ROUND_TRIP(jpeg_420_odd);
+}
+
+static void test_same_tables_share_a_set() {
+  jpeg_strip_t a, b, gray;
+
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_420, sizeof(jpeg_420), &a));
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_444_rst, sizeof(jpeg_444_rst), &b));
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_gray, sizeof(jpeg_gray), &gray));
+  TEST_ASSERT_EQUAL(a.tables, b.tables);
+  TEST_ASSERT_NOT_EQUAL(a.tables, gray.tables);
+}
+
+static void test_not_a_jpeg_is_kept_in_full() {
+  static const uint8_t junk[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05};
+  jpeg_strip_t strip;
+
+  TEST_ASSERT_FALSE(jpeg_tables_strip(junk, sizeof(junk), &strip));
+  TEST_ASSERT_EQUAL(0, strip.tables);
+  TEST_ASSERT_EQUAL(sizeof(junk), strip.len);
+  // Cut off before the scan
+  TEST_ASSERT_FALSE(jpeg_tables_strip(jpeg_420, 300, &strip));
+  TEST_ASSERT_EQUAL(0, strip.tables);
+}
+
+// What goes to the coordinator: frames and their tables apart
+static void assert_split(const uint8_t *jpeg, size_t len, const char *name) {
+  static const size_t chunks[] = {1, 7, 4096};
+  jpeg_strip_t strip;
+  jpeg_tables_t tables;
+  char runs[64];
+
+  TEST_ASSERT_TRUE_MESSAGE(jpeg_tables_split(jpeg, len, &strip, &tables),
+                           name);
+  TEST_ASSERT_EQUAL(0, strip.tables);
+  TEST_ASSERT_EQUAL_MESSAGE(len, strip.len + tables.len, name);
+
+  for (size_t chunk : chunks) {
+    JpegStripStream src(jpeg, strip);
+    bytes_t abbreviated(strip.len);
+    size_t pos = 0;
+    size_t got;
+    TEST_ASSERT_EQUAL(strip.len, src.available());
+    while ((got = src.readBytes((char *)abbreviated.data() + pos,
+                                min(chunk, abbreviated.size() - pos))) > 0) {
+      pos += got;
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(strip.len, pos, name);
+    TEST_ASSERT_EQUAL(-1, src.read());
+    TEST_ASSERT_FALSE(has_marker(abbreviated.data(), pos, 0xDB));
+    TEST_ASSERT_FALSE(has_marker(abbreviated.data(), pos, 0xC4));
+
+    File file = SD_MMC.open("/split.jpg", FILE_WRITE);
+    file.write(abbreviated.data(), pos);
+    file.close();
+    bytes_t out = expand("/split.jpg", tables, 4096);
+    TEST_ASSERT_EQUAL_MESSAGE(len, out.size(), name);
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(jpeg, out.data(), len, name);
+  }
+
+  // Read back by the coordinator as where each run goes
+  size_t n = jpeg_tables_format_runs(&tables, runs, sizeof(runs));
+  TEST_ASSERT_EQUAL(strlen(runs), n);
+  const char *p = runs;
+  for (int i = 0; i < tables.run_count; i++) {
+    unsigned long at;
+    unsigned run_len;
+    int used;
+    TEST_ASSERT_EQUAL(2, sscanf(p, "%lu:%u%n", &at, &run_len, &used));
+    TEST_ASSERT_EQUAL(tables.runs[i].at, at);
+    TEST_ASSERT_EQUAL(tables.runs[i].len, run_len);
+    p += used;
+    if (*p == ',') p++;
+  }
+  TEST_ASSERT_EQUAL('\0', *p);
+}
+
+static void test_split_frames_stream_abbreviated() {
+  assert_split(jpeg_420, sizeof(jpeg_420), "jpeg_420");
+  assert_split(jpeg_444_rst, sizeof(jpeg_444_rst), "jpeg_444_rst");
+  assert_split(jpeg_gray, sizeof(jpeg_gray), "jpeg_gray");
+  assert_split(jpeg_420_odd, sizeof(jpeg_420_odd), "jpeg_420_odd");
+
+  // Not abbreviated, and nothing to register
+  jpeg_strip_t strip;
+  jpeg_tables_t tables;
+  TEST_ASSERT_FALSE(jpeg_tables_split(jpeg_420, 300, &strip, &tables));
+  TEST_ASSERT_EQUAL(300, strip.len);
+  TEST_ASSERT_EQUAL(0, strip.run_count);
+}
+
+static void test_saved_set_expands_after_reboot() {
+  jpeg_strip_t strip;
+  jpeg_tables_t loaded;
+
+  TEST_ASSERT_TRUE(abbreviate(jpeg_422, sizeof(jpeg_422), "/422.jpg", &strip));
+  TEST_ASSERT_TRUE(
+      jpeg_tables_save(jpeg_tables_get(strip.tables), "/event/tables1"));
+  memset(&loaded, 0xA5, sizeof(loaded));
+  TEST_ASSERT_TRUE(jpeg_tables_load(&loaded, "/event/tables1"));
+
+  bytes_t out = expand("/422.jpg", loaded, 4096);
+  TEST_ASSERT_EQUAL(sizeof(jpeg_422), out.size());
+  TEST_ASSERT_EQUAL_MEMORY(jpeg_422, out.data(), sizeof(jpeg_422));
+
+  TEST_ASSERT_FALSE(jpeg_tables_load(&loaded, "/event/tables2"));
+  File cut = SD_MMC.open("/event/tables3", FILE_WRITE);
+  cut.write((const uint8_t *)jpeg_tables_get(strip.tables), 20);
+  cut.close();
+  TEST_ASSERT_FALSE(jpeg_tables_load(&loaded, "/event/tables3"));
+}
+
+static void test_unused_set_is_replaced() {
+  jpeg_strip_t strip;
+  uint8_t color, gray, q50, q60;
+
+  // Take every set
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_420, sizeof(jpeg_420), &strip));
+  color = strip.tables;
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_gray, sizeof(jpeg_gray), &strip));
+  gray = strip.tables;
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_q50, sizeof(jpeg_q50), &strip));
+  q50 = strip.tables;
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_q60, sizeof(jpeg_q60), &strip));
+  q60 = strip.tables;
+  TEST_ASSERT_EQUAL(JPEG_TABLES_MAX_SETS, max(max(color, gray), max(q50, q60)));
+
+  // The grayscale set is the only one the ring buffer no longer uses
+  TEST_ASSERT_TRUE(frame_index_init(4));
+  add_frame(0, color);
+  add_frame(1, q50);
+  add_frame(2, q60);
+  TEST_ASSERT_EQUAL((1u << color) | (1u << q50) | (1u << q60),
+                    frame_index_tables_used());
+  TEST_ASSERT_TRUE(abbreviate(jpeg_q70, sizeof(jpeg_q70), "/q70.jpg", &strip));
+  TEST_ASSERT_EQUAL(gray, strip.tables);
+  bytes_t out = expand("/q70.jpg", *jpeg_tables_get(gray), 4096);
+  TEST_ASSERT_EQUAL(sizeof(jpeg_q70), out.size());
+  TEST_ASSERT_EQUAL_MEMORY(jpeg_q70, out.data(), sizeof(jpeg_q70));
+  add_frame(3, gray);
+
+  // Unused sets are looked for at most once a second. With all of
+  // them in use, frames are stored in full
+  delay(1000);
+  TEST_ASSERT_FALSE(jpeg_tables_strip(jpeg_q80, sizeof(jpeg_q80), &strip));
+  TEST_ASSERT_EQUAL(0, strip.tables);
+  TEST_ASSERT_EQUAL(sizeof(jpeg_q80), strip.len);
+
+  // Until the ring buffer moves past the frames of a set
+  frame_index_clear_slot(1);
+  delay(1000);
+  TEST_ASSERT_TRUE(abbreviate(jpeg_q80, sizeof(jpeg_q80), "/q80.jpg", &strip));
+  TEST_ASSERT_EQUAL(q50, strip.tables);
+  out = expand("/q80.jpg", *jpeg_tables_get(q50), 4096);
+  TEST_ASSERT_EQUAL(sizeof(jpeg_q80), out.size());
+  TEST_ASSERT_EQUAL_MEMORY(jpeg_q80, out.data(), sizeof(jpeg_q80));
+
+  // Sets still in use are left as they were
+  TEST_ASSERT_TRUE(jpeg_tables_strip(jpeg_444, sizeof(jpeg_444), &strip));
+  TEST_ASSERT_EQUAL(color, strip.tables);
+  ASSERT_ROUND_TRIP(jpeg_444);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip_is_byte_exact);
+  RUN_TEST(test_same_tables_share_a_set);
+  RUN_TEST(test_not_a_jpeg_is_kept_in_full);
+  RUN_TEST(test_split_frames_stream_abbreviated);
+  RUN_TEST(test_saved_set_expands_after_reboot);
+  // Registers sets of its own, keep last
+  RUN_TEST(test_unused_set_is_replaced);
+  return UNITY_END();
+}
@@ -0,0 +1,318 @@
+#include <Arduino.h>
+#include <SD_MMC.h>
+#include <unity.h>
+
+#include <chrono>
+#include <vector>
+
+#include "../host_config.h"
+#include "../jpeg_fixtures.h"
+#include "pipeline_host.h"
+
+// === Helpers ===
+
+#define RING_SIZE (4)
+#define FRAME_MS (200)
+#define FRAMES_PER_SECOND (1000 / FRAME_MS)
+
+typedef CaptureStage<SyntheticSource, ManualClock> capture_t;
+typedef CropStage<ManualClock> crop_t;
+typedef SaveStage<MemorySink> save_t;
+typedef StreamStage<CountingTransport, ManualClock> stream_t;
+
+// What came out of a run, frame by frame
+typedef struct {
+  std::vector<uint32_t> epochs;
+  std::vector<uint16_t> ms;
+  std::vector<uint32_t> saved;
+  std::vector<uint32_t> sent;
+  uint64_t sink_bytes;
+  uint32_t stream_frames;
+  uint64_t stream_bytes;
+  // Host time spent in each stage, not compared between runs
+  uint64_t capture_us;
+  uint64_t crop_us;
+  uint64_t save_us;
+  uint64_t stream_us;
+} run_t;
+
+void setUp() {
+  static bool ready = false;
+  if (!ready) ready = frame_index_init(RING_SIZE);
+  ManualClock::now_us() = 0;
+  perfConfig.roi_left = perfConfig.roi_top = 0;
+  perfConfig.roi_width = perfConfig.roi_height = 100;
+  perfConfig.link_budget_kbps = 0;
+  perfConfig.stream_policy = LINK_POLICY_PAUSE;
+}
+
+void tearDown() {}
+
+static uint64_t host_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Capture, crop, save and stream `seconds` worth of frames
+static void run(run_t *r, int seconds) {
+  capture_t capture;
+  crop_t crop("test");
+  save_t save;
+  stream_t stream;
+  int frame = 0;
+
+  *r = {};
+  capture.source().begin(jpeg_420, sizeof(jpeg_420), 64, 48);
+  for (int i = 0; i < seconds * FRAMES_PER_SECOND; i++) {
+    uint64_t t0 = host_us();
+    if (capture.tick(RING_SIZE)) frame = 0;
+    uint16_t ms;
+    camera_fb_t *fb = capture.capture(&ms);
+    TEST_ASSERT_NOT_NULL(fb);
+    uint64_t t1 = host_us();
+
+    camera_fb_t tmp;
+    const camera_fb_t *out = crop.apply(fb, &tmp);
+    uint64_t t2 = host_us();
+
+    save.save(capture.slot(), capture.epoch(), frame, ms, out);
+    uint64_t t3 = host_us();
+
+    bool kept;
+    bool sent = stream.send(out->buf, out->len, capture.epoch(), frame, 0,
+                            &kept);
+    uint64_t t4 = host_us();
+    capture.release(fb);
+
+    frame_index_entry_t e = {};
+    frame_index_slot_t info;
+    if (frame_index_get(capture.slot(), &info) && frame < info.count) {
+      e = info.frames[frame];
+    }
+    r->epochs.push_back(capture.epoch());
+    r->ms.push_back(ms);
+    r->saved.push_back(e.size);
+    r->sent.push_back(sent ? out->len : 0);
+    r->capture_us += t1 - t0;
+    r->crop_us += t2 - t1;
+    r->save_us += t3 - t2;
+    r->stream_us += t4 - t3;
+
+    frame++;
+    ManualClock::advance_ms(FRAME_MS);
+  }
+  r->sink_bytes = save.sink().bytes();
+  r->stream_frames = stream.transport().frames();
+  r->stream_bytes = stream.transport().bytes();
+}
+
+// Width and height given by the SOF segment
+static bool sof_size(const uint8_t *buf, size_t len, uint16_t *width,
+                     uint16_t *height) {
+  for (size_t i = 2; i + 9 < len; i++) {
+    if (buf[i] == 0xFF && buf[i + 1] == 0xC0) {
+      *height = (buf[i + 5] << 8) | buf[i + 6];
+      *width = (buf[i + 7] << 8) | buf[i + 8];
+      return true;
+    }
+  }
+  return false;
+}
+
+// === Tests ===
+
+static void test_capture_stamps_follow_the_clock() {
+  capture_t capture;
+  uint16_t ms;
+
+  capture.source().begin(jpeg_420, sizeof(jpeg_420), 64, 48);
+  TEST_ASSERT_TRUE(capture.tick(RING_SIZE));
+  TEST_ASSERT_EQUAL(1700000000, capture.epoch());
+  TEST_ASSERT_EQUAL(1700000000 % RING_SIZE, capture.slot());
+
+  // Within a second, frames are stamped with the time since it began
+  static const uint32_t steps_ms[] = {0, 150, 270, 579};
+  static const uint16_t want_ms[] = {0, 150, 420, 999};
+  for (int i = 0; i < 4; i++) {
+    ManualClock::advance_ms(steps_ms[i]);
+    TEST_ASSERT_FALSE(capture.tick(RING_SIZE));
+    camera_fb_t *fb = capture.capture(&ms);
+    TEST_ASSERT_NOT_NULL(fb);
+    TEST_ASSERT_EQUAL(want_ms[i], ms);
+    TEST_ASSERT_EQUAL(PIXFORMAT_JPEG, fb->format);
+    // Like the driver, one frame at a time
+    TEST_ASSERT_NULL(capture.capture(&ms));
+    capture.release(fb);
+  }
+
+  // The next second starts when it is noticed, not on the boundary
+  ManualClock::advance_ms(31);
+  TEST_ASSERT_TRUE(capture.tick(RING_SIZE));
+  TEST_ASSERT_EQUAL(1700000001, capture.epoch());
+  camera_fb_t *fb = capture.capture(&ms);
+  TEST_ASSERT_EQUAL(0, ms);
+  capture.release(fb);
+  ManualClock::advance_ms(1500);
+  TEST_ASSERT_TRUE(capture.tick(RING_SIZE));
+  TEST_ASSERT_EQUAL(1700000002, capture.epoch());
+  TEST_ASSERT_EQUAL(5, capture.source().count());
+}
+
+static void test_crop_stage_cuts_to_the_roi() {
+  crop_t crop("test");
+  camera_fb_t fb = {(uint8_t *)jpeg_420, sizeof(jpeg_420), 64, 48,
+                    PIXFORMAT_JPEG, {}};
+  camera_fb_t tmp;
+  uint16_t width, height;
+
+  // Whole frame, passed on as it is
+  TEST_ASSERT_TRUE(crop.apply(&fb, &tmp) == &fb);
+
+  // 16 to 48 pixels across, widened to whole MCUs of 16x16
+  perfConfig.roi_left = 25;
+  perfConfig.roi_top = 25;
+  perfConfig.roi_width = 50;
+  perfConfig.roi_height = 50;
+  const camera_fb_t *out = crop.apply(&fb, &tmp);
+  TEST_ASSERT_TRUE(out == &tmp);
+  TEST_ASSERT_EQUAL(32, out->width);
+  TEST_ASSERT_EQUAL(48, out->height);
+  TEST_ASSERT_LESS_THAN(sizeof(jpeg_420), out->len);
+  TEST_ASSERT_TRUE(sof_size(out->buf, out->len, &width, &height));
+  TEST_ASSERT_EQUAL(32, width);
+  TEST_ASSERT_EQUAL(48, height);
+
+  // Not a JPEG, passed on as it is
+  fb.format = PIXFORMAT_RGB565;
+  TEST_ASSERT_TRUE(crop.apply(&fb, &tmp) == &fb);
+}
+
+static void test_save_stage_indexes_abbreviated_frames() {
+  run_t r;
+  run(&r, 3);
+
+  const size_t tables_len = sizeof(jpeg_420) - r.saved[0];
+  TEST_ASSERT_GREATER_THAN(0, tables_len);
+  uint64_t total = 0;
+  for (int s = 0; s < 3; s++) {
+    const uint32_t epoch = 1700000000 + s;
+    frame_index_slot_t info;
+    TEST_ASSERT_TRUE(frame_index_get(epoch % RING_SIZE, &info));
+    TEST_ASSERT_EQUAL(epoch, info.epoch);
+    TEST_ASSERT_EQUAL(FRAMES_PER_SECOND, info.count);
+    for (int n = 0; n < info.count; n++) {
+      const frame_index_entry_t &e = info.frames[n];
+      TEST_ASSERT_TRUE(e.valid);
+      TEST_ASSERT_FALSE(e.repeat);
+      TEST_ASSERT_EQUAL(n * FRAME_MS, e.ms);
+      TEST_ASSERT_EQUAL(sizeof(jpeg_420) - tables_len, e.size);
+      TEST_ASSERT_NOT_NULL(jpeg_tables_get(e.tables));
+      total += e.size;
+    }
+  }
+  TEST_ASSERT_EQUAL(total, r.sink_bytes);
+}
+
+static void test_save_stage_keeps_the_first_saved_frame() {
+  capture_t capture;
+  save_t save;
+  uint16_t ms;
+  frame_index_slot_t info;
+
+  perfConfig.static_threshold = 1;
+  capture.source().begin(jpeg_420_sq, sizeof(jpeg_420_sq), 64, 64);
+  for (int s = 0; s < 2; s++) {
+    ManualClock::advance_ms(1000);
+    capture.tick(RING_SIZE);
+    // Frame 0 of the second second was dropped before being saved
+    for (int n = s; n < FRAMES_PER_SECOND; n++) {
+      camera_fb_t *fb = capture.capture(&ms);
+      TEST_ASSERT_NOT_NULL(fb);
+      save.save(capture.slot(), capture.epoch(), n, ms, fb);
+      capture.release(fb);
+    }
+
+    TEST_ASSERT_TRUE(frame_index_get(capture.slot(), &info));
+    TEST_ASSERT_EQUAL(FRAMES_PER_SECOND, info.count);
+    TEST_ASSERT_EQUAL(s == 0, info.frames[0].valid);
+    // Stored in full, what follows repeats it
+    TEST_ASSERT_TRUE(info.frames[s].valid);
+    TEST_ASSERT_FALSE(info.frames[s].repeat);
+    TEST_ASSERT_GREATER_THAN(0, info.frames[s].size);
+    for (int n = s + 1; n < FRAMES_PER_SECOND; n++) {
+      TEST_ASSERT_TRUE(info.frames[n].valid);
+      TEST_ASSERT_TRUE(info.frames[n].repeat);
+    }
+  }
+  perfConfig.static_threshold = CONFIG_STATIC_SCENE_THRESHOLD;
+}
+
+static void test_stream_stage_follows_the_link() {
+  stream_t stream;
+  bool kept;
+
+  TEST_ASSERT_TRUE(stream.send(jpeg_420, sizeof(jpeg_420), 1700000000, 0, 0,
+                               &kept));
+  TEST_ASSERT_TRUE(kept);
+  TEST_ASSERT_TRUE(stream.send(jpeg_420, sizeof(jpeg_420), 1700000000, -1, 0,
+                               &kept));
+  TEST_ASSERT_FALSE(kept);
+
+  // Paused while an event is uploaded
+  link_upload_begin();
+  TEST_ASSERT_FALSE(stream.send(jpeg_420, sizeof(jpeg_420), 1700000000, 1, 0,
+                                &kept));
+  link_upload_end();
+  TEST_ASSERT_TRUE(stream.send(jpeg_420, sizeof(jpeg_420), 1700000000, 2, 0,
+                               &kept));
+
+  TEST_ASSERT_EQUAL(3, stream.transport().frames());
+  TEST_ASSERT_EQUAL(3 * sizeof(jpeg_420), stream.transport().bytes());
+}
+
+static void test_runs_are_repeatable() {
+  char msg[160];
+  run_t a, b;
+
+  perfConfig.roi_left = 25;
+  perfConfig.roi_width = 50;
+  run(&a, 5);
+  setUp();
+  perfConfig.roi_left = 25;
+  perfConfig.roi_width = 50;
+  run(&b, 5);
+
+  TEST_ASSERT_TRUE(a.epochs == b.epochs);
+  TEST_ASSERT_TRUE(a.ms == b.ms);
+  TEST_ASSERT_TRUE(a.saved == b.saved);
+  TEST_ASSERT_TRUE(a.sent == b.sent);
+  TEST_ASSERT_EQUAL(a.sink_bytes, b.sink_bytes);
+  TEST_ASSERT_EQUAL(a.stream_frames, b.stream_frames);
+  TEST_ASSERT_EQUAL(a.stream_bytes, b.stream_bytes);
+  TEST_ASSERT_EQUAL(5 * FRAMES_PER_SECOND, a.stream_frames);
+  // Cropped before being sent, and abbreviated when saved
+  TEST_ASSERT_LESS_THAN(sizeof(jpeg_420), a.sent[0]);
+  TEST_ASSERT_LESS_THAN(a.sent[0], a.saved[0]);
+
+  const size_t frames = a.ms.size();
+  snprintf(msg, sizeof(msg),
+           "Host cost per frame: capture %llu us, crop %llu us, save %llu us, "
+           "stream %llu us",
+           (unsigned long long)(a.capture_us / frames),
+           (unsigned long long)(a.crop_us / frames),
+           (unsigned long long)(a.save_us / frames),
+           (unsigned long long)(a.stream_us / frames));
+  TEST_MESSAGE(msg);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_capture_stamps_follow_the_clock);
+  RUN_TEST(test_crop_stage_cuts_to_the_roi);
+  RUN_TEST(test_save_stage_indexes_abbreviated_frames);
+  RUN_TEST(test_save_stage_keeps_the_first_saved_frame);
+  RUN_TEST(test_stream_stage_follows_the_link);
+  RUN_TEST(test_runs_are_repeatable);
+  return UNITY_END();
+}
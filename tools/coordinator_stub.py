@@ -0,0 +1,342 @@
+#!/usr/bin/env python3
+"""Stand-in coordinators for trying out uploads across several of them.
+
+Starts one HTTP server per port which accepts registration, the live
+stream, event previews and uploads, and prints what each one
+received. A server can be made slow, or made to stop answering after
+a number of requests, to see cameras move their uploads to the next
+coordinator (see include/coordinator_pool.h).
+
+With --max-events, uploads are admitted like a loaded coordinator
+would: only that many events are taken at once, others are turned
+away with 503 and Retry-After, and admitted events get an
+Upload-Token. --ingest-kbps caps what a server takes in overall.
+tools/upload_load.py drives many uploaders against it.
+
+Frames sent without their JPEG tables are put back together from the
+table sets sent ahead of them (Table-Set, Frame-Tables), and the bytes
+this saved on the wire are printed. --no-table-sets answers like a
+coordinator which does not know about them, so frames come in full.
+
+    python3 tools/coordinator_stub.py --ports 8001 8002 8003 \\
+        --delay-ms 8002=300 --fail-after 8001=50
+    python3 tools/coordinator_stub.py --ports 8001 --quiet \\
+        --max-events 4 --retry-after 1 --ingest-kbps 2000
+"""
+
+import argparse
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+import time
+import uuid
+
+# Admitted events which have sent nothing for this long are
+# given up on, in case their camera went away
+ADMISSION_IDLE_S = 10
+
+
+class Admission:
+    """Events being taken in, at most `limit` at a time."""
+
+    def __init__(self, limit, retry_after):
+        self.limit = limit
+        self.retry_after = retry_after
+        self.active = {}  # (device, event) -> (token, last request time)
+        self.turned_away = 0
+        self.lock = threading.Lock()
+
+    def admit(self, key, token):
+        """Token of the event, None if it has to come back later."""
+        now = time.monotonic()
+        with self.lock:
+            for k, (_, seen) in list(self.active.items()):
+                if now - seen > ADMISSION_IDLE_S:
+                    del self.active[k]
+            if key in self.active:
+                token = self.active[key][0]
+            elif len(self.active) >= self.limit:
+                self.turned_away += 1
+                return None
+            else:
+                token = token or uuid.uuid4().hex[:16]
+            self.active[key] = (token, now)
+            return token
+
+    def done(self, key):
+        with self.lock:
+            self.active.pop(key, None)
+
+
+class TableSets:
+    """JPEG table sets sent ahead of abbreviated frames.
+
+    Kept per stream, or per event for uploads. Frames only carry the
+    id of their set, which is put back where the runs say.
+    """
+
+    def __init__(self):
+        self.sets = {}  # (path, query, event) -> {id: [(at, data)]}
+        self.left_out = 0  # Bytes of tables frames came without
+        self.sent = 0  # Bytes of the sets themselves
+        self.lock = threading.Lock()
+
+    def add(self, key, set_id, runs, body):
+        parts = []
+        used = 0
+        try:
+            for run in runs.split(","):
+                at, length = (int(v) for v in run.split(":"))
+                parts.append((at, body[used:used + length]))
+                used += length
+        except ValueError:
+            return False
+        if used != len(body):
+            return False
+        with self.lock:
+            self.sets.setdefault(key, {})[set_id] = parts
+            self.sent += len(body)
+        return True
+
+    def expand(self, key, set_id, body):
+        """The original JPEG, None if the set is not known."""
+        with self.lock:
+            parts = self.sets.get(key, {}).get(set_id)
+            if parts is None:
+                return None
+            self.left_out += sum(len(data) for _, data in parts)
+        out = bytearray()
+        pos = 0
+        for at, data in parts:
+            out += body[pos:at] + data
+            pos = at
+        return bytes(out + body[pos:])
+
+    def done(self, key):
+        with self.lock:
+            self.sets.pop(key, None)
+
+    def saved(self):
+        with self.lock:
+            return self.left_out - self.sent
+
+
+class Ingest:
+    """Shared pipe into the coordinator, `kbps` for all requests."""
+
+    def __init__(self, kbps):
+        self.kbps = kbps
+        self.free_at = 0.0
+        self.lock = threading.Lock()
+
+    def take(self, length):
+        if not self.kbps:
+            return
+        with self.lock:
+            start = max(time.monotonic(), self.free_at)
+            self.free_at = start + length / (self.kbps * 1000 / 8)
+            wait = self.free_at - time.monotonic()
+        if wait > 0:
+            time.sleep(wait)
+
+
+def make_handler(port, delay_ms, fail_after, admission, ingest, tables,
+                 quiet):
+    state = {"requests": 0}
+    lock = threading.Lock()
+
+    class Handler(BaseHTTPRequestHandler):
+        def log_message(self, fmt, *args):
+            pass
+
+        def handle_any(self):
+            length = int(self.headers.get("Content-Length") or 0)
+            body = self.rfile.read(length) if length else b""
+
+            with lock:
+                state["requests"] += 1
+                count = state["requests"]
+
+            # Drop the connection without answering, like a crashed host
+            if fail_after is not None and count > fail_after:
+                self.close_connection = True
+                self.connection.close()
+                return
+
+            if delay_ms:
+                time.sleep(delay_ms / 1000)
+
+            path, _, query = self.path.partition("?")
+            status = 204
+            headers = {}
+            if path == "/api/device/upload" and admission:
+                key = (query, self.headers.get("Event-Timestamp"))
+                token = admission.admit(key, self.headers.get("Upload-Token"))
+                if token is None:
+                    self.send_response(503)
+                    self.send_header("Retry-After", str(admission.retry_after))
+                    self.end_headers()
+                    return
+                if self.headers.get("Upload-Complete") == "true":
+                    admission.done(key)
+                headers["Upload-Token"] = token
+            if ingest:
+                ingest.take(len(body))
+
+            # Sets are per event for uploads, per camera for the stream
+            event = None
+            if path == "/api/device/upload":
+                event = self.headers.get("Event-Timestamp")
+            set_key = (path, query, event)
+            set_id = self.headers.get("Table-Set")
+            if set_id is not None and tables:
+                runs = self.headers.get("Table-Runs") or ""
+                if not tables.add(set_key, set_id, runs, body):
+                    self.send_response(400)
+                    self.end_headers()
+                    return
+                if not quiet:
+                    where = f"event {event}" if event else path
+                    print(f"[{port}] table set {set_id} for {where}, "
+                          f"{len(body)} bytes", flush=True)
+                self.send_response(204)
+                self.send_header("Table-Set", set_id)
+                for name, value in headers.items():
+                    self.send_header(name, value)
+                self.end_headers()
+                return
+            abbreviated = len(body)
+            frame_tables = self.headers.get("Frame-Tables")
+            if frame_tables is not None and tables:
+                body = tables.expand(set_key, frame_tables, body)
+                if body is None:
+                    # Lost, e.g. restarted, the camera sends it again
+                    self.send_response(409)
+                    self.end_headers()
+                    return
+
+            if path == "/api/device/upload":
+                parts = [f"event {self.headers.get('Event-Timestamp')}"]
+                if self.headers.get("Upload-Complete") == "true":
+                    parts.append("complete")
+                    missing = self.headers.get("Missing-Frames")
+                    if missing:
+                        parts.append(f"missing {missing}")
+                    if tables:
+                        tables.done(set_key)
+                else:
+                    parts.append(f"frame {self.headers.get('Frame-Second')}:"
+                                 f"{self.headers.get('Frame-Number')}")
+                    repeat = self.headers.get("Repeat-Of")
+                    if repeat:
+                        parts.append(f"repeat of {repeat}")
+                    elif frame_tables is not None:
+                        parts.append(f"{len(body)} bytes ({abbreviated} sent, "
+                                     f"tables {frame_tables})")
+                    else:
+                        parts.append(f"{len(body)} bytes")
+                previous = self.headers.get("Previous-Coordinator")
+                if previous:
+                    parts.append(f"from {previous}")
+                if not quiet:
+                    print(f"[{port}] " + ", ".join(parts), flush=True)
+                # Nothing was kept from the stream, frames are sent instead
+                if self.headers.get("Stream-Reference"):
+                    status = 404
+            elif quiet:
+                pass
+            elif path == "/api/device/preview":
+                print(f"[{port}] preview of event "
+                      f"{self.headers.get('Event-Timestamp')}, frames "
+                      f"{self.headers.get('Preview-Frames')}, "
+                      f"{len(body)} bytes", flush=True)
+            elif path == "/api/device/register":
+                print(f"[{port}] register {body.decode(errors='replace')}",
+                      flush=True)
+
+            self.send_response(status)
+            for name, value in headers.items():
+                self.send_header(name, value)
+            self.end_headers()
+
+        do_PUT = handle_any
+        do_POST = handle_any
+
+    return Handler
+
+
+def parse_overrides(items):
+    out = {}
+    for item in items or []:
+        port, value = item.split("=")
+        out[int(port)] = int(value)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--ports", type=int, nargs="+", default=[8001, 8002])
+    parser.add_argument("--delay-ms", nargs="*", metavar="PORT=MS",
+                        help="answer every request of PORT after MS")
+    parser.add_argument("--fail-after", nargs="*", metavar="PORT=N",
+                        help="stop answering on PORT after N requests")
+    parser.add_argument("--max-events", type=int, default=0,
+                        help="events taken in at once per server, others "
+                             "get 503 (0 takes every event)")
+    parser.add_argument("--retry-after", type=int, default=1,
+                        help="seconds sent back with a 503")
+    parser.add_argument("--ingest-kbps", type=int, default=0,
+                        help="what each server takes in overall "
+                             "(0 for no limit)")
+    parser.add_argument("--no-table-sets", action="store_true",
+                        help="do not take JPEG table sets, like an older "
+                             "coordinator")
+    parser.add_argument("--quiet", action="store_true",
+                        help="only print a summary every few seconds")
+    args = parser.parse_args()
+
+    delays = parse_overrides(args.delay_ms)
+    fails = parse_overrides(args.fail_after)
+
+    servers = []
+    admissions = []
+    all_tables = []
+    for port in args.ports:
+        admission = None
+        if args.max_events:
+            admission = Admission(args.max_events, args.retry_after)
+            admissions.append((port, admission))
+        tables = None
+        if not args.no_table_sets:
+            tables = TableSets()
+            all_tables.append((port, tables))
+        handler = make_handler(port, delays.get(port, 0), fails.get(port),
+                               admission, Ingest(args.ingest_kbps), tables,
+                               args.quiet)
+        server = ThreadingHTTPServer(("", port), handler)
+        server.daemon_threads = True
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        servers.append(server)
+        print(f"Coordinator on port {port}", flush=True)
+
+    try:
+        while True:
+            time.sleep(5)
+            for port, admission in admissions:
+                with admission.lock:
+                    active = len(admission.active)
+                print(f"[{port}] {active} events admitted, "
+                      f"{admission.turned_away} requests turned away",
+                      flush=True)
+            for port, tables in all_tables:
+                if tables.left_out:
+                    print(f"[{port}] {tables.saved()} bytes saved on the "
+                          f"wire by table sets ({tables.left_out} left out "
+                          f"of frames, {tables.sent} sent as sets)",
+                          flush=True)
+    except KeyboardInterrupt:
+        for server in servers:
+            server.shutdown()
+
+
+if __name__ == "__main__":
+    main()
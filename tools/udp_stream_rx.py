@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Receiver for the UDP live stream (see include/udp_stream.h).
+
+Reassembles frames from each camera, drops frames which are still
+incomplete when a newer one starts, and writes the latest complete
+frame of every camera to <out>/<camera ip>.jpg.
+
+    python3 tools/udp_stream_rx.py --port 5005 --out /tmp/stream
+"""
+
+import argparse
+import os
+import socket
+import struct
+import time
+
+HEADER = struct.Struct(">2sBBIIIIHH")
+MAGIC = b"HS"
+VERSION = 1
+
+
+class Camera:
+    def __init__(self):
+        self.frame_id = None
+        self.fragments = {}
+        self.frag_count = 0
+        self.started = 0.0
+        self.last_seq = None
+        # Counters since the last report
+        self.complete = 0
+        self.dropped = 0
+        self.lost = 0
+        self.latency_ms = 0.0
+
+    def drop_pending(self):
+        if self.frame_id is not None and self.fragments:
+            self.dropped += 1
+        self.frame_id = None
+        self.fragments = {}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", type=int, default=5005)
+    parser.add_argument("--out", default=None,
+                        help="directory for the latest frame of each camera")
+    args = parser.parse_args()
+
+    if args.out:
+        os.makedirs(args.out, exist_ok=True)
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", args.port))
+    sock.settimeout(1.0)
+    print(f"Listening on UDP port {args.port}")
+
+    cameras = {}
+    last_report = time.monotonic()
+
+    while True:
+        try:
+            data, (ip, _) = sock.recvfrom(65535)
+        except socket.timeout:
+            data = None
+
+        if data and len(data) >= HEADER.size:
+            (magic, version, _flags, seq, frame_id, epoch, frame_len,
+             frag, frag_count) = HEADER.unpack_from(data)
+            if magic == MAGIC and version == VERSION:
+                cam = cameras.setdefault(ip, Camera())
+                if cam.last_seq is not None and seq > cam.last_seq + 1:
+                    cam.lost += seq - cam.last_seq - 1
+                cam.last_seq = seq
+
+                # A newer frame makes the pending one worthless
+                if frame_id != cam.frame_id:
+                    if cam.frame_id is not None and \
+                            (frame_id - cam.frame_id) & 0xFFFFFFFF > 0x7FFFFFFF:
+                        continue  # Late fragment of an older frame
+                    cam.drop_pending()
+                    cam.frame_id = frame_id
+                    cam.frag_count = frag_count
+                    cam.started = time.monotonic()
+
+                cam.fragments[frag] = data[HEADER.size:]
+                if len(cam.fragments) == cam.frag_count:
+                    jpg = b"".join(cam.fragments[i]
+                                   for i in range(cam.frag_count))
+                    if len(jpg) == frame_len:
+                        cam.complete += 1
+                        cam.latency_ms += (time.monotonic() - cam.started) * 1000
+                        if args.out:
+                            path = os.path.join(args.out, f"{ip}.jpg")
+                            with open(path + ".tmp", "wb") as f:
+                                f.write(jpg)
+                            os.replace(path + ".tmp", path)
+                    else:
+                        cam.dropped += 1
+                    cam.fragments = {}
+
+        now = time.monotonic()
+        if now - last_report >= 5.0:
+            for ip, cam in cameras.items():
+                avg = cam.latency_ms / cam.complete if cam.complete else 0
+                print(f"{ip}: {cam.complete / (now - last_report):.1f} fps, "
+                      f"{cam.dropped} dropped, {cam.lost} datagrams lost, "
+                      f"assembly {avg:.0f} ms")
+                cam.complete = cam.dropped = cam.lost = 0
+                cam.latency_ms = 0.0
+            last_report = now
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""Many cameras uploading events at once to one coordinator.
+
+Each simulated camera sends its events frame by frame, the way
+src/event_outbox.cpp does: a random delay before each event, 429/503
+answers waited out (Retry-After, else a jittered backoff) without
+counting as failures, Upload-Token echoed back, failed frames
+deferred to the end of the event. Prints how much the coordinator
+took in every second, and a summary at the end, to check that
+ingest stays steady as cameras are added.
+
+    python3 tools/coordinator_stub.py --ports 8001 --quiet \\
+        --max-events 4 --retry-after 1 --ingest-kbps 2000
+    python3 tools/upload_load.py --url http://localhost:8001 --cameras 32
+
+--ignore-busy makes the cameras retry turned away frames right away,
+for comparison.
+"""
+
+import argparse
+import http.client
+import random
+import statistics
+import threading
+import time
+import urllib.parse
+
+# Same limits as src/event_outbox.cpp and include/app_config.h
+MAX_FRAME_RETRIES = 5
+BASE_BACKOFF_MS = 200
+MAX_CONSECUTIVE_FAILURES = 8
+MAX_BUSY_RETRIES = 10
+NET_BACKOFF_MAX_MS = 30000
+UPLOAD_START_JITTER_MS = 3000
+
+
+def retry_delay_ms(attempt):
+    delay = BASE_BACKOFF_MS << min(attempt - 1, 6)
+    return delay + random.randint(0, delay // 2)
+
+
+class Totals:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.bytes = 0
+        self.frames = 0
+        self.busy = 0
+        self.failed = 0
+        self.events = 0
+        self.event_s = []
+        self.per_second = {}
+
+    def add(self, **counts):
+        with self.lock:
+            for name, value in counts.items():
+                setattr(self, name, getattr(self, name) + value)
+            if counts.get("bytes"):
+                now = int(time.monotonic())
+                self.per_second[now] = (self.per_second.get(now, 0) +
+                                        counts["bytes"])
+
+
+class Camera(threading.Thread):
+    def __init__(self, index, args, totals):
+        super().__init__(daemon=True)
+        self.name = f"cam{index:03d}"
+        self.args = args
+        self.totals = totals
+        url = urllib.parse.urlparse(args.url)
+        self.host = url.hostname
+        self.port = url.port or 80
+        self.path = f"/api/device/upload?device={self.name}"
+        self.token = None
+        self.retry_after_ms = 0
+        self.frame = bytes(random.getrandbits(8)
+                           for _ in range(args.frame_kb * 1024))
+
+    def request(self, event, headers, body=b""):
+        headers = dict(headers, **{
+            "Content-Type": "image/jpeg",
+            "Event-Timestamp": str(event),
+        })
+        if self.token:
+            headers["Upload-Token"] = self.token
+        conn = http.client.HTTPConnection(self.host, self.port,
+                                          timeout=self.args.timeout_ms / 1000)
+        try:
+            conn.request("POST", self.path, body, headers)
+            resp = conn.getresponse()
+            resp.read()
+            if resp.getheader("Upload-Token"):
+                self.token = resp.getheader("Upload-Token")
+            self.retry_after_ms = 0
+            if resp.status in (429, 503) and resp.getheader("Retry-After"):
+                self.retry_after_ms = min(
+                    int(resp.getheader("Retry-After")) * 1000,
+                    NET_BACKOFF_MAX_MS)
+            return resp.status
+        except OSError:
+            return -1
+        finally:
+            conn.close()
+
+    def wait_busy(self, busy_count):
+        self.totals.add(busy=1)
+        if self.args.ignore_busy:
+            return True
+        if busy_count > MAX_BUSY_RETRIES:
+            return False
+        delay = self.retry_after_ms or retry_delay_ms(busy_count)
+        delay += random.randint(0, delay // 4)
+        time.sleep(delay / 1000)
+        return True
+
+    def send(self, event, first, second, frame):
+        busy_count = 0
+        while True:
+            status = self.request(event, {
+                "First-Frame": "true" if first else "false",
+                "Upload-Complete": "false",
+                "Frame-Second": str(second),
+                "Frame-Number": str(frame),
+            }, self.frame)
+            if status not in (429, 503):
+                return status
+            busy_count += 1
+            if not self.wait_busy(busy_count):
+                return None
+
+    def upload(self, event):
+        """False if the event has to be tried again later."""
+        self.token = None
+        first = True
+        deferred = []
+        failures = 0
+        frames = [(s, f) for s in range(self.args.seconds)
+                  for f in range(self.args.fps)]
+
+        for second, frame in frames:
+            status = self.send(event, first, second, frame)
+            if status is None:
+                return False
+            if status == 204:
+                first = False
+                failures = 0
+                self.totals.add(bytes=len(self.frame), frames=1)
+                continue
+            self.totals.add(failed=1)
+            deferred.append([second, frame, 1])
+            failures += 1
+            if failures >= MAX_CONSECUTIVE_FAILURES:
+                return False
+
+        while deferred:
+            second, frame, attempts = deferred[0]
+            time.sleep(retry_delay_ms(attempts) / 1000)
+            status = self.send(event, first, second, frame)
+            if status is None:
+                return False
+            if status == 204:
+                first = False
+                self.totals.add(bytes=len(self.frame), frames=1)
+                deferred.pop(0)
+            else:
+                # Given up on after enough attempts, reported missing
+                self.totals.add(failed=1)
+                deferred[0][2] += 1
+                if deferred[0][2] >= MAX_FRAME_RETRIES:
+                    deferred.pop(0)
+
+        for attempt in range(1, MAX_FRAME_RETRIES + 1):
+            status = self.request(event, {"First-Frame": "false",
+                                          "Upload-Complete": "true"})
+            if status == 204:
+                return True
+            if status in (429, 503):
+                if not self.wait_busy(attempt):
+                    return False
+            else:
+                time.sleep(retry_delay_ms(attempt) / 1000)
+        return False
+
+    def run(self):
+        backoff_ms = BASE_BACKOFF_MS
+        event = 1700000000 + random.randint(0, 1000000)
+        for _ in range(self.args.events):
+            start = time.monotonic()
+            while True:
+                time.sleep(random.randint(0, UPLOAD_START_JITTER_MS) / 1000)
+                if self.upload(event):
+                    break
+                time.sleep(backoff_ms / 1000)
+                backoff_ms = min(backoff_ms * 2, NET_BACKOFF_MAX_MS)
+            backoff_ms = BASE_BACKOFF_MS
+            with self.totals.lock:
+                self.totals.events += 1
+                self.totals.event_s.append(time.monotonic() - start)
+            event += 60
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--url", default="http://localhost:8001")
+    parser.add_argument("--cameras", type=int, default=16)
+    parser.add_argument("--events", type=int, default=1,
+                        help="events sent by each camera")
+    parser.add_argument("--seconds", type=int, default=10,
+                        help="seconds in each event")
+    parser.add_argument("--fps", type=int, default=6,
+                        help="frames in each second")
+    parser.add_argument("--frame-kb", type=int, default=16)
+    parser.add_argument("--timeout-ms", type=int, default=500,
+                        help="request timeout, like \"UploadTimeoutMs\"")
+    parser.add_argument("--ignore-busy", action="store_true",
+                        help="retry turned away frames right away")
+    args = parser.parse_args()
+
+    totals = Totals()
+    cameras = [Camera(i, args, totals) for i in range(args.cameras)]
+    start = time.monotonic()
+    for camera in cameras:
+        camera.start()
+
+    last = int(start)
+    while any(camera.is_alive() for camera in cameras):
+        time.sleep(1)
+        now = int(time.monotonic())
+        with totals.lock:
+            kb = sum(totals.per_second.get(t, 0)
+                     for t in range(last, now)) / 1024
+            print(f"{now - int(start):4d}s  {kb:8.0f} KB/s  "
+                  f"{totals.events}/{args.cameras * args.events} events, "
+                  f"{totals.busy} busy, {totals.failed} failed", flush=True)
+        last = now
+
+    elapsed = time.monotonic() - start
+    # Leave out the ramp up and the tail, when few cameras are left
+    rates = sorted(totals.per_second.items())[2:-2]
+    rates = [b / 1024 for _, b in rates] or [0]
+    print()
+    print(f"{args.cameras} cameras, {totals.events} events, "
+          f"{totals.frames} frames in {elapsed:.1f} s")
+    print(f"Ingest: {totals.bytes / 1024 / elapsed:.0f} KB/s on average, "
+          f"{min(rates):.0f}-{max(rates):.0f} KB/s per second "
+          f"(median {statistics.median(rates):.0f}, stdev "
+          f"{statistics.pstdev(rates):.0f})")
+    print(f"Requests turned away: {totals.busy}, failed: {totals.failed}")
+    if totals.event_s:
+        print(f"Time to complete an event: median "
+              f"{statistics.median(totals.event_s):.1f} s, max "
+              f"{max(totals.event_s):.1f} s")
+
+
+if __name__ == "__main__":
+    main()